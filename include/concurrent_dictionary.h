@@ -0,0 +1,166 @@
+/*
+MIT License
+
+Copyright (c) 2016 Julius Paffrath
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef LIBC_CONCURRENT_DICTIONARY
+#define LIBC_CONCURRENT_DICTIONARY
+
+#include <stddef.h>
+#include <stdint.h>
+#include <pthread.h>
+
+#include "hash.h"
+#include "dictionary.h"
+
+struct concurrent_entry {
+	void* value;
+	size_t value_size;
+	char* key;
+	uint64_t hash;
+	struct concurrent_entry* next;
+};
+
+typedef struct concurrent_entry concurrent_entry;
+
+struct concurrent_shard {
+	_Alignas(64) pthread_rwlock_t lock;
+	concurrent_entry** buckets;
+	size_t bucket_count;
+	size_t entry_count;
+};
+
+typedef struct concurrent_shard concurrent_shard;
+
+struct concurrent_dictionary {
+	concurrent_shard* shards;
+	int shard_count;
+	hasher key_hasher;
+};
+
+typedef struct concurrent_dictionary concurrent_dictionary;
+
+/**
+* @brief Creates a new empty dictionary which can be shared between threads
+*
+* The dictionary is partitioned into shards selected by the hash of the key.
+* Every shard is guarded by its own reader-writer lock, so threads working
+* on different shards never contend with each other.
+*
+* @param shard_count number of shards, rounded up to the next power of two
+*
+* @return pointer to the new dictionary or NULL
+*/
+concurrent_dictionary* create_concurrent_dictionary(int shard_count);
+
+/**
+* @brief Deletes a given concurrent dictionary and all of its entries
+*
+* No other thread may access the dictionary while it is deleted.
+*
+* @param dictionary pointer to a concurrent dictionary
+*/
+void delete_concurrent_dictionary(concurrent_dictionary** dictionary);
+
+/**
+* @brief Adds a new value-key pair to a given concurrent dictionary
+*
+* If the given key already exists, the value of this entry
+* is updated with the given value.
+*
+* @param dictionary dictionary for adding the new pair to
+* @param value address of the value
+* @param value_size size of the value
+* @param key string representing the key
+*
+* @return 0 on success or -1
+*/
+int add_concurrent_entry(concurrent_dictionary* dictionary, const void* value, size_t value_size, const char* key);
+
+/**
+* @brief Removes an entry with a given key
+*
+* @param dictionary dictionary containing entries
+* @param key key of the entry
+*
+* @return 0 if the entry was removed or -1
+*/
+int remove_concurrent_entry(concurrent_dictionary* dictionary, const char* key);
+
+/**
+* @brief Copies the value of the entry with the given key
+*
+* Since other threads may update or remove the entry at any time,
+* the value is copied while the shard is locked instead of returning
+* a pointer into the dictionary.
+*
+* @param dictionary dictionary containing entries
+* @param key key of the entry
+* @param value address the value is copied to, may be NULL
+* @param value_size maximum number of bytes copied to value
+*
+* @return the size of the stored value or -1
+*/
+int get_concurrent_entry(concurrent_dictionary* dictionary, const char* key, void* value, size_t value_size);
+
+/**
+* @brief Returns the number of entries of a given concurrent dictionary
+*
+* The shards are counted one after another, so the result is only
+* exact if no other thread modifies the dictionary at the same time.
+*
+* @param dictionary dictionary containing entries
+*
+* @return the number of entries or -1
+*/
+int get_number_of_concurrent_entries(concurrent_dictionary* dictionary);
+
+/**
+* @brief Checks if a given key is part of a given concurrent dictionary
+*
+* @param dictionary dictionary containing entries
+* @param key key to search for
+*
+* @return 1 if the key exists, 0 if not or -1
+*/
+int contains_concurrent_key(concurrent_dictionary* dictionary, const char* key);
+
+/**
+* @brief Merges copies of all entries of source into destination using several threads
+*
+* Every thread merges a subset of the shards of source. If both dictionaries
+* have the same number of shards and the same hasher, every source shard is
+* merged into a single destination shard which is grown up front.
+* Both dictionaries may be used by other threads during the merge.
+* MERGE_COMBINE replaces values whose sizes differ.
+*
+* @param destination dictionary receiving the entries
+* @param source dictionary providing the entries
+* @param policy handling of keys which exist in both dictionaries
+* @param combine combine function, required for MERGE_COMBINE
+* @param threads number of threads to use
+*
+* @return 0 on success or -1, destination may be partially merged then
+*/
+int merge_concurrent_dictionaries(concurrent_dictionary* destination, concurrent_dictionary* source, merge_policy policy, merge_combine combine, int threads);
+
+#endif
@@ -0,0 +1,170 @@
+/*
+MIT License
+
+Copyright (c) 2016 Julius Paffrath
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef LIBC_COW_LIST
+#define LIBC_COW_LIST
+
+#include <stddef.h>
+#include <stdatomic.h>
+
+struct cow_node {
+	atomic_int references;
+	struct cow_node* next;
+	_Alignas(max_align_t) char value[];
+};
+
+typedef struct cow_node cow_node;
+
+struct cow_list {
+	cow_node* head;
+	int length;
+	size_t value_size;
+};
+
+typedef struct cow_list cow_list;
+
+/**
+* @brief Creates a new empty copy-on-write list
+*
+* Clones of the list share all nodes. Nodes are reference counted and a
+* node referenced by more than one predecessor or handle is never changed,
+* a write copies the nodes in front of the written position instead and
+* shares the rest. Nodes owned by a single handle are changed in place.
+* A single handle must not be used by several threads at the same time,
+* but clones may be handed to other threads.
+*
+* @param value_size size of every value
+*
+* @return pointer to the new list or NULL
+*/
+cow_list* create_cow_list(size_t value_size);
+
+/**
+* @brief Creates a new copy-on-write list from an array of values
+*
+* @param values array of values
+* @param value_size size of a value
+* @param length number of values
+*
+* @return pointer to the new list or NULL
+*/
+cow_list* create_cow_list_with_array(const void* values, size_t value_size, int length);
+
+/**
+* @brief Deletes a given handle, nodes are freed once no other clone references them
+*
+* @param list pointer to a list
+*/
+void delete_cow_list(cow_list** list);
+
+/**
+* @brief Clones a given list in constant time
+*
+* @param list list
+*
+* @return pointer to the new handle or NULL
+*/
+cow_list* clone_cow_list(const cow_list* list);
+
+/**
+* @brief Inserts a value in front of the first value, never copies any node
+*
+* @param list list
+* @param value address of the value
+*
+* @return 0 on success or -1
+*/
+int push_cow_value(cow_list* list, const void* value);
+
+/**
+* @brief Appends a value to a given list
+*
+* @param list list
+* @param value address of the value
+*
+* @return 0 on success or -1
+*/
+int add_cow_value(cow_list* list, const void* value);
+
+/**
+* @brief Inserts a value so that it ends up at a given index
+*
+* @param list list
+* @param value address of the value
+* @param index index between 0 and the length of the list
+*
+* @return 0 on success or -1
+*/
+int insert_cow_value_at_index(cow_list* list, const void* value, int index);
+
+/**
+* @brief Overwrites the value at a given index
+*
+* @param list list
+* @param value address of the value
+* @param index index
+*
+* @return 0 on success or -1
+*/
+int set_cow_value_at_index(cow_list* list, const void* value, int index);
+
+/**
+* @brief Removes the value at a given index
+*
+* @param list list
+* @param index index
+*
+* @return 0 on success or -1
+*/
+int remove_cow_value_at_index(cow_list* list, int index);
+
+/**
+* @brief Returns the value at a given index
+*
+* @param list list
+* @param index index
+*
+* @return pointer to the value or NULL, valid until the list is written or deleted
+*/
+const void* get_cow_value_at_index(const cow_list* list, int index);
+
+/**
+* @brief Returns the first node for iterating a list through the next pointers
+*
+* @param list list
+*
+* @return the first node or NULL
+*/
+const cow_node* get_first_cow_node(const cow_list* list);
+
+/**
+* @brief Returns the number of values of a given list
+*
+* @param list list
+*
+* @return the number of values or -1
+*/
+int get_length_of_cow_list(const cow_list* list);
+
+#endif
@@ -0,0 +1,74 @@
+/*
+MIT License
+
+Copyright (c) 2016 Julius Paffrath
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef LIBC_DEFERRED_DELETE
+#define LIBC_DEFERRED_DELETE
+
+#include "list.h"
+#include "dictionary.h"
+
+/**
+* @brief Hands a list to the background reclaimer and sets the pointer to NULL
+*
+* Only the list head is touched on the calling thread, the elements are freed
+* later by a reclaimer thread in batches of DEFERRED_BATCH_SIZE nodes. The list
+* must not be used by anyone after this call. When the reclaimer cannot be
+* started the list is deleted right away.
+*
+* @param list pointer to a list
+*/
+void delete_list_deferred(element** list);
+
+/**
+* @brief Like delete_list_deferred for lists created with create_list_alloc
+*
+* The callback runs on the reclaimer thread.
+*
+* @param list pointer to a list
+* @param free_callback function releasing the pointers of a value
+*/
+void delete_list_alloc_deferred(element** list, void (*free_callback)(const void* value));
+
+/**
+* @brief Hands a dictionary to the background reclaimer and sets the pointer to NULL
+*
+* @param dictionary pointer to a dictionary
+*/
+void delete_dictionary_deferred(entry** dictionary);
+
+/**
+* @brief Waits until every container handed to the reclaimer so far is freed
+*
+* Meant for orderly shutdown and for callers which need the memory back now.
+*/
+void flush_deferred_deletes(void);
+
+/**
+* @brief Returns the number of containers waiting for the reclaimer
+*
+* @return the number of pending deletes
+*/
+int get_number_of_deferred_deletes(void);
+
+#endif
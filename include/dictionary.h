@@ -100,6 +100,40 @@ entry* remove_entry(entry* dictionary, const char* key);
 */
 entry* get_entry(entry* dictionary, const char* key);
 
+/**
+* @brief Returns the entries for a batch of keys
+*
+* All keys are hashed up front and then resolved together in a single
+* walk over the dictionary, which prefetches the following entries while
+* the current one is compared. This is much faster than calling get_entry
+* for every key.
+*
+* @param dictionary dictionary containing entries
+* @param keys array of keys
+* @param count number of keys
+* @param entries array receiving the entry for every key or NULL if the key does not exist
+*
+* @return the number of keys found or -1
+*/
+int get_entries_batch(entry* dictionary, const char** keys, int count, entry** entries);
+
+/**
+* @brief Adds a batch of value-key pairs to a given dictionary
+*
+* Existing keys are updated, new keys are appended in the order of the keys array.
+* Like get_entries_batch, all keys are resolved in a single walk over the dictionary.
+*
+* @param dictionary dictionary for adding the new pairs to
+* @param values array of value addresses
+* @param value_size size of the values
+* @param keys array of keys
+* @param count number of value-key pairs
+* @param entries array receiving the entry for every key, may be NULL
+*
+* @return the number of pairs added or updated or -1
+*/
+int add_entries_batch(entry* dictionary, const void** values, size_t value_size, const char** keys, int count, entry** entries);
+
 /**
 * @brief Returns the number of entries of a given dictionary
 *
@@ -128,6 +162,102 @@ int contains_key(entry* dictionary, const char* key);
 */
 element* get_keys(entry* dictionary);
 
+/**
+* @brief Fills a caller provided array with pointers to the keys of a given dictionary
+*
+* The keys are not copied, the pointers stay valid until the entries are removed
+* or updated. Like snprintf, the function returns the number of entries even if
+* the array is too small, so a buffer can be reused and only grown when needed.
+*
+* @param dictionary dictionary containing entries
+* @param keys array receiving the key pointers, may be NULL if capacity is 0
+* @param capacity number of pointers which fit into keys
+*
+* @return the number of entries or -1
+*/
+int get_key_view(entry* dictionary, const char** keys, int capacity);
+
+/**
+* @brief Fills a caller provided array with pointers to the entries of a given dictionary
+*
+* Works like get_key_view, but gives access to the keys and the values.
+*
+* @param dictionary dictionary containing entries
+* @param entries array receiving the entry pointers, may be NULL if capacity is 0
+* @param capacity number of pointers which fit into entries
+*
+* @return the number of entries or -1
+*/
+int get_entry_view(entry* dictionary, entry** entries, int capacity);
+
+/**
+* @brief Creates a dictionary from a text file with one key-value pair per line
+*
+* Every line is split at the first separator into key and value, the value is
+* stored as a string. Lines without separator are skipped and later lines
+* update the value of an earlier key. The file is read in large chunks and
+* new keys are resolved through a temporary hash index, so loading is linear
+* in the size of the file.
+*
+* @param path path of the file
+* @param separator character between key and value
+*
+* @return pointer to the new dictionary or NULL if the file has no pairs or an error occurs
+*/
+entry* load_dictionary_delimited(const char* path, char separator);
+
+/**
+* @brief Policies for keys which exist in both dictionaries of a merge
+*/
+typedef enum {
+	MERGE_KEEP_DESTINATION,
+	MERGE_OVERWRITE,
+	MERGE_COMBINE
+} merge_policy;
+
+/**
+* @brief Combines the value of a source entry into the value of a destination entry
+*/
+typedef void (*merge_combine)(void* destination, const void* source, size_t value_size);
+
+/**
+* @brief Merges copies of all entries of source into destination
+*
+* Keys of destination are indexed once up front, so merging is linear in the
+* size of both dictionaries. New keys are appended in the order of source.
+*
+* @param destination dictionary receiving the entries
+* @param source dictionary providing the entries
+* @param value_size size of the values
+* @param policy handling of keys which exist in both dictionaries
+* @param combine combine function, required for MERGE_COMBINE
+*
+* @return pointer to destination or NULL if an error occurs, destination may be partially merged then
+*/
+entry* merge_dictionaries(entry* destination, entry* source, size_t value_size, merge_policy policy, merge_combine combine);
+
+/**
+* @brief Creates a new dictionary with copies of the entries of first whose keys are part of second
+*
+* @param first dictionary providing the entries
+* @param second dictionary providing the keys
+* @param value_size size of the values of first
+*
+* @return pointer to the new dictionary or NULL if no key is shared or an error occurs
+*/
+entry* intersect_dictionaries(entry* first, entry* second, size_t value_size);
+
+/**
+* @brief Creates a new dictionary with copies of the entries of first whose keys are not part of second
+*
+* @param first dictionary providing the entries
+* @param second dictionary providing the keys
+* @param value_size size of the values of first
+*
+* @return pointer to the new dictionary or NULL if every key is shared or an error occurs
+*/
+entry* difference_dictionaries(entry* first, entry* second, size_t value_size);
+
 /**
 * @brief Prints a representation of a given dictionary
 *
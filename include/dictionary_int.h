@@ -0,0 +1,159 @@
+/*
+MIT License
+
+Copyright (c) 2016 Julius Paffrath
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef LIBC_DICTIONARY_INT
+#define LIBC_DICTIONARY_INT
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "hash.h"
+
+struct int_entry {
+	struct int_entry* next;
+	uint64_t hash;
+	int value;
+	char key[];
+};
+
+typedef struct int_entry int_entry;
+
+struct int_dictionary {
+	int_entry** buckets;
+	size_t bucket_count;
+	int entry_count;
+	hasher key_hasher;
+};
+
+typedef struct int_dictionary int_dictionary;
+
+/**
+* @brief Creates a new empty dictionary holding int values
+*
+* Values are stored inside the entries, so updating a value
+* never allocates or frees memory.
+*
+* @return pointer to the new dictionary or NULL
+*/
+int_dictionary* create_int_dictionary(void);
+
+/**
+* @brief Deletes a given int dictionary and all of its entries
+*
+* @param dictionary pointer to a int dictionary
+*/
+void delete_int_dictionary(int_dictionary** dictionary);
+
+/**
+* @brief Sets the int value of a key
+*
+* If the given key does not exist, a new entry is created.
+*
+* @param dictionary dictionary for adding the value to
+* @param value int value
+* @param key string representing the key
+*
+* @return pointer to the entry or NULL
+*/
+int_entry* add_int_entry(int_dictionary* dictionary, int value, const char* key);
+
+/**
+* @brief Adds a given delta to the int value of a key in place
+*
+* If the given key does not exist, a new entry holding delta is created.
+*
+* @param dictionary dictionary containing entries
+* @param delta int value to add
+* @param key string representing the key
+*
+* @return pointer to the entry or NULL
+*/
+int_entry* add_to_int_entry(int_dictionary* dictionary, int delta, const char* key);
+
+/**
+* @brief Increments the int value of a key by one
+*
+* If the given key does not exist, a new entry holding one is created.
+*
+* @param dictionary dictionary containing entries
+* @param key string representing the key
+*
+* @return pointer to the entry or NULL
+*/
+int_entry* increment_int_entry(int_dictionary* dictionary, const char* key);
+
+/**
+* @brief Atomically adds a given delta to the value of an entry
+*
+* Entries never move while they are part of a dictionary, so an entry
+* can be resolved once and then be updated by many threads concurrently.
+* The dictionary itself must not be modified at the same time.
+*
+* @param e entry returned by one of the int dictionary functions
+* @param delta int value to add
+*
+* @return the new value of the entry
+*/
+int atomic_add_to_int_entry(int_entry* e, int delta);
+
+/**
+* @brief Removes an entry with a given key
+*
+* @param dictionary dictionary containing entries
+* @param key key of the entry
+*
+* @return pointer to the dictionary or NULL
+*/
+int_dictionary* remove_int_entry(int_dictionary* dictionary, const char* key);
+
+/**
+* @brief Returns the entry with the given key
+*
+* @param dictionary dictionary containing entries
+* @param key key of the entry
+*
+* @return pointer to the entry with the given key or NULL
+*/
+int_entry* get_int_entry(int_dictionary* dictionary, const char* key);
+
+/**
+* @brief Returns the number of entries of a given int dictionary
+*
+* @param dictionary dictionary containing entries
+*
+* @return the number of entries or -1
+*/
+int get_number_of_int_entries(int_dictionary* dictionary);
+
+/**
+* @brief Checks if a given key is part of a given int dictionary
+*
+* @param dictionary dictionary containing entries
+* @param key key to search for
+*
+* @return 1 if the key exists, 0 if not or -1
+*/
+int contains_int_key(int_dictionary* dictionary, const char* key);
+
+#endif
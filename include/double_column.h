@@ -0,0 +1,209 @@
+/*
+MIT License
+
+Copyright (c) 2016 Julius Paffrath
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef LIBC_DOUBLE_COLUMN
+#define LIBC_DOUBLE_COLUMN
+
+#include "list.h"
+
+// values per chunk, a chunk is 32 KiB and aligned to a cache line
+#define DOUBLE_COLUMN_CHUNK_SIZE 4096
+#define DOUBLE_COLUMN_ALIGNMENT 64
+
+struct double_column {
+	double** chunks;
+	int chunk_count;
+	int chunk_capacity;
+	int length;
+};
+
+typedef struct double_column double_column;
+
+/**
+* @brief Creates a new empty column of double values
+*
+* The values are stored in aligned chunks of DOUBLE_COLUMN_CHUNK_SIZE values.
+* Appending never moves stored values and the aggregates run the vectorized
+* kernels of simd.h over whole chunks.
+*
+* @return pointer to the new column or NULL
+*/
+double_column* create_double_column(void);
+
+/**
+* @brief Creates a new column holding the values of a list of doubles in list order
+*
+* @param list list containing doubles, elements without value are skipped
+*
+* @return pointer to the new column or NULL
+*/
+double_column* create_double_column_from_list(element* list);
+
+/**
+* @brief Deletes a given column
+*
+* @param column pointer to a column
+*/
+void delete_double_column(double_column** column);
+
+/**
+* @brief Creates a new list of doubles holding the values of a column
+*
+* @param column column
+*
+* @return the new list or NULL if the column is empty
+*/
+element* double_column_to_list(const double_column* column);
+
+/**
+* @brief Appends a value to a column
+*
+* @param column column
+* @param value value
+*
+* @return 0 on success or -1
+*/
+int add_double_value(double_column* column, double value);
+
+/**
+* @brief Appends an array of values to a column
+*
+* @param column column
+* @param values array of values
+* @param count number of values
+*
+* @return 0 on success or -1, the values appended before a failure stay
+*/
+int add_double_values(double_column* column, const double* values, int count);
+
+/**
+* @brief Reads the value at a given index
+*
+* @param column column
+* @param index index
+* @param value receives the value
+*
+* @return 0 on success or -1
+*/
+int get_double_value_at_index(const double_column* column, int index, double* value);
+
+/**
+* @brief Overwrites the value at a given index
+*
+* @param column column
+* @param value value
+* @param index index
+*
+* @return 0 on success or -1
+*/
+int set_double_value_at_index(double_column* column, double value, int index);
+
+/**
+* @brief Returns the number of values of a column
+*
+* @param column column
+*
+* @return the number of values or -1
+*/
+int get_length_of_double_column(const double_column* column);
+
+/**
+* @brief Computes the sum of all values of a column
+*
+* @param column column
+*
+* @return the sum, 0 for an empty column
+*/
+double get_sum_of_double_column(const double_column* column);
+
+/**
+* @brief Computes the mean of all values of a column
+*
+* @param column column
+* @param result receives the mean
+*
+* @return 0 on success or -1 for an empty column
+*/
+int get_mean_of_double_column(const double_column* column, double* result);
+
+/**
+* @brief Computes the population variance of all values of a column
+*
+* The squared differences to the mean are summed in a second pass,
+* which avoids the cancellation of the single pass formula.
+*
+* @param column column
+* @param result receives the variance
+*
+* @return 0 on success or -1 for an empty column
+*/
+int get_variance_of_double_column(const double_column* column, double* result);
+
+/**
+* @brief Computes the smallest value of a column
+*
+* @param column column
+* @param result receives the smallest value
+*
+* @return 0 on success or -1 for an empty column
+*/
+int get_min_of_double_column(const double_column* column, double* result);
+
+/**
+* @brief Computes the largest value of a column
+*
+* @param column column
+* @param result receives the largest value
+*
+* @return 0 on success or -1 for an empty column
+*/
+int get_max_of_double_column(const double_column* column, double* result);
+
+/**
+* @brief Computes the dot product of two columns of the same length
+*
+* @param first first column
+* @param second second column
+* @param result receives the dot product
+*
+* @return 0 on success or -1
+*/
+int get_dot_product_of_double_columns(const double_column* first, const double_column* second, double* result);
+
+/**
+* @brief Counts the values of a column in equally wide bins between low and high
+*
+* See add_double_array_to_histogram for the bin boundaries.
+*
+* @param column column
+* @param low lower bound of the first bin
+* @param high upper bound of the last bin
+* @param bins number of bins
+* @param counts array of bins counters, overwritten with the counts
+*
+* @return 0 on success or -1
+*/
+int get_histogram_of_double_column(const double_column* column, double low, double high, int bins, int* counts);
+
+#endif
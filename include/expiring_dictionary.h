@@ -0,0 +1,168 @@
+/*
+MIT License
+
+Copyright (c) 2016 Julius Paffrath
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef LIBC_EXPIRING_DICTIONARY
+#define LIBC_EXPIRING_DICTIONARY
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "hash.h"
+
+#define EXPIRING_WHEEL_LEVELS 4
+#define EXPIRING_WHEEL_SLOTS 64
+
+struct expiring_entry {
+	void* value;
+	size_t value_size;
+	char* key;
+	uint64_t hash;
+	uint64_t deadline;
+	struct expiring_entry* chain;
+	struct expiring_entry* prev;
+	struct expiring_entry* next;
+	unsigned char level;
+	unsigned char slot;
+};
+
+typedef struct expiring_entry expiring_entry;
+
+/**
+* @brief Returns the current time in milliseconds
+*/
+typedef uint64_t (*expiring_clock)(void* user_data);
+
+struct expiring_dictionary {
+	expiring_entry** buckets;
+	size_t bucket_count;
+	int entry_count;
+	expiring_clock clock;
+	void* user_data;
+	hasher key_hasher;
+	uint64_t wheel_time;
+	uint64_t occupied[EXPIRING_WHEEL_LEVELS];
+	expiring_entry* wheel[EXPIRING_WHEEL_LEVELS][EXPIRING_WHEEL_SLOTS];
+};
+
+typedef struct expiring_dictionary expiring_dictionary;
+
+/**
+* @brief Creates a new empty expiring dictionary
+*
+* Every entry carries a deadline. Expired entries are never returned and are
+* reaped incrementally through a hierarchical timer wheel with millisecond ticks.
+*
+* @param clock clock in milliseconds or NULL for the monotonic system clock
+* @param user_data pointer passed to the clock
+*
+* @return pointer to the new dictionary or NULL
+*/
+expiring_dictionary* create_expiring_dictionary(expiring_clock clock, void* user_data);
+
+/**
+* @brief Deletes a given expiring dictionary and all of its entries
+*
+* @param dictionary pointer to an expiring dictionary
+*/
+void delete_expiring_dictionary(expiring_dictionary** dictionary);
+
+/**
+* @brief Adds a copy of a value which expires after a given time to live
+*
+* If the given key already exists, its value and deadline are replaced.
+*
+* @param dictionary dictionary for adding the value to
+* @param value value of the new entry
+* @param value_size size of the new value
+* @param key string representing the key
+* @param ttl time to live in milliseconds
+*
+* @return pointer to the entry or NULL
+*/
+expiring_entry* add_expiring_entry(expiring_dictionary* dictionary, const void* value, size_t value_size, const char* key, uint64_t ttl);
+
+/**
+* @brief Sets a new time to live for an existing entry
+*
+* @param dictionary dictionary containing entries
+* @param key key of the entry
+* @param ttl time to live in milliseconds
+*
+* @return pointer to the entry or NULL if the key does not exist or has expired
+*/
+expiring_entry* refresh_expiring_entry(expiring_dictionary* dictionary, const char* key, uint64_t ttl);
+
+/**
+* @brief Returns the entry with the given key if it has not expired
+*
+* @param dictionary dictionary containing entries
+* @param key key of the entry
+*
+* @return pointer to the entry with the given key or NULL
+*/
+expiring_entry* get_expiring_entry(expiring_dictionary* dictionary, const char* key);
+
+/**
+* @brief Removes an entry with a given key
+*
+* @param dictionary dictionary containing entries
+* @param key key of the entry
+*
+* @return pointer to the dictionary or NULL
+*/
+expiring_dictionary* remove_expiring_entry(expiring_dictionary* dictionary, const char* key);
+
+/**
+* @brief Reaps expired entries
+*
+* Adding entries already reaps a few expired entries, so calling this
+* function is only needed to release memory at a specific point in time.
+*
+* @param dictionary dictionary containing entries
+* @param max_entries maximum number of entries to reap or 0 for all
+*
+* @return the number of reaped entries or -1
+*/
+int expire_entries(expiring_dictionary* dictionary, int max_entries);
+
+/**
+* @brief Returns the number of entries which have not expired
+*
+* @param dictionary dictionary containing entries
+*
+* @return the number of entries or -1
+*/
+int get_number_of_expiring_entries(expiring_dictionary* dictionary);
+
+/**
+* @brief Checks if a given key is part of a given dictionary and has not expired
+*
+* @param dictionary dictionary containing entries
+* @param key key to search for
+*
+* @return 1 if the key exists, 0 if not or -1
+*/
+int contains_expiring_key(expiring_dictionary* dictionary, const char* key);
+
+#endif
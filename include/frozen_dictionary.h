@@ -0,0 +1,119 @@
+/*
+MIT License
+
+Copyright (c) 2016 Julius Paffrath
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef LIBC_FROZEN_DICTIONARY
+#define LIBC_FROZEN_DICTIONARY
+
+#include "dictionary.h"
+#include <stddef.h>
+#include <stdint.h>
+
+struct frozen_dictionary {
+	uint64_t entry_count;
+	uint64_t bucket_count;
+	uint64_t value_size;
+	uint64_t seed;
+	uint64_t memory_size;
+	uint32_t* displacements;
+	uint32_t* key_offsets;
+	char* values;
+	char* keys;
+	void* memory;
+};
+
+typedef struct frozen_dictionary frozen_dictionary;
+
+/**
+* @brief Creates an immutable copy of a given dictionary optimized for lookups
+*
+* The keys are placed with a minimal perfect hash function, so every lookup
+* costs one hash, one probe and one key comparison. Keys and values are
+* packed into a single allocation instead of one allocation per entry.
+*
+* @param dictionary the dictionary to be frozen
+* @param value_size size of the entries values
+*
+* @return pointer to the new frozen dictionary or NULL
+*/
+frozen_dictionary* freeze_dictionary(entry* dictionary, size_t value_size);
+
+/**
+* @brief Deletes a given frozen dictionary
+*
+* @param dictionary pointer to a frozen dictionary
+*/
+void delete_frozen_dictionary(frozen_dictionary** dictionary);
+
+/**
+* @brief Returns the value of the entry with the given key
+*
+* @param dictionary frozen dictionary containing entries
+* @param key key of the entry
+*
+* @return pointer to the value of the entry with the given key or NULL
+*/
+const void* get_frozen_entry(frozen_dictionary* dictionary, const char* key);
+
+/**
+* @brief Returns the number of entries of a given frozen dictionary
+*
+* @param dictionary frozen dictionary containing entries
+*
+* @return the number of entries or -1
+*/
+int get_number_of_frozen_entries(frozen_dictionary* dictionary);
+
+/**
+* @brief Checks if a given key is part of a given frozen dictionary
+*
+* @param dictionary frozen dictionary containing entries
+* @param key key to search for
+*
+* @return 1 if the key exists, 0 if not or -1
+*/
+int contains_frozen_key(frozen_dictionary* dictionary, const char* key);
+
+/**
+* @brief Writes a given frozen dictionary to a file
+*
+* The file stores the memory image of the dictionary in native byte order,
+* so it can only be loaded on machines with the same endianness.
+*
+* @param dictionary frozen dictionary to be saved
+* @param path path of the file
+*
+* @return 0 on success or -1
+*/
+int save_frozen_dictionary(frozen_dictionary* dictionary, const char* path);
+
+/**
+* @brief Loads a frozen dictionary written by save_frozen_dictionary
+*
+* @param path path of the file
+*
+* @return pointer to the loaded frozen dictionary or NULL
+*/
+frozen_dictionary* load_frozen_dictionary(const char* path);
+
+#endif
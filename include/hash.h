@@ -0,0 +1,115 @@
+/*
+MIT License
+
+Copyright (c) 2016 Julius Paffrath
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef LIBC_HASH
+#define LIBC_HASH
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+* @brief Signature of a seeded 64 bit hash function
+*/
+typedef uint64_t (*hash_function)(const char* key, size_t length, uint64_t seed);
+
+struct hasher {
+	hash_function function;
+	uint64_t seed;
+};
+
+typedef struct hasher hasher;
+
+/**
+* @brief FNV-1a, simple and portable but slow for long keys
+*/
+uint64_t hash_fnv1a(const char* key, size_t length, uint64_t seed);
+
+/**
+* @brief wyhash, a fast multiply-mix hash with good distribution and the default
+*/
+uint64_t hash_wyhash(const char* key, size_t length, uint64_t seed);
+
+/**
+* @brief CRC32C mixed to 64 bits
+*
+* Uses the SSE4.2 crc32 instruction if the processor supports it
+* and a portable table based implementation otherwise.
+*/
+uint64_t hash_crc32c(const char* key, size_t length, uint64_t seed);
+
+/**
+* @brief SipHash-2-4 keyed by the seed
+*
+* Use it with a secret seed for keys controlled by untrusted input.
+*/
+uint64_t hash_siphash(const char* key, size_t length, uint64_t seed);
+
+/**
+* @brief Returns a random seed from the operating system
+*
+* @return a seed for hash_siphash or any other seeded hash function
+*/
+uint64_t create_hash_seed(void);
+
+/**
+* @brief Sets the hash function used by containers created afterwards
+*
+* Every hash based container captures the default hasher when it is created,
+* so changing it does not affect existing containers.
+*
+* @param function hash function or NULL for the built-in default
+* @param seed seed passed to the hash function
+*/
+void set_default_hasher(hash_function function, uint64_t seed);
+
+/**
+* @brief Returns the current default hasher
+*/
+hasher get_default_hasher(void);
+
+/**
+* @brief Computes a 64 bit hash of a given key with a given hasher
+*
+* @param h hasher to use
+* @param key address of the key
+* @param length length of the key in bytes
+*
+* @return the hash of the key
+*/
+uint64_t hash_key_with(const hasher* h, const char* key, size_t length);
+
+/**
+* @brief Computes a 64 bit hash of a given key with the default hasher
+*
+* The hash is used by the hash based containers of libclist
+* to select shards and buckets.
+*
+* @param key address of the key
+* @param length length of the key in bytes
+*
+* @return the hash of the key
+*/
+uint64_t hash_key(const char* key, size_t length);
+
+#endif
@@ -30,5 +30,26 @@ SOFTWARE.
 #include "list_char.h"
 #include "list_double.h"
 #include "dictionary.h"
+#include "dictionary_int.h"
+#include "dictionary_double.h"
+#include "hash.h"
+#include "concurrent_dictionary.h"
+#include "rcu_dictionary.h"
+#include "radix_tree.h"
+#include "ordered_dictionary.h"
+#include "frozen_dictionary.h"
+#include "lru_cache.h"
+#include "expiring_dictionary.h"
+#include "persistent_dictionary.h"
+#include "multimap.h"
+#include "queue.h"
+#include "work_deque.h"
+#include "thread_pool.h"
+#include "list_parallel.h"
+#include "deferred_delete.h"
+#include "cow_list.h"
+#include "list_skip_index.h"
+#include "simd.h"
+#include "double_column.h"
 
 #endif
\ No newline at end of file
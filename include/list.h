@@ -119,6 +119,37 @@ void delete_list_alloc(element** list, void (*free_callback)(const void* value))
 */
 element* clone_list(element* list, size_t value_size);
 
+/**
+* @brief Moves all elements and values of a list into one contiguous block in list order
+*
+* Traversing a list whose elements were added and removed a lot touches memory
+* all over the heap, a compacted list is read sequentially again. Pointers to
+* elements and values taken before are invalid afterwards. Elements of a
+* compacted list must only be released by the functions of this library.
+*
+* @param list pointer to a list, updated to the relocated first element
+* @param value_size size of the elements values
+*
+* @return 0 on success or -1, the list stays intact on failure
+*/
+int compact_list(element** list, size_t value_size);
+
+/**
+* @brief Compacts a list step by step, up to count elements per call
+*
+* Start with the address of the list pointer and pass the link stored in next
+* to the following call, each call moves the next count elements into one
+* block. Blocks of consecutive calls are placed behind each other if possible.
+*
+* @param link address of the pointer to the first element to move
+* @param value_size size of the elements values
+* @param count maximum number of elements to move
+* @param next receives the link to continue with or NULL when the list is done
+*
+* @return 0 on success or -1, the list stays intact on failure and can be continued at link
+*/
+int compact_list_incremental(element** link, size_t value_size, int count, element*** next);
+
 /**
 * @brief Adds a new element to a given list
 *
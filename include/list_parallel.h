@@ -0,0 +1,91 @@
+/*
+MIT License
+
+Copyright (c) 2016 Julius Paffrath
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef LIBC_LIST_PARALLEL
+#define LIBC_LIST_PARALLEL
+
+#include <stddef.h>
+
+#include "list.h"
+
+/**
+* @brief Calls a function for every value of a list, spread over the default thread pool
+*
+* The list is split into balanced segments in a single walk, elements of the
+* same segment are visited in order. Elements without value are skipped.
+*
+* @param list list
+* @param function function called with a value and the context
+* @param context passed to every call
+*
+* @return 0 on success or -1
+*/
+int for_each_element_parallel(element* list, void (*function)(void* value, void* context), void* context);
+
+/**
+* @brief Creates a new list by mapping every value of a list in parallel
+*
+* @param list list
+* @param result_size size of a mapped value
+* @param function function writing the mapped value of value to result
+* @param context passed to every call
+*
+* @return the new list in the order of the given list or NULL
+*/
+element* map_list_parallel(element* list, size_t result_size, void (*function)(const void* value, void* result, void* context), void* context);
+
+/**
+* @brief Creates a new list of all values for which a predicate holds, evaluated in parallel
+*
+* @param list list
+* @param value_size size of a value
+* @param predicate function returning non zero for values to keep
+* @param context passed to every call
+*
+* @return the new list in the order of the given list or NULL if no value matches
+*/
+element* filter_list_parallel(element* list, size_t value_size, int (*predicate)(const void* value, void* context), void* context);
+
+/**
+* @brief Reduces all values of a list in parallel
+*
+* Every segment starts from a copy of identity and accumulates its values,
+* the partial results are merged in list order afterwards. merge must be
+* associative, accumulate does not need to be commutative.
+*
+* @param list list
+* @param result buffer of result_size bytes receiving the reduced value
+* @param result_size size of the result
+* @param identity initial value of every partial result
+* @param accumulate function folding a value into a partial result
+* @param merge function folding the partial result source into destination
+* @param context passed to every call
+*
+* @return 0 on success or -1
+*/
+int reduce_list_parallel(element* list, void* result, size_t result_size, const void* identity,
+	void (*accumulate)(void* result, const void* value, void* context),
+	void (*merge)(void* destination, const void* source, void* context), void* context);
+
+#endif
@@ -0,0 +1,115 @@
+/*
+MIT License
+
+Copyright (c) 2016 Julius Paffrath
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef LIBC_LIST_SKIP_INDEX
+#define LIBC_LIST_SKIP_INDEX
+
+#include <stddef.h>
+
+#include "list.h"
+
+#define SKIP_INDEX_DEFAULT_STRIDE 64
+
+struct list_skip_index {
+	element** points;
+	int count;
+	int stride;
+	int length;
+};
+
+typedef struct list_skip_index list_skip_index;
+
+/**
+* @brief Creates an index of skip pointers to every stride-th element of a list
+*
+* Walking a list is a chain of dependent loads, only one cache miss is in
+* flight at a time. With skip pointers the searches below walk several
+* segments of the list side by side, so their cache misses overlap. The index
+* describes the list at the time of its creation, it has to be created again
+* after elements were added or removed.
+*
+* @param list list
+* @param stride distance between two skip pointers, SKIP_INDEX_DEFAULT_STRIDE if not positive
+*
+* @return pointer to the new index or NULL
+*/
+list_skip_index* create_list_skip_index(element* list, int stride);
+
+/**
+* @brief Deletes a given index, the list is not touched
+*
+* @param index pointer to an index
+*/
+void delete_list_skip_index(list_skip_index** index);
+
+/**
+* @brief Returns the element at a given index walking at most stride elements
+*
+* @param index skip index of the list
+* @param position index of the element
+*
+* @return the element or NULL
+*/
+element* get_element_with_skip_index(const list_skip_index* index, int position);
+
+/**
+* @brief Returns the last element of the indexed list
+*
+* @param index skip index of the list
+*
+* @return the last element or NULL
+*/
+element* get_last_element_with_skip_index(const list_skip_index* index);
+
+/**
+* @brief Returns the length of the indexed list
+*
+* @param index skip index of the list
+*
+* @return the length or -1
+*/
+int get_length_with_skip_index(const list_skip_index* index);
+
+/**
+* @brief Like contains_value, walking several segments of the list at once
+*
+* @param index skip index of the list
+* @param value address of the value
+* @param size size of the value
+*
+* @return the index of the first element containing the value or -1
+*/
+int find_value_with_skip_index(const list_skip_index* index, const void* value, size_t size);
+
+/**
+* @brief Like contains_element, walking several segments of the list at once
+*
+* @param index skip index of the list
+* @param e element to search for
+*
+* @return the index of the element or -1
+*/
+int find_element_with_skip_index(const list_skip_index* index, const element* e);
+
+#endif
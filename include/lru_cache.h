@@ -0,0 +1,188 @@
+/*
+MIT License
+
+Copyright (c) 2016 Julius Paffrath
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef LIBC_LRU_CACHE
+#define LIBC_LRU_CACHE
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "hash.h"
+
+struct lru_entry {
+	void* value;
+	size_t value_size;
+	char* key;
+	uint64_t hash;
+	struct lru_entry* chain;
+	struct lru_entry* prev;
+	struct lru_entry* next;
+};
+
+typedef struct lru_entry lru_entry;
+
+/**
+* @brief Called for every entry that is evicted because a limit was exceeded
+*
+* The value is freed by the cache after the callback returns.
+*/
+typedef void (*lru_evict_callback)(const char* key, void* value, size_t value_size, void* user_data);
+
+struct lru_stats {
+	uint64_t hits;
+	uint64_t misses;
+	uint64_t evictions;
+};
+
+typedef struct lru_stats lru_stats;
+
+struct lru_cache {
+	lru_entry** buckets;
+	size_t bucket_count;
+	lru_entry* head;
+	lru_entry* tail;
+	int entry_count;
+	int max_entries;
+	size_t max_bytes;
+	size_t used_bytes;
+	lru_evict_callback on_evict;
+	void* user_data;
+	lru_stats stats;
+	hasher key_hasher;
+};
+
+typedef struct lru_cache lru_cache;
+
+/**
+* @brief Creates a new empty LRU cache
+*
+* The size of an entry is the size of its value plus the size of its key.
+* A limit of 0 disables the corresponding bound.
+*
+* @param max_entries maximum number of entries
+* @param max_bytes maximum number of bytes of all entries
+* @param on_evict callback for evicted entries or NULL
+* @param user_data pointer passed to the callback
+*
+* @return pointer to the new cache or NULL
+*/
+lru_cache* create_lru_cache(int max_entries, size_t max_bytes, lru_evict_callback on_evict, void* user_data);
+
+/**
+* @brief Deletes a given cache and all of its entries
+*
+* The eviction callback is not called for the remaining entries.
+*
+* @param cache pointer to a cache
+*/
+void delete_lru_cache(lru_cache** cache);
+
+/**
+* @brief Adds a copy of a value to a cache and marks it as most recently used
+*
+* If the given key already exists, its value is replaced.
+* Least recently used entries are evicted until the limits are met.
+*
+* @param cache cache for adding the value to
+* @param value value of the new entry
+* @param value_size size of the new value
+* @param key string representing the key
+*
+* @return pointer to the entry or NULL if the entry alone exceeds max_bytes
+*/
+lru_entry* put_lru_entry(lru_cache* cache, const void* value, size_t value_size, const char* key);
+
+/**
+* @brief Returns the entry with the given key and marks it as most recently used
+*
+* Counts a hit or a miss.
+*
+* @param cache cache containing entries
+* @param key key of the entry
+*
+* @return pointer to the entry with the given key or NULL
+*/
+lru_entry* get_lru_entry(lru_cache* cache, const char* key);
+
+/**
+* @brief Returns the entry with the given key without touching recency or statistics
+*
+* @param cache cache containing entries
+* @param key key of the entry
+*
+* @return pointer to the entry with the given key or NULL
+*/
+lru_entry* peek_lru_entry(lru_cache* cache, const char* key);
+
+/**
+* @brief Removes an entry with a given key without calling the eviction callback
+*
+* @param cache cache containing entries
+* @param key key of the entry
+*
+* @return pointer to the cache or NULL
+*/
+lru_cache* remove_lru_entry(lru_cache* cache, const char* key);
+
+/**
+* @brief Returns the number of entries of a given cache
+*
+* @param cache cache containing entries
+*
+* @return the number of entries or -1
+*/
+int get_number_of_lru_entries(lru_cache* cache);
+
+/**
+* @brief Returns the number of bytes used by the entries of a given cache
+*
+* @param cache cache containing entries
+*
+* @return the number of bytes or 0
+*/
+size_t get_lru_cache_size(lru_cache* cache);
+
+/**
+* @brief Checks if a given key is part of a given cache
+*
+* Neither recency nor statistics are changed.
+*
+* @param cache cache containing entries
+* @param key key to search for
+*
+* @return 1 if the key exists, 0 if not or -1
+*/
+int contains_lru_key(lru_cache* cache, const char* key);
+
+/**
+* @brief Copies the hit, miss and eviction counters of a given cache
+*
+* @param cache cache containing entries
+* @param stats destination for the counters
+*
+* @return 0 on success or -1
+*/
+int get_lru_stats(lru_cache* cache, lru_stats* stats);
+
+#endif
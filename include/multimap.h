@@ -0,0 +1,152 @@
+/*
+MIT License
+
+Copyright (c) 2016 Julius Paffrath
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef LIBC_MULTIMAP
+#define LIBC_MULTIMAP
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "hash.h"
+
+struct multimap_entry {
+	struct multimap_entry* next;
+	uint64_t hash;
+	void* values;
+	int value_count;
+	int capacity;
+	char key[];
+};
+
+typedef struct multimap_entry multimap_entry;
+
+struct multimap {
+	multimap_entry** buckets;
+	size_t bucket_count;
+	size_t value_size;
+	int key_count;
+	int value_count;
+	hasher key_hasher;
+};
+
+typedef struct multimap multimap;
+
+/**
+* @brief Creates a new empty multimap
+*
+* Every key holds any number of values of the same size,
+* which are stored contiguously in insertion order.
+*
+* @param value_size size of every value
+*
+* @return pointer to the new multimap or NULL
+*/
+multimap* create_multimap(size_t value_size);
+
+/**
+* @brief Deletes a given multimap with all keys and values
+*
+* @param map pointer to a multimap
+*/
+void delete_multimap(multimap** map);
+
+/**
+* @brief Appends a copy of a value to the values of a key in amortized O(1)
+*
+* If the given key does not exist, it is created.
+*
+* @param map multimap for adding the value to
+* @param value value to append
+* @param key string representing the key
+*
+* @return pointer to the entry of the key or NULL
+*/
+multimap_entry* add_multimap_value(multimap* map, const void* value, const char* key);
+
+/**
+* @brief Returns the values of a given key
+*
+* The returned array is valid until the values of the key are changed.
+*
+* @param map multimap containing entries
+* @param key key of the values
+* @param count destination for the number of values or NULL
+*
+* @return pointer to the first value or NULL if the key does not exist
+*/
+const void* get_multimap_values(multimap* map, const char* key, int* count);
+
+/**
+* @brief Removes the first occurrence of a value from the values of a key
+*
+* The order of the remaining values is preserved.
+* A key without values is removed.
+*
+* @param map multimap containing entries
+* @param value value to remove, compared bytewise
+* @param key key of the values
+*
+* @return pointer to the multimap or NULL if the pair does not exist
+*/
+multimap* remove_multimap_value(multimap* map, const void* value, const char* key);
+
+/**
+* @brief Removes a key with all of its values
+*
+* @param map multimap containing entries
+* @param key key to remove
+*
+* @return pointer to the multimap or NULL
+*/
+multimap* remove_multimap_key(multimap* map, const char* key);
+
+/**
+* @brief Returns the number of keys of a given multimap
+*
+* @param map multimap containing entries
+*
+* @return the number of keys or -1
+*/
+int get_number_of_multimap_keys(multimap* map);
+
+/**
+* @brief Returns the number of values of all keys of a given multimap
+*
+* @param map multimap containing entries
+*
+* @return the number of values or -1
+*/
+int get_number_of_multimap_values(multimap* map);
+
+/**
+* @brief Checks if a given key is part of a given multimap
+*
+* @param map multimap containing entries
+* @param key key to search for
+*
+* @return 1 if the key exists, 0 if not or -1
+*/
+int contains_multimap_key(multimap* map, const char* key);
+
+#endif
@@ -0,0 +1,184 @@
+/*
+MIT License
+
+Copyright (c) 2016 Julius Paffrath
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef LIBC_ORDERED_DICTIONARY
+#define LIBC_ORDERED_DICTIONARY
+
+#include "list.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#define ORDERED_NODE_KEYS 32
+
+struct ordered_node {
+	int is_leaf;
+	int key_count;
+	uint64_t prefixes[ORDERED_NODE_KEYS];
+	char* keys[ORDERED_NODE_KEYS];
+	union {
+		void* values[ORDERED_NODE_KEYS];
+		struct ordered_node* children[ORDERED_NODE_KEYS + 1];
+	};
+	struct ordered_node* next;
+};
+
+typedef struct ordered_node ordered_node;
+
+struct ordered_dictionary {
+	ordered_node* root;
+	ordered_node* spare;
+	int entry_count;
+};
+
+typedef struct ordered_dictionary ordered_dictionary;
+
+struct ordered_iterator {
+	ordered_node* leaf;
+	int index;
+	char* to;
+};
+
+typedef struct ordered_iterator ordered_iterator;
+
+/**
+* @brief Creates a new empty ordered dictionary
+*
+* The entries of an ordered dictionary are kept sorted by key in a B+ tree.
+* Nodes are wide and store the first bytes of their keys inline, so most
+* comparisons of a lookup are done without following a key pointer.
+*
+* @return pointer to the new ordered dictionary or NULL
+*/
+ordered_dictionary* create_ordered_dictionary(void);
+
+/**
+* @brief Deletes a given ordered dictionary and all of its entries
+*
+* @param dictionary pointer to an ordered dictionary
+*/
+void delete_ordered_dictionary(ordered_dictionary** dictionary);
+
+/**
+* @brief Adds a new value-key pair to a given ordered dictionary
+*
+* If the given key already exists, the value of this entry
+* is updated with the given value.
+*
+* @param dictionary dictionary for adding the new pair to
+* @param value address of the value
+* @param value_size size of the value
+* @param key string representing the key
+*
+* @return pointer to the stored value or NULL
+*/
+void* add_ordered_entry(ordered_dictionary* dictionary, const void* value, size_t value_size, const char* key);
+
+/**
+* @brief Removes an entry with a given key
+*
+* @param dictionary dictionary containing entries
+* @param key key of the entry
+*
+* @return pointer to the dictionary or NULL
+*/
+ordered_dictionary* remove_ordered_entry(ordered_dictionary* dictionary, const char* key);
+
+/**
+* @brief Returns the value of the entry with the given key
+*
+* @param dictionary dictionary containing entries
+* @param key key of the entry
+*
+* @return pointer to the value of the entry with the given key or NULL
+*/
+void* get_ordered_entry(ordered_dictionary* dictionary, const char* key);
+
+/**
+* @brief Returns the number of entries of a given ordered dictionary
+*
+* @param dictionary dictionary containing entries
+*
+* @return the number of entries or -1
+*/
+int get_number_of_ordered_entries(ordered_dictionary* dictionary);
+
+/**
+* @brief Checks if a given key is part of a given ordered dictionary
+*
+* @param dictionary dictionary containing entries
+* @param key key to search for
+*
+* @return 1 if the key exists, 0 if not or -1
+*/
+int contains_ordered_key(ordered_dictionary* dictionary, const char* key);
+
+/**
+* @brief Returns a list containing the keys from a given ordered dictionary in ascending order
+*
+* @param dictionary dictionary containing entries
+*
+* @return a new allocated list containing the keys or NULL
+*/
+element* get_ordered_keys(ordered_dictionary* dictionary);
+
+/**
+* @brief Creates an iterator over the entries with keys in the range [from, to)
+*
+* The iterator visits the entries in ascending order of their keys.
+* The dictionary must not be modified while the iterator is in use.
+*
+* @param dictionary dictionary containing entries
+* @param from first key of the range or NULL to start at the smallest key
+* @param to key ending the range or NULL to iterate up to the largest key
+*
+* @return pointer to the new iterator or NULL
+*/
+ordered_iterator* create_ordered_iterator(ordered_dictionary* dictionary, const char* from, const char* to);
+
+/**
+* @brief Advances an iterator to the next entry
+*
+* @param iterator iterator created by create_ordered_iterator
+* @param key address receiving the key of the entry, may be NULL
+* @param value address receiving the value of the entry, may be NULL
+*
+* @return 1 if an entry was returned, 0 if there are no more entries
+*/
+int next_ordered_entry(ordered_iterator* iterator, const char** key, void** value);
+
+/**
+* @brief Deletes a given ordered iterator
+*
+* @param iterator pointer to an ordered iterator
+*/
+void delete_ordered_iterator(ordered_iterator** iterator);
+
+/**
+* @brief Prints a representation of a given ordered dictionary
+*
+* Note that currently only string values are displayed correctly
+*/
+void print_ordered_dictionary(ordered_dictionary* dictionary);
+
+#endif
@@ -0,0 +1,152 @@
+/*
+MIT License
+
+Copyright (c) 2016 Julius Paffrath
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef LIBC_PERSISTENT_DICTIONARY
+#define LIBC_PERSISTENT_DICTIONARY
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdatomic.h>
+
+#include "hash.h"
+
+struct persistent_entry {
+	atomic_int references;
+	uint64_t hash;
+	size_t value_size;
+	char* key;
+	void* value;
+	char data[];
+};
+
+typedef struct persistent_entry persistent_entry;
+
+struct persistent_node {
+	atomic_int references;
+	uint32_t entry_map;
+	uint32_t node_map;
+	uint32_t entries;
+	uint32_t count;
+	void* slots[];
+};
+
+typedef struct persistent_node persistent_node;
+
+struct persistent_dictionary {
+	persistent_node* root;
+	int entry_count;
+	hasher key_hasher;
+};
+
+typedef struct persistent_dictionary persistent_dictionary;
+
+/**
+* @brief Creates a new empty persistent dictionary
+*
+* The dictionary is a hash array mapped trie whose nodes and entries are
+* shared between versions. Updates copy only the nodes on the path to the
+* changed entry, so every snapshot stays valid and immutable.
+* A single handle must not be used by several threads at the same time,
+* but snapshots may be handed to other threads.
+*
+* @return pointer to the new dictionary or NULL
+*/
+persistent_dictionary* create_persistent_dictionary(void);
+
+/**
+* @brief Deletes a given handle
+*
+* Nodes and entries are freed once no other snapshot references them.
+*
+* @param dictionary pointer to a persistent dictionary
+*/
+void delete_persistent_dictionary(persistent_dictionary** dictionary);
+
+/**
+* @brief Returns a new handle to the current version of a dictionary in O(1)
+*
+* Later changes of either handle are not visible through the other one.
+*
+* @param dictionary persistent dictionary
+*
+* @return pointer to the snapshot or NULL
+*/
+persistent_dictionary* snapshot_persistent_dictionary(persistent_dictionary* dictionary);
+
+/**
+* @brief Adds a copy of a value to a dictionary
+*
+* If the given key already exists, its value is replaced in the new version.
+*
+* @param dictionary dictionary for adding the value to
+* @param value value of the new entry
+* @param value_size size of the new value
+* @param key string representing the key
+*
+* @return pointer to the new entry or NULL
+*/
+const persistent_entry* add_persistent_entry(persistent_dictionary* dictionary, const void* value, size_t value_size, const char* key);
+
+/**
+* @brief Removes an entry with a given key
+*
+* @param dictionary dictionary containing entries
+* @param key key of the entry
+*
+* @return pointer to the dictionary or NULL
+*/
+persistent_dictionary* remove_persistent_entry(persistent_dictionary* dictionary, const char* key);
+
+/**
+* @brief Returns the entry with the given key
+*
+* The entry stays valid as long as a handle references the version containing it.
+*
+* @param dictionary dictionary containing entries
+* @param key key of the entry
+*
+* @return pointer to the entry with the given key or NULL
+*/
+const persistent_entry* get_persistent_entry(persistent_dictionary* dictionary, const char* key);
+
+/**
+* @brief Returns the number of entries of a given dictionary
+*
+* @param dictionary dictionary containing entries
+*
+* @return the number of entries or -1
+*/
+int get_number_of_persistent_entries(persistent_dictionary* dictionary);
+
+/**
+* @brief Checks if a given key is part of a given dictionary
+*
+* @param dictionary dictionary containing entries
+* @param key key to search for
+*
+* @return 1 if the key exists, 0 if not or -1
+*/
+int contains_persistent_key(persistent_dictionary* dictionary, const char* key);
+
+#endif
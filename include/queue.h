@@ -0,0 +1,151 @@
+/*
+MIT License
+
+Copyright (c) 2016 Julius Paffrath
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef LIBC_QUEUE
+#define LIBC_QUEUE
+
+#include <stddef.h>
+#include <stdatomic.h>
+
+struct queue_node {
+	void* value;
+	_Atomic(struct queue_node*) next;
+	char data[];
+};
+
+typedef struct queue_node queue_node;
+
+struct mpmc_cell {
+	atomic_size_t sequence;
+	char data[];
+};
+
+typedef struct mpmc_cell mpmc_cell;
+
+struct mpmc_queue {
+	_Alignas(64) atomic_size_t enqueue_position;
+	_Alignas(64) atomic_size_t dequeue_position;
+	_Alignas(64) char* cells;
+	size_t cell_size;
+	size_t mask;
+	size_t value_size;
+};
+
+typedef struct mpmc_queue mpmc_queue;
+
+struct mpsc_queue {
+	_Alignas(64) _Atomic(queue_node*) head;
+	_Alignas(64) queue_node* tail;
+	queue_node* stub;
+	size_t value_size;
+	mpmc_queue* recycled;
+};
+
+typedef struct mpsc_queue mpsc_queue;
+
+/**
+* @brief Creates a new bounded lock-free queue for many producers and many consumers
+*
+* Values are copied into a ring of cells, every cell carries a sequence number
+* which tells producers and consumers whether it is free or filled.
+*
+* @param capacity maximum number of values, rounded up to a power of two
+* @param value_size size of every value
+*
+* @return pointer to the new queue or NULL
+*/
+mpmc_queue* create_mpmc_queue(size_t capacity, size_t value_size);
+
+/**
+* @brief Deletes a given bounded queue and all values in it
+*
+* @param queue pointer to a bounded queue
+*/
+void delete_mpmc_queue(mpmc_queue** queue);
+
+/**
+* @brief Copies a value into a bounded queue
+*
+* @param queue bounded queue
+* @param value address of the value
+*
+* @return 0 on success or -1 if the queue is full
+*/
+int enqueue_mpmc(mpmc_queue* queue, const void* value);
+
+/**
+* @brief Copies the oldest value out of a bounded queue and removes it
+*
+* @param queue bounded queue
+* @param value destination of the value
+*
+* @return 0 on success or -1 if the queue is empty
+*/
+int dequeue_mpmc(mpmc_queue* queue, void* value);
+
+/**
+* @brief Creates a new unbounded lock-free queue for many producers and a single consumer
+*
+* Nodes have the shape of list elements with the value stored inline. Nodes of
+* dequeued values are recycled through a bounded queue, so a steady stream of
+* values does not allocate. A node is only recycled after its successor has been
+* linked, so producers never touch a node which has been handed out again.
+*
+* @param value_size size of every value
+*
+* @return pointer to the new queue or NULL
+*/
+mpsc_queue* create_mpsc_queue(size_t value_size);
+
+/**
+* @brief Deletes a given queue and all values in it
+*
+* @param queue pointer to a queue
+*/
+void delete_mpsc_queue(mpsc_queue** queue);
+
+/**
+* @brief Copies a value into a queue, may be called by any thread
+*
+* @param queue queue
+* @param value address of the value
+*
+* @return 0 on success or -1
+*/
+int enqueue_mpsc(mpsc_queue* queue, const void* value);
+
+/**
+* @brief Copies the oldest value out of a queue and removes it
+*
+* Must only be called by one consumer thread at a time.
+* A value whose producer has not finished linking it is reported as missing.
+*
+* @param queue queue
+* @param value destination of the value
+*
+* @return 0 on success or -1 if the queue is empty
+*/
+int dequeue_mpsc(mpsc_queue* queue, void* value);
+
+#endif
@@ -0,0 +1,210 @@
+/*
+MIT License
+
+Copyright (c) 2016 Julius Paffrath
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef LIBC_RADIX_TREE
+#define LIBC_RADIX_TREE
+
+#include "list.h"
+#include "dictionary.h"
+#include <stddef.h>
+
+struct radix_node {
+	char* label;
+	size_t label_length;
+	void* value;
+	size_t value_size;
+	struct radix_node* children;
+	struct radix_node* next;
+};
+
+typedef struct radix_node radix_node;
+
+struct radix_tree {
+	radix_node* root;
+	int entry_count;
+};
+
+typedef struct radix_tree radix_tree;
+
+struct radix_frame {
+	radix_node* node;
+	size_t key_length;
+	int visit_siblings;
+};
+
+typedef struct radix_frame radix_frame;
+
+struct radix_iterator {
+	radix_frame* stack;
+	int stack_size;
+	int stack_capacity;
+	char* key;
+	size_t key_capacity;
+};
+
+typedef struct radix_iterator radix_iterator;
+
+/**
+* @brief Creates a new empty radix tree
+*
+* A radix tree is a dictionary which stores its keys in a compressed trie.
+* Keys sharing a prefix share the nodes of that prefix, so all keys below
+* a given prefix can be enumerated without visiting any other key.
+*
+* @return pointer to the new radix tree or NULL
+*/
+radix_tree* create_radix_tree(void);
+
+/**
+* @brief Deletes a given radix tree and all of its entries
+*
+* @param tree pointer to a radix tree
+*/
+void delete_radix_tree(radix_tree** tree);
+
+/**
+* @brief Clones a given radix tree and all of its entries into a new allocated radix tree
+*
+* @param tree the radix tree to be cloned
+*
+* @return pointer to the new cloned radix tree or NULL
+*/
+radix_tree* clone_radix_tree(radix_tree* tree);
+
+/**
+* @brief Adds a new value-key pair to a given radix tree
+*
+* If the given key already exists, the value of this entry
+* is updated with the given value.
+*
+* @param tree radix tree for adding the new pair to
+* @param value address of the value
+* @param value_size size of the value
+* @param key string representing the key
+*
+* @return pointer to the node holding the value or NULL
+*/
+radix_node* add_radix_entry(radix_tree* tree, const void* value, size_t value_size, const char* key);
+
+/**
+* @brief Removes an entry with a given key
+*
+* @param tree radix tree containing entries
+* @param key key of the entry
+*
+* @return pointer to the radix tree or NULL
+*/
+radix_tree* remove_radix_entry(radix_tree* tree, const char* key);
+
+/**
+* @brief Returns the value of the entry with the given key
+*
+* @param tree radix tree containing entries
+* @param key key of the entry
+*
+* @return pointer to the value of the entry with the given key or NULL
+*/
+void* get_radix_entry(radix_tree* tree, const char* key);
+
+/**
+* @brief Returns the number of entries of a given radix tree
+*
+* @param tree radix tree containing entries
+*
+* @return the number of entries or -1
+*/
+int get_number_of_radix_entries(radix_tree* tree);
+
+/**
+* @brief Checks if a given key is part of a given radix tree
+*
+* @param tree radix tree containing entries
+* @param key key to search for
+*
+* @return 1 if the key exists, 0 if not or -1
+*/
+int contains_radix_key(radix_tree* tree, const char* key);
+
+/**
+* @brief Returns a list containing the keys from a given radix tree in lexicographic order
+*
+* @param tree radix tree containing entries
+*
+* @return a new allocated list containing the keys or NULL
+*/
+element* get_radix_keys(radix_tree* tree);
+
+/**
+* @brief Returns a dictionary containing all entries whose key starts with a given prefix
+*
+* The entries are copied in lexicographic order of their keys.
+*
+* @param tree radix tree containing entries
+* @param prefix prefix of the keys
+*
+* @return a new allocated dictionary or NULL if no key starts with prefix
+*/
+entry* get_entries_with_prefix(radix_tree* tree, const char* prefix);
+
+/**
+* @brief Creates an iterator over all entries whose key starts with a given prefix
+*
+* The iterator visits the entries in lexicographic order of their keys.
+* The radix tree must not be modified while the iterator is in use.
+*
+* @param tree radix tree containing entries
+* @param prefix prefix of the keys, an empty string visits all entries
+*
+* @return pointer to the new iterator or NULL
+*/
+radix_iterator* create_radix_iterator(radix_tree* tree, const char* prefix);
+
+/**
+* @brief Advances an iterator to the next entry
+*
+* The returned key is owned by the iterator and only valid until the next call.
+*
+* @param iterator iterator created by create_radix_iterator
+* @param key address receiving the key of the entry, may be NULL
+* @param value address receiving the value of the entry, may be NULL
+*
+* @return 1 if an entry was returned, 0 if there are no more entries
+*/
+int next_radix_entry(radix_iterator* iterator, const char** key, void** value);
+
+/**
+* @brief Deletes a given radix iterator
+*
+* @param iterator pointer to a radix iterator
+*/
+void delete_radix_iterator(radix_iterator** iterator);
+
+/**
+* @brief Prints a representation of a given radix tree
+*
+* Note that currently only string values are displayed correctly
+*/
+void print_radix_tree(radix_tree* tree);
+
+#endif
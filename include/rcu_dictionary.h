@@ -0,0 +1,144 @@
+/*
+MIT License
+
+Copyright (c) 2016 Julius Paffrath
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef LIBC_RCU_DICTIONARY
+#define LIBC_RCU_DICTIONARY
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+#include "hash.h"
+
+struct rcu_entry {
+	_Atomic(struct rcu_entry*) next;
+	uint64_t hash;
+	size_t value_size;
+	char* key;
+	void* value;
+	char data[];
+};
+
+typedef struct rcu_entry rcu_entry;
+
+struct rcu_table {
+	size_t bucket_count;
+	_Atomic(rcu_entry*) buckets[];
+};
+
+typedef struct rcu_table rcu_table;
+
+struct rcu_dictionary {
+	_Atomic(rcu_table*) table;
+	struct epoch_domain* epoch;
+	hasher key_hasher;
+	_Alignas(64) atomic_int entry_count;
+	pthread_mutex_t writer_lock;
+};
+
+typedef struct rcu_dictionary rcu_dictionary;
+
+/**
+* @brief Creates a new empty dictionary optimized for read-mostly workloads
+*
+* Readers never take a lock: lookups only read the published version of
+* the dictionary and announce themselves in a slot owned by their thread.
+* Writers are serialized by a mutex and publish every change atomically,
+* memory of replaced entries is reclaimed once no reader can see it anymore.
+*
+* @return pointer to the new dictionary or NULL
+*/
+rcu_dictionary* create_rcu_dictionary(void);
+
+/**
+* @brief Deletes a given rcu dictionary and all of its entries
+*
+* No other thread may access the dictionary while it is deleted.
+*
+* @param dictionary pointer to a rcu dictionary
+*/
+void delete_rcu_dictionary(rcu_dictionary** dictionary);
+
+/**
+* @brief Adds a new value-key pair to a given rcu dictionary
+*
+* If the given key already exists, the entry is replaced by a new entry
+* holding the given value. Readers see either the old or the new value.
+*
+* @param dictionary dictionary for adding the new pair to
+* @param value address of the value
+* @param value_size size of the value
+* @param key string representing the key
+*
+* @return 0 on success or -1
+*/
+int add_rcu_entry(rcu_dictionary* dictionary, const void* value, size_t value_size, const char* key);
+
+/**
+* @brief Removes an entry with a given key
+*
+* @param dictionary dictionary containing entries
+* @param key key of the entry
+*
+* @return 0 if the entry was removed or -1
+*/
+int remove_rcu_entry(rcu_dictionary* dictionary, const char* key);
+
+/**
+* @brief Copies the value of the entry with the given key
+*
+* This function is wait-free and never blocks on writers.
+*
+* @param dictionary dictionary containing entries
+* @param key key of the entry
+* @param value address the value is copied to, may be NULL
+* @param value_size maximum number of bytes copied to value
+*
+* @return the size of the stored value or -1
+*/
+int get_rcu_entry(rcu_dictionary* dictionary, const char* key, void* value, size_t value_size);
+
+/**
+* @brief Returns the number of entries of a given rcu dictionary
+*
+* @param dictionary dictionary containing entries
+*
+* @return the number of entries or -1
+*/
+int get_number_of_rcu_entries(rcu_dictionary* dictionary);
+
+/**
+* @brief Checks if a given key is part of a given rcu dictionary
+*
+* This function is wait-free and never blocks on writers.
+*
+* @param dictionary dictionary containing entries
+* @param key key to search for
+*
+* @return 1 if the key exists, 0 if not or -1
+*/
+int contains_rcu_key(rcu_dictionary* dictionary, const char* key);
+
+#endif
@@ -0,0 +1,278 @@
+/*
+MIT License
+
+Copyright (c) 2016 Julius Paffrath
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef LIBC_SIMD
+#define LIBC_SIMD
+
+/*
+* Search and aggregation kernels over contiguous arrays of int, double and
+* char values. On x86-64 processors supporting AVX2 vectorized kernels are
+* selected at runtime, everywhere else portable loops are used.
+*/
+
+/**
+* @brief Returns the index of the first occurrence of a value in an int array
+*
+* @param values array
+* @param count number of values
+* @param value value to search for
+*
+* @return the index or -1
+*/
+int find_int_in_array(const int* values, int count, int value);
+
+/**
+* @brief Counts the occurrences of a value in an int array
+*
+* @param values array
+* @param count number of values
+* @param value value to count
+*
+* @return the number of occurrences or -1
+*/
+int count_int_in_array(const int* values, int count, int value);
+
+/**
+* @brief Computes the smallest value of an int array
+*
+* @param values array
+* @param count number of values
+* @param result receives the smallest value
+*
+* @return 0 on success or -1 for an empty array
+*/
+int get_min_of_int_array(const int* values, int count, int* result);
+
+/**
+* @brief Computes the largest value of an int array
+*
+* @param values array
+* @param count number of values
+* @param result receives the largest value
+*
+* @return 0 on success or -1 for an empty array
+*/
+int get_max_of_int_array(const int* values, int count, int* result);
+
+/**
+* @brief Computes the sum of an int array without overflowing an int
+*
+* @param values array
+* @param count number of values
+*
+* @return the sum
+*/
+long long get_sum_of_int_array(const int* values, int count);
+
+/**
+* @brief Copies all values of an int array between low and high inclusive
+*
+* @param values array
+* @param count number of values
+* @param low lower bound
+* @param high upper bound
+* @param result array of at least count values receiving the matches in order
+*
+* @return the number of matches or -1
+*/
+int filter_int_array_range(const int* values, int count, int low, int high, int* result);
+
+/**
+* @brief Returns the index of the first value of a double array comparing equal to a value
+*
+* @param values array
+* @param count number of values
+* @param value value to search for, NaN is never found
+*
+* @return the index or -1
+*/
+int find_double_in_array(const double* values, int count, double value);
+
+/**
+* @brief Counts the values of a double array comparing equal to a value
+*
+* @param values array
+* @param count number of values
+* @param value value to count
+*
+* @return the number of occurrences or -1
+*/
+int count_double_in_array(const double* values, int count, double value);
+
+/**
+* @brief Computes the smallest value of a double array, the result is unspecified if it contains NaN
+*
+* @param values array
+* @param count number of values
+* @param result receives the smallest value
+*
+* @return 0 on success or -1 for an empty array
+*/
+int get_min_of_double_array(const double* values, int count, double* result);
+
+/**
+* @brief Computes the largest value of a double array, the result is unspecified if it contains NaN
+*
+* @param values array
+* @param count number of values
+* @param result receives the largest value
+*
+* @return 0 on success or -1 for an empty array
+*/
+int get_max_of_double_array(const double* values, int count, double* result);
+
+/**
+* @brief Computes the sum of a double array
+*
+* The values are added in several interleaved partial sums,
+* so the result may differ from a sequential sum by rounding.
+*
+* @param values array
+* @param count number of values
+*
+* @return the sum
+*/
+double get_sum_of_double_array(const double* values, int count);
+
+/**
+* @brief Copies all values of a double array between low and high inclusive
+*
+* @param values array
+* @param count number of values
+* @param low lower bound
+* @param high upper bound
+* @param result array of at least count values receiving the matches in order
+*
+* @return the number of matches or -1
+*/
+int filter_double_array_range(const double* values, int count, double low, double high, double* result);
+
+/**
+* @brief Computes the dot product of two double arrays
+*
+* @param first first array
+* @param second second array
+* @param count number of values of each array
+*
+* @return the dot product, summed like get_sum_of_double_array
+*/
+double get_dot_product_of_double_arrays(const double* first, const double* second, int count);
+
+/**
+* @brief Computes the sum of the squared differences between the values of a double array and a center
+*
+* @param values array
+* @param count number of values
+* @param center value subtracted from every value, usually the mean
+*
+* @return the sum of the squared differences
+*/
+double get_squared_deviation_of_double_array(const double* values, int count, double center);
+
+/**
+* @brief Counts the values of a double array falling into equally wide bins between low and high
+*
+* Bin i covers [low + i * width, low + (i + 1) * width), the last bin includes high.
+* Values outside of [low, high] and NaN are not counted.
+* Fails if high - low overflows or is too small to give the bins a width.
+*
+* @param values array
+* @param count number of values
+* @param low lower bound of the first bin
+* @param high upper bound of the last bin, greater than low
+* @param bins number of bins
+* @param counts array of bins counters, the counts are added to it
+*
+* @return 0 on success or -1
+*/
+int add_double_array_to_histogram(const double* values, int count, double low, double high, int bins, int* counts);
+
+/**
+* @brief Returns the index of the first occurrence of a value in a char array
+*
+* @param values array
+* @param count number of values
+* @param value value to search for
+*
+* @return the index or -1
+*/
+int find_char_in_array(const char* values, int count, char value);
+
+/**
+* @brief Counts the occurrences of a value in a char array
+*
+* @param values array
+* @param count number of values
+* @param value value to count
+*
+* @return the number of occurrences or -1
+*/
+int count_char_in_array(const char* values, int count, char value);
+
+/**
+* @brief Computes the smallest value of a char array
+*
+* @param values array
+* @param count number of values
+* @param result receives the smallest value
+*
+* @return 0 on success or -1 for an empty array
+*/
+int get_min_of_char_array(const char* values, int count, char* result);
+
+/**
+* @brief Computes the largest value of a char array
+*
+* @param values array
+* @param count number of values
+* @param result receives the largest value
+*
+* @return 0 on success or -1 for an empty array
+*/
+int get_max_of_char_array(const char* values, int count, char* result);
+
+/**
+* @brief Computes the sum of a char array
+*
+* @param values array
+* @param count number of values
+*
+* @return the sum
+*/
+long long get_sum_of_char_array(const char* values, int count);
+
+/**
+* @brief Copies all values of a char array between low and high inclusive
+*
+* @param values array
+* @param count number of values
+* @param low lower bound
+* @param high upper bound
+* @param result array of at least count values receiving the matches in order
+*
+* @return the number of matches or -1
+*/
+int filter_char_array_range(const char* values, int count, char low, char high, char* result);
+
+#endif
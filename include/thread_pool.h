@@ -0,0 +1,142 @@
+/*
+MIT License
+
+Copyright (c) 2016 Julius Paffrath
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef LIBC_THREAD_POOL
+#define LIBC_THREAD_POOL
+
+#include <stddef.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+#include "work_deque.h"
+
+struct task_group {
+	atomic_int remaining;
+};
+
+typedef struct task_group task_group;
+
+struct pool_task {
+	void (*function)(void* argument);
+	void* argument;
+	task_group* group;
+	struct pool_task* next;
+};
+
+typedef struct pool_task pool_task;
+
+struct pool_worker {
+	struct thread_pool* pool;
+	int index;
+	pthread_t thread;
+};
+
+typedef struct pool_worker pool_worker;
+
+struct thread_pool {
+	int thread_count;
+	pool_worker* workers;
+	work_deque** deques;
+	pthread_mutex_t lock;
+	pthread_cond_t wake;
+	pool_task* injected_head;
+	pool_task* injected_tail;
+	atomic_int injected_count;
+	atomic_int pending;
+	atomic_int sleeping;
+	int stop;
+};
+
+typedef struct thread_pool thread_pool;
+
+/**
+* @brief Creates a new pool of worker threads
+*
+* Every worker owns a work-stealing deque for the tasks it submits itself,
+* tasks from other threads are injected through a shared queue. Idle workers
+* steal from the deques of the others before they go to sleep.
+*
+* @param threads number of worker threads
+*
+* @return pointer to the new pool or NULL
+*/
+thread_pool* create_thread_pool(int threads);
+
+/**
+* @brief Runs all submitted tasks, stops the workers and deletes a given pool
+*
+* @param pool pointer to a pool
+*/
+void delete_thread_pool(thread_pool** pool);
+
+/**
+* @brief Returns the pool used by the parallel operations of libclist
+*
+* The pool is created on first use with one worker less than there are
+* online processors, since the calling thread helps while it waits.
+*
+* @return pointer to the default pool or NULL
+*/
+thread_pool* get_default_thread_pool(void);
+
+/**
+* @brief Returns the number of worker threads of a given pool
+*
+* @param pool pool
+*
+* @return the number of workers or -1
+*/
+int get_thread_count(thread_pool* pool);
+
+/**
+* @brief Initializes an empty task group
+*
+* @param group group to initialize
+*/
+void init_task_group(task_group* group);
+
+/**
+* @brief Submits a task to a given pool
+*
+* @param pool pool which runs the task
+* @param group group which is waited for with wait_task_group
+* @param function function of the task
+* @param argument argument passed to the function
+*
+* @return 0 on success or -1
+*/
+int submit_task(thread_pool* pool, task_group* group, void (*function)(void* argument), void* argument);
+
+/**
+* @brief Waits until all tasks of a group have finished
+*
+* The calling thread runs pending tasks while it waits,
+* so tasks may submit and wait for further tasks themselves.
+*
+* @param pool pool which runs the tasks
+* @param group group to wait for
+*/
+void wait_task_group(thread_pool* pool, task_group* group);
+
+#endif
@@ -0,0 +1,108 @@
+/*
+MIT License
+
+Copyright (c) 2016 Julius Paffrath
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef LIBC_WORK_DEQUE
+#define LIBC_WORK_DEQUE
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdatomic.h>
+
+struct work_array {
+	struct work_array* previous;
+	int64_t mask;
+	_Atomic(void*) items[];
+};
+
+typedef struct work_array work_array;
+
+struct work_deque {
+	_Alignas(64) _Atomic(int64_t) top;
+	_Alignas(64) _Atomic(int64_t) bottom;
+	_Atomic(work_array*) array;
+};
+
+typedef struct work_deque work_deque;
+
+/**
+* @brief Creates a new Chase-Lev work-stealing deque
+*
+* The owner thread pushes and pops items at the bottom, other threads steal
+* items from the top. None of the operations takes a lock. The circular array
+* grows when it is full, replaced arrays are kept until the deque is deleted
+* because thieves may still read from them.
+*
+* @param capacity initial number of items, rounded up to a power of two
+*
+* @return pointer to the new deque or NULL
+*/
+work_deque* create_work_deque(size_t capacity);
+
+/**
+* @brief Deletes a given deque, the items themselves are not freed
+*
+* @param deque pointer to a deque
+*/
+void delete_work_deque(work_deque** deque);
+
+/**
+* @brief Pushes an item at the bottom of a deque, only called by the owner
+*
+* @param deque deque owned by the calling thread
+* @param item item, must not be NULL
+*
+* @return 0 on success or -1
+*/
+int push_work(work_deque* deque, void* item);
+
+/**
+* @brief Pops the most recently pushed item, only called by the owner
+*
+* @param deque deque owned by the calling thread
+*
+* @return the item or NULL if the deque is empty
+*/
+void* pop_work(work_deque* deque);
+
+/**
+* @brief Steals the oldest item of a deque, may be called by any thread
+*
+* @param deque deque of another thread
+*
+* @return the item or NULL if the deque is empty or another thread won the race for it
+*/
+void* steal_work(work_deque* deque);
+
+/**
+* @brief Returns the number of items of a given deque
+*
+* The result is only a snapshot while other threads use the deque.
+*
+* @param deque deque
+*
+* @return the number of items or -1
+*/
+int get_work_count(work_deque* deque);
+
+#endif
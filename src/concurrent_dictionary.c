@@ -0,0 +1,531 @@
+/*
+MIT License
+
+Copyright (c) 2016 Julius Paffrath
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <concurrent_dictionary.h>
+#include <hash.h>
+
+#include <string.h>
+#include <stdlib.h>
+
+#define INITIAL_BUCKET_COUNT 16
+
+static concurrent_shard* get_shard(concurrent_dictionary* dictionary, uint64_t hash) {
+	return &dictionary->shards[(hash >> 32) & (uint64_t)(dictionary->shard_count - 1)];
+}
+
+static concurrent_entry** get_bucket(concurrent_shard* shard, uint64_t hash) {
+	return &shard->buckets[hash & (shard->bucket_count - 1)];
+}
+
+static concurrent_entry* find_entry(concurrent_shard* shard, uint64_t hash, const char* key) {
+	concurrent_entry* iterator = *get_bucket(shard, hash);
+
+	while (iterator != NULL) {
+		if (iterator->hash == hash && strcmp(iterator->key, key) == 0) return iterator;
+		iterator = iterator->next;
+	}
+
+	return NULL;
+}
+
+static void free_entry(concurrent_entry* e) {
+	free(e->value);
+	free(e->key);
+	free(e);
+}
+
+static void grow_shard(concurrent_shard* shard) {
+	size_t new_count = shard->bucket_count * 2;
+	concurrent_entry** new_buckets = (concurrent_entry**)calloc(new_count, sizeof(concurrent_entry*));
+
+	if (new_buckets == NULL) return;
+
+	size_t i;
+	for (i = 0; i < shard->bucket_count; i++) {
+		concurrent_entry* iterator = shard->buckets[i];
+
+		while (iterator != NULL) {
+			concurrent_entry* next = iterator->next;
+			concurrent_entry** bucket = &new_buckets[iterator->hash & (new_count - 1)];
+
+			iterator->next = *bucket;
+			*bucket = iterator;
+			iterator = next;
+		}
+	}
+
+	free(shard->buckets);
+	shard->buckets = new_buckets;
+	shard->bucket_count = new_count;
+}
+
+concurrent_dictionary* create_concurrent_dictionary(int shard_count) {
+	if (shard_count <= 0) return NULL;
+
+	int count = 1;
+	while (count < shard_count) count <<= 1;
+
+	concurrent_dictionary* dictionary = (concurrent_dictionary*)malloc(sizeof(concurrent_dictionary));
+
+	if (dictionary == NULL) return NULL;
+
+	dictionary->shards = (concurrent_shard*)aligned_alloc(_Alignof(concurrent_shard), sizeof(concurrent_shard) * count);
+
+	if (dictionary->shards == NULL) {
+		free(dictionary);
+		return NULL;
+	}
+
+	int i;
+	for (i = 0; i < count; i++) {
+		concurrent_shard* shard = &dictionary->shards[i];
+
+		shard->buckets = (concurrent_entry**)calloc(INITIAL_BUCKET_COUNT, sizeof(concurrent_entry*));
+		shard->bucket_count = INITIAL_BUCKET_COUNT;
+		shard->entry_count = 0;
+
+		if (shard->buckets == NULL || pthread_rwlock_init(&shard->lock, NULL) != 0) {
+			free(shard->buckets);
+			dictionary->shard_count = i;
+			delete_concurrent_dictionary(&dictionary);
+			return NULL;
+		}
+	}
+
+	dictionary->shard_count = count;
+	dictionary->key_hasher = get_default_hasher();
+
+	return dictionary;
+}
+
+void delete_concurrent_dictionary(concurrent_dictionary** dictionary) {
+	if (*dictionary == NULL) return;
+
+	concurrent_dictionary* del = *dictionary;
+
+	int i;
+	for (i = 0; i < del->shard_count; i++) {
+		concurrent_shard* shard = &del->shards[i];
+
+		size_t j;
+		for (j = 0; j < shard->bucket_count; j++) {
+			concurrent_entry* iterator = shard->buckets[j];
+
+			while (iterator != NULL) {
+				concurrent_entry* next = iterator->next;
+				free_entry(iterator);
+				iterator = next;
+			}
+		}
+
+		free(shard->buckets);
+		pthread_rwlock_destroy(&shard->lock);
+	}
+
+	free(del->shards);
+	free(del);
+
+	*dictionary = NULL;
+}
+
+int add_concurrent_entry(concurrent_dictionary* dictionary, const void* value, size_t value_size, const char* key) {
+	if (dictionary == NULL || value == NULL || value_size <= 0 || key == NULL) return -1;
+
+	size_t key_len = strlen(key);
+	uint64_t hash = hash_key_with(&dictionary->key_hasher, key, key_len);
+
+	// allocate outside of the lock to keep the critical section short
+	void* new_value = malloc(value_size);
+
+	if (new_value == NULL) return -1;
+
+	memcpy(new_value, value, value_size);
+
+	concurrent_shard* shard = get_shard(dictionary, hash);
+	pthread_rwlock_wrlock(&shard->lock);
+
+	concurrent_entry* e = find_entry(shard, hash, key);
+
+	if (e != NULL) {
+		void* old_value = e->value;
+		e->value = new_value;
+		e->value_size = value_size;
+		pthread_rwlock_unlock(&shard->lock);
+
+		free(old_value);
+		return 0;
+	}
+
+	pthread_rwlock_unlock(&shard->lock);
+
+	e = (concurrent_entry*)malloc(sizeof(concurrent_entry));
+	char* new_key = (char*)malloc(key_len + 1);
+
+	if (e == NULL || new_key == NULL) {
+		free(e);
+		free(new_key);
+		free(new_value);
+		return -1;
+	}
+
+	memcpy(new_key, key, key_len + 1);
+
+	e->value = new_value;
+	e->value_size = value_size;
+	e->key = new_key;
+	e->hash = hash;
+
+	pthread_rwlock_wrlock(&shard->lock);
+
+	// another thread may have added the key while the lock was released
+	concurrent_entry* existing = find_entry(shard, hash, key);
+
+	if (existing != NULL) {
+		void* old_value = existing->value;
+		existing->value = new_value;
+		existing->value_size = value_size;
+		pthread_rwlock_unlock(&shard->lock);
+
+		free(old_value);
+		free(new_key);
+		free(e);
+		return 0;
+	}
+
+	concurrent_entry** bucket = get_bucket(shard, hash);
+	e->next = *bucket;
+	*bucket = e;
+
+	if (++shard->entry_count > shard->bucket_count) grow_shard(shard);
+
+	pthread_rwlock_unlock(&shard->lock);
+
+	return 0;
+}
+
+int remove_concurrent_entry(concurrent_dictionary* dictionary, const char* key) {
+	if (dictionary == NULL || key == NULL) return -1;
+
+	uint64_t hash = hash_key_with(&dictionary->key_hasher, key, strlen(key));
+	concurrent_shard* shard = get_shard(dictionary, hash);
+
+	pthread_rwlock_wrlock(&shard->lock);
+
+	concurrent_entry** link = get_bucket(shard, hash);
+
+	while (*link != NULL) {
+		concurrent_entry* target = *link;
+
+		if (target->hash == hash && strcmp(target->key, key) == 0) {
+			*link = target->next;
+			shard->entry_count--;
+			pthread_rwlock_unlock(&shard->lock);
+
+			free_entry(target);
+			return 0;
+		}
+
+		link = &target->next;
+	}
+
+	pthread_rwlock_unlock(&shard->lock);
+
+	return -1;
+}
+
+int get_concurrent_entry(concurrent_dictionary* dictionary, const char* key, void* value, size_t value_size) {
+	if (dictionary == NULL || key == NULL) return -1;
+
+	uint64_t hash = hash_key_with(&dictionary->key_hasher, key, strlen(key));
+	concurrent_shard* shard = get_shard(dictionary, hash);
+
+	pthread_rwlock_rdlock(&shard->lock);
+
+	concurrent_entry* e = find_entry(shard, hash, key);
+	int result = -1;
+
+	if (e != NULL) {
+		if (value != NULL) memcpy(value, e->value, value_size < e->value_size ? value_size : e->value_size);
+		result = (int)e->value_size;
+	}
+
+	pthread_rwlock_unlock(&shard->lock);
+
+	return result;
+}
+
+int get_number_of_concurrent_entries(concurrent_dictionary* dictionary) {
+	if (dictionary == NULL) return -1;
+
+	size_t counter = 0;
+
+	int i;
+	for (i = 0; i < dictionary->shard_count; i++) {
+		concurrent_shard* shard = &dictionary->shards[i];
+
+		pthread_rwlock_rdlock(&shard->lock);
+		counter += shard->entry_count;
+		pthread_rwlock_unlock(&shard->lock);
+	}
+
+	return (int)counter;
+}
+
+int contains_concurrent_key(concurrent_dictionary* dictionary, const char* key) {
+	if (dictionary == NULL || key == NULL) return -1;
+
+	return get_concurrent_entry(dictionary, key, NULL, 0) == -1 ? 0 : 1;
+}
+
+struct merge_task {
+	concurrent_dictionary* destination;
+	concurrent_dictionary* source;
+	merge_policy policy;
+	merge_combine combine;
+	int first_shard;
+	int stride;
+	int status;
+};
+
+typedef struct merge_task merge_task;
+
+static concurrent_entry* copy_entry(const concurrent_entry* e, uint64_t hash) {
+	concurrent_entry* copy = (concurrent_entry*)malloc(sizeof(concurrent_entry));
+	size_t key_len = strlen(e->key);
+
+	if (copy == NULL) return NULL;
+
+	copy->value = malloc(e->value_size);
+	copy->key = (char*)malloc(key_len + 1);
+
+	if (copy->value == NULL || copy->key == NULL) {
+		free_entry(copy);
+		return NULL;
+	}
+
+	memcpy(copy->value, e->value, e->value_size);
+	memcpy(copy->key, e->key, key_len + 1);
+	copy->value_size = e->value_size;
+	copy->hash = hash;
+
+	return copy;
+}
+
+// merges one entry into a locked shard, prepared is an owned copy of e or NULL
+static int merge_into_shard(concurrent_shard* shard, const concurrent_entry* e, uint64_t hash, concurrent_entry* prepared, merge_policy policy, merge_combine combine) {
+	concurrent_entry* existing = find_entry(shard, hash, e->key);
+
+	if (existing == NULL) {
+		concurrent_entry* copy = prepared != NULL ? prepared : copy_entry(e, hash);
+
+		if (copy == NULL) return -1;
+
+		concurrent_entry** bucket = get_bucket(shard, hash);
+		copy->next = *bucket;
+		*bucket = copy;
+
+		if (++shard->entry_count > shard->bucket_count) grow_shard(shard);
+
+		return 0;
+	}
+
+	int status = 0;
+
+	if (policy == MERGE_COMBINE && existing->value_size == e->value_size) {
+		combine(existing->value, e->value, e->value_size);
+	}
+	else if (policy != MERGE_KEEP_DESTINATION) {
+		void* value = malloc(e->value_size);
+
+		if (value != NULL) {
+			memcpy(value, e->value, e->value_size);
+			free(existing->value);
+			existing->value = value;
+			existing->value_size = e->value_size;
+		}
+		else {
+			status = -1;
+		}
+	}
+
+	if (prepared != NULL) free_entry(prepared);
+
+	return status;
+}
+
+// both shards have the same index, locks are taken in address order so opposite merges cannot deadlock
+static int merge_aligned_shard(merge_task* task, int index) {
+	concurrent_shard* from = &task->source->shards[index];
+	concurrent_shard* to = &task->destination->shards[index];
+
+	if ((uintptr_t)from < (uintptr_t)to) {
+		pthread_rwlock_rdlock(&from->lock);
+		pthread_rwlock_wrlock(&to->lock);
+	}
+	else {
+		pthread_rwlock_wrlock(&to->lock);
+		pthread_rwlock_rdlock(&from->lock);
+	}
+
+	while (to->bucket_count < to->entry_count + from->entry_count) {
+		size_t before = to->bucket_count;
+
+		grow_shard(to);
+		if (to->bucket_count == before) break;
+	}
+
+	int status = 0;
+
+	size_t i;
+	for (i = 0; i < from->bucket_count && status == 0; i++) {
+		concurrent_entry* iterator = from->buckets[i];
+
+		while (iterator != NULL && status == 0) {
+			status = merge_into_shard(to, iterator, iterator->hash, NULL, task->policy, task->combine);
+			iterator = iterator->next;
+		}
+	}
+
+	pthread_rwlock_unlock(&from->lock);
+	pthread_rwlock_unlock(&to->lock);
+
+	return status;
+}
+
+// copies the source shard first, so no source lock is held while destination shards are locked
+static int merge_rehashed_shard(merge_task* task, int index) {
+	concurrent_shard* from = &task->source->shards[index];
+	concurrent_entry* copies = NULL;
+	int status = 0;
+
+	pthread_rwlock_rdlock(&from->lock);
+
+	size_t i;
+	for (i = 0; i < from->bucket_count && status == 0; i++) {
+		concurrent_entry* iterator = from->buckets[i];
+
+		while (iterator != NULL) {
+			uint64_t hash = hash_key_with(&task->destination->key_hasher, iterator->key, strlen(iterator->key));
+			concurrent_entry* copy = copy_entry(iterator, hash);
+
+			if (copy == NULL) {
+				status = -1;
+				break;
+			}
+
+			copy->next = copies;
+			copies = copy;
+			iterator = iterator->next;
+		}
+	}
+
+	pthread_rwlock_unlock(&from->lock);
+
+	while (copies != NULL) {
+		concurrent_entry* copy = copies;
+		copies = copy->next;
+
+		if (status != 0) {
+			free_entry(copy);
+			continue;
+		}
+
+		concurrent_shard* to = get_shard(task->destination, copy->hash);
+
+		pthread_rwlock_wrlock(&to->lock);
+		status = merge_into_shard(to, copy, copy->hash, copy, task->policy, task->combine);
+		pthread_rwlock_unlock(&to->lock);
+	}
+
+	return status;
+}
+
+static void* merge_worker(void* arg) {
+	merge_task* task = (merge_task*)arg;
+	int aligned = task->source->shard_count == task->destination->shard_count &&
+		task->source->key_hasher.function == task->destination->key_hasher.function &&
+		task->source->key_hasher.seed == task->destination->key_hasher.seed;
+
+	int i;
+	for (i = task->first_shard; i < task->source->shard_count; i += task->stride) {
+		int status = aligned ? merge_aligned_shard(task, i) : merge_rehashed_shard(task, i);
+
+		if (status != 0) task->status = -1;
+	}
+
+	return NULL;
+}
+
+int merge_concurrent_dictionaries(concurrent_dictionary* destination, concurrent_dictionary* source, merge_policy policy, merge_combine combine, int threads) {
+	if (destination == NULL || source == NULL || destination == source || threads <= 0) return -1;
+	if (policy == MERGE_COMBINE && combine == NULL) return -1;
+
+	if (threads > source->shard_count) threads = source->shard_count;
+
+	merge_task* tasks = (merge_task*)malloc(sizeof(merge_task) * threads);
+	pthread_t* workers = (pthread_t*)malloc(sizeof(pthread_t) * threads);
+
+	if (tasks == NULL || workers == NULL) {
+		free(tasks);
+		free(workers);
+		return -1;
+	}
+
+	int i;
+	for (i = 0; i < threads; i++) {
+		tasks[i].destination = destination;
+		tasks[i].source = source;
+		tasks[i].policy = policy;
+		tasks[i].combine = combine;
+		tasks[i].first_shard = i;
+		tasks[i].stride = threads;
+		tasks[i].status = 0;
+	}
+
+	// the calling thread takes the first task, threads which fail to start are done inline
+	int started = 0;
+	for (i = 1; i < threads; i++) {
+		if (pthread_create(&workers[i], NULL, merge_worker, &tasks[i]) != 0) break;
+		started++;
+	}
+
+	merge_worker(&tasks[0]);
+
+	int j;
+	for (j = started + 1; j < threads; j++) {
+		merge_worker(&tasks[j]);
+	}
+
+	int status = 0;
+
+	for (i = 0; i < threads; i++) {
+		if (i >= 1 && i <= started) pthread_join(workers[i], NULL);
+		if (tasks[i].status != 0) status = -1;
+	}
+
+	free(tasks);
+	free(workers);
+
+	return status;
+}
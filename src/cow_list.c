@@ -0,0 +1,236 @@
+/*
+MIT License
+
+Copyright (c) 2016 Julius Paffrath
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <cow_list.h>
+
+#include <string.h>
+#include <stdlib.h>
+
+static cow_node* create_node(const void* value, size_t value_size, cow_node* next) {
+	cow_node* node = (cow_node*)malloc(sizeof(cow_node) + value_size);
+
+	if (node == NULL) return NULL;
+
+	atomic_init(&node->references, 1);
+	node->next = next;
+	memcpy(node->value, value, value_size);
+
+	return node;
+}
+
+static void retain(cow_node* node) {
+	if (node != NULL) atomic_fetch_add_explicit(&node->references, 1, memory_order_relaxed);
+}
+
+static int is_shared(cow_node* node) {
+	return atomic_load_explicit(&node->references, memory_order_acquire) > 1;
+}
+
+// drops a reference and frees the nodes nobody references any more, iteratively for long lists
+static void release(cow_node* node) {
+	while (node != NULL && atomic_fetch_sub_explicit(&node->references, 1, memory_order_acq_rel) == 1) {
+		cow_node* next = node->next;
+		free(node);
+		node = next;
+	}
+}
+
+/*
+* Makes the first index nodes owned by the list alone and returns the link
+* pointing to the node at index. Copying a shared node shares its successor,
+* so once the first shared node is found every node up to index is copied.
+*/
+static cow_node** own_prefix(cow_list* list, int index) {
+	cow_node** link = &list->head;
+
+	int i;
+	for (i = 0; i < index; i++) {
+		cow_node* node = *link;
+
+		if (is_shared(node)) {
+			cow_node* copy = create_node(node->value, list->value_size, node->next);
+
+			if (copy == NULL) return NULL;
+
+			retain(node->next);
+			*link = copy;
+			release(node);
+		}
+
+		link = &(*link)->next;
+	}
+
+	return link;
+}
+
+cow_list* create_cow_list(size_t value_size) {
+	if (value_size <= 0) return NULL;
+
+	cow_list* list = (cow_list*)malloc(sizeof(cow_list));
+
+	if (list == NULL) return NULL;
+
+	list->head = NULL;
+	list->length = 0;
+	list->value_size = value_size;
+
+	return list;
+}
+
+cow_list* create_cow_list_with_array(const void* values, size_t value_size, int length) {
+	if (values == NULL || length < 0) return NULL;
+
+	cow_list* list = create_cow_list(value_size);
+
+	if (list == NULL) return NULL;
+
+	// built back to front, pushing never copies
+	int i;
+	for (i = length - 1; i >= 0; i--) {
+		if (push_cow_value(list, (const char*)values + value_size * i) != 0) {
+			delete_cow_list(&list);
+			return NULL;
+		}
+	}
+
+	return list;
+}
+
+void delete_cow_list(cow_list** list) {
+	if (list == NULL || *list == NULL) return;
+
+	release((*list)->head);
+	free(*list);
+
+	*list = NULL;
+}
+
+cow_list* clone_cow_list(const cow_list* list) {
+	if (list == NULL) return NULL;
+
+	cow_list* clone = create_cow_list(list->value_size);
+
+	if (clone == NULL) return NULL;
+
+	retain(list->head);
+	clone->head = list->head;
+	clone->length = list->length;
+
+	return clone;
+}
+
+int push_cow_value(cow_list* list, const void* value) {
+	return insert_cow_value_at_index(list, value, 0);
+}
+
+int add_cow_value(cow_list* list, const void* value) {
+	if (list == NULL) return -1;
+
+	return insert_cow_value_at_index(list, value, list->length);
+}
+
+int insert_cow_value_at_index(cow_list* list, const void* value, int index) {
+	if (list == NULL || value == NULL || index < 0 || index > list->length) return -1;
+
+	cow_node** link = own_prefix(list, index);
+
+	if (link == NULL) return -1;
+
+	// the new node takes over the reference of the link
+	cow_node* node = create_node(value, list->value_size, *link);
+
+	if (node == NULL) return -1;
+
+	*link = node;
+	list->length++;
+
+	return 0;
+}
+
+int set_cow_value_at_index(cow_list* list, const void* value, int index) {
+	if (list == NULL || value == NULL || index < 0 || index >= list->length) return -1;
+
+	cow_node** link = own_prefix(list, index);
+
+	if (link == NULL) return -1;
+
+	cow_node* node = *link;
+
+	if (!is_shared(node)) {
+		memcpy(node->value, value, list->value_size);
+		return 0;
+	}
+
+	cow_node* copy = create_node(value, list->value_size, node->next);
+
+	if (copy == NULL) return -1;
+
+	retain(node->next);
+	*link = copy;
+	release(node);
+
+	return 0;
+}
+
+int remove_cow_value_at_index(cow_list* list, int index) {
+	if (list == NULL || index < 0 || index >= list->length) return -1;
+
+	cow_node** link = own_prefix(list, index);
+
+	if (link == NULL) return -1;
+
+	cow_node* node = *link;
+
+	retain(node->next);
+	*link = node->next;
+	release(node);
+	list->length--;
+
+	return 0;
+}
+
+const void* get_cow_value_at_index(const cow_list* list, int index) {
+	if (list == NULL || index < 0 || index >= list->length) return NULL;
+
+	const cow_node* node = list->head;
+
+	int i;
+	for (i = 0; i < index; i++) {
+		node = node->next;
+	}
+
+	return node->value;
+}
+
+const cow_node* get_first_cow_node(const cow_list* list) {
+	if (list == NULL) return NULL;
+
+	return list->head;
+}
+
+int get_length_of_cow_list(const cow_list* list) {
+	if (list == NULL) return -1;
+
+	return list->length;
+}
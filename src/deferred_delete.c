@@ -0,0 +1,223 @@
+/*
+MIT License
+
+Copyright (c) 2016 Julius Paffrath
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <deferred_delete.h>
+
+#include "list_memory.h"
+
+#include <stdlib.h>
+#include <pthread.h>
+
+// nodes freed before the reclaimer looks at the queue again
+#define DEFERRED_BATCH_SIZE 4096
+
+enum deferred_kind {
+	DEFERRED_LIST,
+	DEFERRED_LIST_ALLOC,
+	DEFERRED_DICTIONARY
+};
+
+struct deferred_job {
+	enum deferred_kind kind;
+	void* remaining;
+	void (*free_callback)(const void* value);
+	struct deferred_job* next;
+};
+
+typedef struct deferred_job deferred_job;
+
+static pthread_mutex_t reclaimer_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t reclaimer_wake = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t reclaimer_done = PTHREAD_COND_INITIALIZER;
+static pthread_once_t reclaimer_once = PTHREAD_ONCE_INIT;
+
+static deferred_job* queue_head = NULL;
+static deferred_job* queue_tail = NULL;
+static int pending = 0;
+static int reclaimer_running = 0;
+
+// frees up to DEFERRED_BATCH_SIZE nodes, returns the rest of the container
+static void* free_batch(deferred_job* job) {
+	int freed = 0;
+
+	if (job->kind == DEFERRED_DICTIONARY) {
+		entry* e = (entry*)job->remaining;
+
+		while (e != NULL && freed++ < DEFERRED_BATCH_SIZE) {
+			entry* next = e->next;
+
+			free(e->value);
+			free(e->key);
+			release_node(e, sizeof(entry));
+
+			e = next;
+		}
+
+		return e;
+	}
+
+	element* e = (element*)job->remaining;
+
+	while (e != NULL && freed++ < DEFERRED_BATCH_SIZE) {
+		element* next = e->next;
+
+		if (job->kind == DEFERRED_LIST_ALLOC) job->free_callback(e->value);
+
+		free_element_value(e->value);
+		free_element(e);
+
+		e = next;
+	}
+
+	return e;
+}
+
+static void* reclaimer_main(void* arg) {
+	(void)arg;
+
+	pthread_mutex_lock(&reclaimer_lock);
+
+	for (;;) {
+		while (queue_head == NULL) {
+			pthread_cond_wait(&reclaimer_wake, &reclaimer_lock);
+		}
+
+		deferred_job* job = queue_head;
+		queue_head = job->next;
+		if (queue_head == NULL) queue_tail = NULL;
+
+		pthread_mutex_unlock(&reclaimer_lock);
+
+		job->remaining = free_batch(job);
+
+		pthread_mutex_lock(&reclaimer_lock);
+
+		if (job->remaining != NULL) {
+			// unfinished containers go to the back, so large ones do not hold up small ones
+			job->next = NULL;
+
+			if (queue_tail == NULL) queue_head = job;
+			else queue_tail->next = job;
+
+			queue_tail = job;
+		}
+		else {
+			free(job);
+			pending--;
+
+			if (pending == 0) pthread_cond_broadcast(&reclaimer_done);
+		}
+	}
+
+	return NULL;
+}
+
+static void start_reclaimer(void) {
+	pthread_t thread;
+
+	if (pthread_create(&thread, NULL, reclaimer_main, NULL) == 0) {
+		pthread_detach(thread);
+		reclaimer_running = 1;
+	}
+}
+
+// returns -1 if the container has to be deleted by the caller
+static int defer(enum deferred_kind kind, void* container, void (*free_callback)(const void* value)) {
+	pthread_once(&reclaimer_once, start_reclaimer);
+
+	if (!reclaimer_running) return -1;
+
+	deferred_job* job = (deferred_job*)malloc(sizeof(deferred_job));
+
+	if (job == NULL) return -1;
+
+	job->kind = kind;
+	job->remaining = container;
+	job->free_callback = free_callback;
+	job->next = NULL;
+
+	pthread_mutex_lock(&reclaimer_lock);
+
+	if (queue_tail == NULL) queue_head = job;
+	else queue_tail->next = job;
+
+	queue_tail = job;
+	pending++;
+
+	pthread_cond_signal(&reclaimer_wake);
+	pthread_mutex_unlock(&reclaimer_lock);
+
+	return 0;
+}
+
+void delete_list_deferred(element** list) {
+	if (list == NULL || *list == NULL) return;
+
+	if (defer(DEFERRED_LIST, *list, NULL) != 0) {
+		delete_list(list);
+		return;
+	}
+
+	*list = NULL;
+}
+
+void delete_list_alloc_deferred(element** list, void (*free_callback)(const void* value)) {
+	if (list == NULL || *list == NULL || free_callback == NULL) return;
+
+	if (defer(DEFERRED_LIST_ALLOC, *list, free_callback) != 0) {
+		delete_list_alloc(list, free_callback);
+		return;
+	}
+
+	*list = NULL;
+}
+
+void delete_dictionary_deferred(entry** dictionary) {
+	if (dictionary == NULL || *dictionary == NULL) return;
+
+	if (defer(DEFERRED_DICTIONARY, *dictionary, NULL) != 0) {
+		delete_dictionary(dictionary);
+		return;
+	}
+
+	*dictionary = NULL;
+}
+
+void flush_deferred_deletes(void) {
+	pthread_mutex_lock(&reclaimer_lock);
+
+	while (pending > 0) {
+		pthread_cond_wait(&reclaimer_done, &reclaimer_lock);
+	}
+
+	pthread_mutex_unlock(&reclaimer_lock);
+}
+
+int get_number_of_deferred_deletes(void) {
+	pthread_mutex_lock(&reclaimer_lock);
+	int count = pending;
+	pthread_mutex_unlock(&reclaimer_lock);
+
+	return count;
+}
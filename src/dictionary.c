@@ -23,6 +23,10 @@ SOFTWARE.
 */
 
 #include <dictionary.h>
+#include <hash.h>
+
+#include "node_cache.h"
+#include "prefetch.h"
 
 #include <string.h>
 #include <stdlib.h>
@@ -31,7 +35,7 @@ SOFTWARE.
 entry* create_dictionary(const void* value, size_t value_size, const char* key) {
 	if (value == NULL || value_size <= 0 || key == NULL) return NULL;
 
-	entry* root = (entry*)malloc(sizeof(entry));
+	entry* root = (entry*)allocate_node(sizeof(entry));
 
 	if (root == NULL) return NULL;
 
@@ -58,12 +62,12 @@ void delete_dictionary(entry** dictionary) {
 
 		free(last->value);
 		free(last->key);
-		free(last);
+		release_node(last, sizeof(entry));
 	}
 
 	free(del->value);
 	free(del->key);
-	free(del);
+	release_node(del, sizeof(entry));
 
 	*dictionary = NULL;
 }
@@ -122,7 +126,7 @@ entry* remove_entry(entry* dictionary, const char* key) {
 			free(target->value);
 			free(target->key);
 			iterator->next = target->next;
-			free(target);
+			release_node(target, sizeof(entry));
 
 			return iterator;
 		}
@@ -149,6 +153,197 @@ entry* get_entry(entry* dictionary, const char* key) {
 	return NULL;
 }
 
+struct batch_index {
+	int* slots;
+	uint64_t* hashes;
+	size_t mask;
+	hasher key_hasher;
+};
+
+typedef struct batch_index batch_index;
+
+static void delete_batch_index(batch_index* index) {
+	free(index->slots);
+	free(index->hashes);
+}
+
+// hashes all keys into an open addressing table, duplicate keys point to their first occurrence
+static int create_batch_index(batch_index* index, const char** keys, int count, int* first) {
+	size_t size = 16;
+	while (size < (size_t)count * 2) size <<= 1;
+
+	index->slots = (int*)malloc(sizeof(int) * size);
+	index->hashes = (uint64_t*)malloc(sizeof(uint64_t) * count);
+	index->mask = size - 1;
+	index->key_hasher = get_default_hasher();
+
+	if (index->slots == NULL || index->hashes == NULL) {
+		delete_batch_index(index);
+		return -1;
+	}
+
+	memset(index->slots, -1, sizeof(int) * size);
+
+	int unique = 0;
+
+	int i;
+	for (i = 0; i < count; i++) {
+		uint64_t hash = hash_key_with(&index->key_hasher, keys[i], strlen(keys[i]));
+		size_t slot = hash & index->mask;
+
+		index->hashes[i] = hash;
+		first[i] = i;
+
+		while (index->slots[slot] != -1) {
+			int other = index->slots[slot];
+
+			if (index->hashes[other] == hash && strcmp(keys[other], keys[i]) == 0) {
+				first[i] = other;
+				break;
+			}
+
+			slot = (slot + 1) & index->mask;
+		}
+
+		if (first[i] == i) {
+			index->slots[slot] = i;
+			unique++;
+		}
+	}
+
+	return unique;
+}
+
+static int find_in_batch_index(const batch_index* index, const char** keys, const char* key) {
+	uint64_t hash = hash_key_with(&index->key_hasher, key, strlen(key));
+	size_t slot = hash & index->mask;
+
+	while (index->slots[slot] != -1) {
+		int i = index->slots[slot];
+
+		if (index->hashes[i] == hash && strcmp(keys[i], key) == 0) return i;
+
+		slot = (slot + 1) & index->mask;
+	}
+
+	return -1;
+}
+
+// resolves all keys in one walk, *last receives the last entry if the walk reached the end
+static int resolve_batch(entry* dictionary, const char** keys, int count, entry** entries, int* first, entry** last) {
+	batch_index index;
+	int unique = create_batch_index(&index, keys, count, first);
+
+	if (unique == -1) return -1;
+
+	int i;
+	for (i = 0; i < count; i++) {
+		entries[i] = NULL;
+	}
+
+	entry* iterator = dictionary;
+	int resolved = 0;
+
+	*last = NULL;
+	PREFETCH(iterator->key);
+
+	while (iterator != NULL && resolved < unique) {
+		entry* next = iterator->next;
+
+		// overlap the loads of the following entries with the comparison of the current one
+		if (next != NULL) {
+			PREFETCH(next->next);
+			PREFETCH(next->key);
+		}
+
+		int match = find_in_batch_index(&index, keys, iterator->key);
+
+		if (match != -1) {
+			entries[match] = iterator;
+			resolved++;
+		}
+
+		if (next == NULL) *last = iterator;
+		iterator = next;
+	}
+
+	int found = 0;
+
+	for (i = 0; i < count; i++) {
+		entries[i] = entries[first[i]];
+		if (entries[i] != NULL) found++;
+	}
+
+	delete_batch_index(&index);
+
+	return found;
+}
+
+int get_entries_batch(entry* dictionary, const char** keys, int count, entry** entries) {
+	if (dictionary == NULL || keys == NULL || count <= 0 || entries == NULL) return -1;
+
+	int* first = (int*)malloc(sizeof(int) * count);
+
+	if (first == NULL) return -1;
+
+	entry* last;
+	int found = resolve_batch(dictionary, keys, count, entries, first, &last);
+
+	free(first);
+
+	return found;
+}
+
+int add_entries_batch(entry* dictionary, const void** values, size_t value_size, const char** keys, int count, entry** entries) {
+	if (dictionary == NULL || values == NULL || value_size <= 0 || keys == NULL || count <= 0) return -1;
+
+	int* first = (int*)malloc(sizeof(int) * count);
+	entry** resolved = entries != NULL ? entries : (entry**)malloc(sizeof(entry*) * count);
+
+	if (first == NULL || resolved == NULL) {
+		free(first);
+		if (entries == NULL) free(resolved);
+		return -1;
+	}
+
+	entry* last;
+	int added = 0;
+
+	if (resolve_batch(dictionary, keys, count, resolved, first, &last) != -1) {
+		int i;
+		for (i = 0; i < count; i++) {
+			// later duplicates of a key update the entry created for its first occurrence
+			entry* e = resolved[first[i]];
+
+			if (e == NULL) {
+				e = create_dictionary(values[i], value_size, keys[i]);
+
+				if (e == NULL) break;
+
+				last->next = e;
+				last = e;
+			}
+			else {
+				void* value = malloc(value_size);
+
+				if (value == NULL) break;
+
+				memcpy(value, values[i], value_size);
+				free(e->value);
+				e->value = value;
+			}
+
+			resolved[i] = e;
+			added++;
+		}
+	}
+
+	free(first);
+	if (entries == NULL) free(resolved);
+
+	return added == count ? added : -1;
+}
+
 int get_number_of_entries(entry* dictionary) {
 	if (dictionary == NULL) return -1;
 
@@ -183,16 +378,376 @@ element* get_keys(entry* dictionary) {
 
 	element* list = create_list(dictionary->key, strlen(dictionary->key) + 1);
 
+	if (list == NULL) return NULL;
+
 	entry* iterator = dictionary;
+	element* last = list;
 
+	// append at the remembered tail instead of walking the list for every key
 	while (iterator->next != NULL) {
 		iterator = iterator->next;
-		add_element(list, iterator->key, strlen(iterator->key) + 1);
+		last->next = create_list(iterator->key, strlen(iterator->key) + 1);
+
+		if (last->next == NULL) {
+			delete_list(&list);
+			return NULL;
+		}
+
+		last = last->next;
 	}
 
 	return list;
 }
 
+int get_key_view(entry* dictionary, const char** keys, int capacity) {
+	if (dictionary == NULL || (keys == NULL && capacity > 0)) return -1;
+
+	entry* iterator = dictionary;
+	int counter = 0;
+
+	while (iterator != NULL) {
+		if (counter < capacity) keys[counter] = iterator->key;
+
+		iterator = iterator->next;
+		counter++;
+	}
+
+	return counter;
+}
+
+int get_entry_view(entry* dictionary, entry** entries, int capacity) {
+	if (dictionary == NULL || (entries == NULL && capacity > 0)) return -1;
+
+	entry* iterator = dictionary;
+	int counter = 0;
+
+	while (iterator != NULL) {
+		if (counter < capacity) entries[counter] = iterator;
+
+		iterator = iterator->next;
+		counter++;
+	}
+
+	return counter;
+}
+
+#define LOAD_CHUNK_SIZE (1 << 20)
+
+// open addressing index from keys to entries, used to resolve keys in bulk operations
+struct key_index {
+	entry** slots;
+	uint64_t* hashes;
+	size_t mask;
+	size_t used;
+	hasher key_hasher;
+};
+
+typedef struct key_index key_index;
+
+static int create_key_index(key_index* index, size_t expected) {
+	size_t size = 16;
+	while (size < expected * 2) size <<= 1;
+
+	index->slots = (entry**)calloc(size, sizeof(entry*));
+	index->hashes = (uint64_t*)malloc(sizeof(uint64_t) * size);
+	index->mask = size - 1;
+	index->used = 0;
+	index->key_hasher = get_default_hasher();
+
+	if (index->slots == NULL || index->hashes == NULL) {
+		free(index->slots);
+		free(index->hashes);
+		return -1;
+	}
+
+	return 0;
+}
+
+static void delete_key_index(key_index* index) {
+	free(index->slots);
+	free(index->hashes);
+}
+
+static int grow_key_index(key_index* index) {
+	key_index grown;
+
+	if (create_key_index(&grown, index->mask + 1) == -1) return -1;
+
+	size_t i;
+	for (i = 0; i <= index->mask; i++) {
+		if (index->slots[i] == NULL) continue;
+
+		size_t slot = index->hashes[i] & grown.mask;
+		while (grown.slots[slot] != NULL) slot = (slot + 1) & grown.mask;
+
+		grown.slots[slot] = index->slots[i];
+		grown.hashes[slot] = index->hashes[i];
+	}
+
+	grown.used = index->used;
+	grown.key_hasher = index->key_hasher;
+	delete_key_index(index);
+	*index = grown;
+
+	return 0;
+}
+
+// returns the slot holding key or the empty slot where it belongs
+static size_t find_key_slot(const key_index* index, const char* key, uint64_t hash) {
+	size_t slot = hash & index->mask;
+
+	while (index->slots[slot] != NULL) {
+		if (index->hashes[slot] == hash && strcmp(index->slots[slot]->key, key) == 0) break;
+
+		slot = (slot + 1) & index->mask;
+	}
+
+	return slot;
+}
+
+static entry* find_in_key_index(const key_index* index, const char* key) {
+	return index->slots[find_key_slot(index, key, hash_key_with(&index->key_hasher, key, strlen(key)))];
+}
+
+static int add_to_key_index(key_index* index, entry* e, size_t slot, uint64_t hash) {
+	index->slots[slot] = e;
+	index->hashes[slot] = hash;
+	index->used++;
+
+	if (index->used * 2 > index->mask) return grow_key_index(index);
+
+	return 0;
+}
+
+// indexes every entry of a dictionary, *last receives its last entry
+static int index_dictionary(key_index* index, entry* dictionary, entry** last) {
+	entry* iterator = dictionary;
+
+	while (iterator != NULL) {
+		uint64_t hash = hash_key_with(&index->key_hasher, iterator->key, strlen(iterator->key));
+		size_t slot = find_key_slot(index, iterator->key, hash);
+
+		// like get_entry, the first of several equal keys wins
+		if (index->slots[slot] == NULL && add_to_key_index(index, iterator, slot, hash) == -1) return -1;
+
+		*last = iterator;
+		iterator = iterator->next;
+	}
+
+	return 0;
+}
+
+static int replace_value(entry* e, const void* value, size_t value_size) {
+	void* copy = malloc(value_size);
+
+	if (copy == NULL) return -1;
+
+	memcpy(copy, value, value_size);
+	free(e->value);
+	e->value = copy;
+
+	return 0;
+}
+
+// adds or updates one pair, key and value must be terminated
+static int load_pair(entry** dictionary, entry** last, key_index* index, const char* key, size_t key_len, const char* value, size_t value_len) {
+	uint64_t hash = hash_key_with(&index->key_hasher, key, key_len);
+	size_t slot = find_key_slot(index, key, hash);
+
+	if (index->slots[slot] != NULL) return replace_value(index->slots[slot], value, value_len + 1);
+
+	entry* e = create_dictionary(value, value_len + 1, key);
+
+	if (e == NULL) return -1;
+
+	if (*dictionary == NULL) *dictionary = e;
+	else (*last)->next = e;
+
+	*last = e;
+
+	return add_to_key_index(index, e, slot, hash);
+}
+
+static int load_line(entry** dictionary, entry** last, key_index* index, char* line, size_t length, char separator) {
+	if (length > 0 && line[length - 1] == '\r') length--;
+
+	char* split = (char*)memchr(line, separator, length);
+
+	if (split == NULL) return 0;
+
+	// the buffer always has room for one more byte, so lines are terminated in place
+	*split = '\0';
+	line[length] = '\0';
+
+	return load_pair(dictionary, last, index, line, (size_t)(split - line), split + 1, (size_t)(line + length - split - 1));
+}
+
+// reads the whole file chunk by chunk, *buffer may be replaced by a larger one
+static int load_file(FILE* file, char** buffer, size_t capacity, char separator, entry** dictionary, key_index* index) {
+	entry* last = NULL;
+	size_t filled = 0;
+
+	for (;;) {
+		size_t read = fread(*buffer + filled, 1, capacity - filled, file);
+
+		filled += read;
+
+		size_t start = 0;
+		char* newline;
+
+		while ((newline = (char*)memchr(*buffer + start, '\n', filled - start)) != NULL) {
+			size_t end = (size_t)(newline - *buffer);
+
+			if (load_line(dictionary, &last, index, *buffer + start, end - start, separator) == -1) return -1;
+			start = end + 1;
+		}
+
+		if (read == 0) {
+			if (ferror(file)) return -1;
+			if (start < filled) return load_line(dictionary, &last, index, *buffer + start, filled - start, separator);
+
+			return 0;
+		}
+
+		// keep the incomplete last line and make room for a line longer than the buffer
+		memmove(*buffer, *buffer + start, filled - start);
+		filled -= start;
+
+		if (filled == capacity) {
+			char* grown = (char*)realloc(*buffer, capacity * 2 + 1);
+
+			if (grown == NULL) return -1;
+
+			*buffer = grown;
+			capacity *= 2;
+		}
+	}
+}
+
+entry* load_dictionary_delimited(const char* path, char separator) {
+	if (path == NULL || separator == '\n' || separator == '\0') return NULL;
+
+	FILE* file = fopen(path, "rb");
+
+	if (file == NULL) return NULL;
+
+	char* buffer = (char*)malloc(LOAD_CHUNK_SIZE + 1);
+	entry* dictionary = NULL;
+	key_index index;
+
+	if (buffer != NULL && create_key_index(&index, 512) == 0) {
+		if (load_file(file, &buffer, LOAD_CHUNK_SIZE, separator, &dictionary, &index) == -1 && dictionary != NULL) {
+			delete_dictionary(&dictionary);
+		}
+
+		delete_key_index(&index);
+	}
+
+	free(buffer);
+	fclose(file);
+
+	return dictionary;
+}
+
+entry* merge_dictionaries(entry* destination, entry* source, size_t value_size, merge_policy policy, merge_combine combine) {
+	if (destination == NULL || source == NULL || value_size <= 0) return NULL;
+	if (policy == MERGE_COMBINE && combine == NULL) return NULL;
+
+	key_index index;
+	entry* last;
+
+	if (create_key_index(&index, (size_t)get_number_of_entries(destination) + (size_t)get_number_of_entries(source)) == -1) return NULL;
+
+	if (index_dictionary(&index, destination, &last) == -1) {
+		delete_key_index(&index);
+		return NULL;
+	}
+
+	entry* iterator = source;
+	int status = 0;
+
+	while (iterator != NULL && status == 0) {
+		entry* next = iterator->next;
+
+		if (next != NULL) PREFETCH(next->key);
+
+		uint64_t hash = hash_key_with(&index.key_hasher, iterator->key, strlen(iterator->key));
+		size_t slot = find_key_slot(&index, iterator->key, hash);
+		entry* e = index.slots[slot];
+
+		if (e == NULL) {
+			e = create_dictionary(iterator->value, value_size, iterator->key);
+
+			if (e == NULL) status = -1;
+			else {
+				last->next = e;
+				last = e;
+				status = add_to_key_index(&index, e, slot, hash);
+			}
+		}
+		else if (policy == MERGE_OVERWRITE) {
+			status = replace_value(e, iterator->value, value_size);
+		}
+		else if (policy == MERGE_COMBINE) {
+			combine(e->value, iterator->value, value_size);
+		}
+
+		iterator = next;
+	}
+
+	delete_key_index(&index);
+
+	return status == 0 ? destination : NULL;
+}
+
+// copies the entries of first whose key is (keep == 1) or is not (keep == 0) part of second
+static entry* filter_by_keys(entry* first, entry* second, size_t value_size, int keep) {
+	if (first == NULL || second == NULL || value_size <= 0) return NULL;
+
+	key_index index;
+	entry* last;
+
+	if (create_key_index(&index, (size_t)get_number_of_entries(second)) == -1) return NULL;
+
+	if (index_dictionary(&index, second, &last) == -1) {
+		delete_key_index(&index);
+		return NULL;
+	}
+
+	entry* result = NULL;
+	entry* iterator = first;
+
+	while (iterator != NULL) {
+		if ((find_in_key_index(&index, iterator->key) != NULL) == keep) {
+			entry* e = create_dictionary(iterator->value, value_size, iterator->key);
+
+			if (e == NULL) {
+				if (result != NULL) delete_dictionary(&result);
+				break;
+			}
+
+			if (result == NULL) result = e;
+			else last->next = e;
+
+			last = e;
+		}
+
+		iterator = iterator->next;
+	}
+
+	delete_key_index(&index);
+
+	return result;
+}
+
+entry* intersect_dictionaries(entry* first, entry* second, size_t value_size) {
+	return filter_by_keys(first, second, value_size, 1);
+}
+
+entry* difference_dictionaries(entry* first, entry* second, size_t value_size) {
+	return filter_by_keys(first, second, value_size, 0);
+}
+
 void print_dictionary(entry* dicionary) {
 	if (dicionary == NULL) return;
 
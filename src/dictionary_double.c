@@ -0,0 +1,215 @@
+/*
+MIT License
+
+Copyright (c) 2016 Julius Paffrath
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <dictionary_double.h>
+#include <hash.h>
+
+#include <string.h>
+#include <stdlib.h>
+
+#define INITIAL_BUCKET_COUNT 16
+
+static double_entry** get_bucket(double_dictionary* dictionary, uint64_t hash) {
+	return &dictionary->buckets[hash & (dictionary->bucket_count - 1)];
+}
+
+static double_entry* find_entry(double_dictionary* dictionary, uint64_t hash, const char* key) {
+	double_entry* iterator = *get_bucket(dictionary, hash);
+
+	while (iterator != NULL) {
+		if (iterator->hash == hash && strcmp(iterator->key, key) == 0) return iterator;
+		iterator = iterator->next;
+	}
+
+	return NULL;
+}
+
+static void grow_dictionary(double_dictionary* dictionary) {
+	size_t new_count = dictionary->bucket_count * 2;
+	double_entry** new_buckets = (double_entry**)calloc(new_count, sizeof(double_entry*));
+
+	if (new_buckets == NULL) return;
+
+	size_t i;
+	for (i = 0; i < dictionary->bucket_count; i++) {
+		double_entry* iterator = dictionary->buckets[i];
+
+		while (iterator != NULL) {
+			double_entry* next = iterator->next;
+			double_entry** bucket = &new_buckets[iterator->hash & (new_count - 1)];
+
+			iterator->next = *bucket;
+			*bucket = iterator;
+			iterator = next;
+		}
+	}
+
+	free(dictionary->buckets);
+	dictionary->buckets = new_buckets;
+	dictionary->bucket_count = new_count;
+}
+
+/* Returns the entry for a key, creating it with the given value if it is missing.
+   *created tells the caller whether the value still has to be applied. */
+static double_entry* find_or_create_entry(double_dictionary* dictionary, double value, const char* key, int* created) {
+	size_t length = strlen(key);
+	uint64_t hash = hash_key_with(&dictionary->key_hasher, key, length);
+	double_entry* e = find_entry(dictionary, hash, key);
+
+	*created = 0;
+	if (e != NULL) return e;
+
+	e = (double_entry*)malloc(sizeof(double_entry) + length + 1);
+	if (e == NULL) return NULL;
+
+	memcpy(e->key, key, length + 1);
+	e->hash = hash;
+	e->value = value;
+
+	double_entry** bucket = get_bucket(dictionary, hash);
+	e->next = *bucket;
+	*bucket = e;
+
+	dictionary->entry_count++;
+	if ((size_t)dictionary->entry_count > dictionary->bucket_count) grow_dictionary(dictionary);
+
+	*created = 1;
+	return e;
+}
+
+double_dictionary* create_double_dictionary(void) {
+	double_dictionary* dictionary = (double_dictionary*)malloc(sizeof(double_dictionary));
+
+	if (dictionary == NULL) return NULL;
+
+	dictionary->buckets = (double_entry**)calloc(INITIAL_BUCKET_COUNT, sizeof(double_entry*));
+	if (dictionary->buckets == NULL) {
+		free(dictionary);
+		return NULL;
+	}
+
+	dictionary->bucket_count = INITIAL_BUCKET_COUNT;
+	dictionary->entry_count = 0;
+	dictionary->key_hasher = get_default_hasher();
+
+	return dictionary;
+}
+
+void delete_double_dictionary(double_dictionary** dictionary) {
+	if (dictionary == NULL || *dictionary == NULL) return;
+
+	size_t i;
+	for (i = 0; i < (*dictionary)->bucket_count; i++) {
+		double_entry* iterator = (*dictionary)->buckets[i];
+
+		while (iterator != NULL) {
+			double_entry* next = iterator->next;
+			free(iterator);
+			iterator = next;
+		}
+	}
+
+	free((*dictionary)->buckets);
+	free(*dictionary);
+	*dictionary = NULL;
+}
+
+double_entry* add_double_entry(double_dictionary* dictionary, double value, const char* key) {
+	if (dictionary == NULL || key == NULL) return NULL;
+
+	int created;
+	double_entry* e = find_or_create_entry(dictionary, value, key, &created);
+
+	if (e != NULL) e->value = value;
+
+	return e;
+}
+
+double_entry* add_to_double_entry(double_dictionary* dictionary, double delta, const char* key) {
+	if (dictionary == NULL || key == NULL) return NULL;
+
+	int created;
+	double_entry* e = find_or_create_entry(dictionary, delta, key, &created);
+
+	if (e != NULL && !created) e->value += delta;
+
+	return e;
+}
+
+double_entry* increment_double_entry(double_dictionary* dictionary, const char* key) {
+	return add_to_double_entry(dictionary, 1, key);
+}
+
+double atomic_add_to_double_entry(double_entry* e, double delta) {
+	double expected;
+	double desired;
+
+	__atomic_load(&e->value, &expected, __ATOMIC_RELAXED);
+
+	do {
+		desired = expected + delta;
+	} while (!__atomic_compare_exchange(&e->value, &expected, &desired, 0, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+
+	return desired;
+}
+
+double_dictionary* remove_double_entry(double_dictionary* dictionary, const char* key) {
+	if (dictionary == NULL || key == NULL) return NULL;
+
+	uint64_t hash = hash_key_with(&dictionary->key_hasher, key, strlen(key));
+	double_entry** link = get_bucket(dictionary, hash);
+
+	while (*link != NULL) {
+		double_entry* e = *link;
+
+		if (e->hash == hash && strcmp(e->key, key) == 0) {
+			*link = e->next;
+			free(e);
+			dictionary->entry_count--;
+			return dictionary;
+		}
+
+		link = &e->next;
+	}
+
+	return NULL;
+}
+
+double_entry* get_double_entry(double_dictionary* dictionary, const char* key) {
+	if (dictionary == NULL || key == NULL) return NULL;
+
+	return find_entry(dictionary, hash_key_with(&dictionary->key_hasher, key, strlen(key)), key);
+}
+
+int get_number_of_double_entries(double_dictionary* dictionary) {
+	if (dictionary == NULL) return -1;
+
+	return dictionary->entry_count;
+}
+
+int contains_double_key(double_dictionary* dictionary, const char* key) {
+	if (dictionary == NULL || key == NULL) return -1;
+
+	return get_double_entry(dictionary, key) != NULL;
+}
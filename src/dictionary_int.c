@@ -0,0 +1,206 @@
+/*
+MIT License
+
+Copyright (c) 2016 Julius Paffrath
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <dictionary_int.h>
+#include <hash.h>
+
+#include <string.h>
+#include <stdlib.h>
+
+#define INITIAL_BUCKET_COUNT 16
+
+static int_entry** get_bucket(int_dictionary* dictionary, uint64_t hash) {
+	return &dictionary->buckets[hash & (dictionary->bucket_count - 1)];
+}
+
+static int_entry* find_entry(int_dictionary* dictionary, uint64_t hash, const char* key) {
+	int_entry* iterator = *get_bucket(dictionary, hash);
+
+	while (iterator != NULL) {
+		if (iterator->hash == hash && strcmp(iterator->key, key) == 0) return iterator;
+		iterator = iterator->next;
+	}
+
+	return NULL;
+}
+
+static void grow_dictionary(int_dictionary* dictionary) {
+	size_t new_count = dictionary->bucket_count * 2;
+	int_entry** new_buckets = (int_entry**)calloc(new_count, sizeof(int_entry*));
+
+	if (new_buckets == NULL) return;
+
+	size_t i;
+	for (i = 0; i < dictionary->bucket_count; i++) {
+		int_entry* iterator = dictionary->buckets[i];
+
+		while (iterator != NULL) {
+			int_entry* next = iterator->next;
+			int_entry** bucket = &new_buckets[iterator->hash & (new_count - 1)];
+
+			iterator->next = *bucket;
+			*bucket = iterator;
+			iterator = next;
+		}
+	}
+
+	free(dictionary->buckets);
+	dictionary->buckets = new_buckets;
+	dictionary->bucket_count = new_count;
+}
+
+/* Returns the entry for a key, creating it with the given value if it is missing.
+   *created tells the caller whether the value still has to be applied. */
+static int_entry* find_or_create_entry(int_dictionary* dictionary, int value, const char* key, int* created) {
+	size_t length = strlen(key);
+	uint64_t hash = hash_key_with(&dictionary->key_hasher, key, length);
+	int_entry* e = find_entry(dictionary, hash, key);
+
+	*created = 0;
+	if (e != NULL) return e;
+
+	e = (int_entry*)malloc(sizeof(int_entry) + length + 1);
+	if (e == NULL) return NULL;
+
+	memcpy(e->key, key, length + 1);
+	e->hash = hash;
+	e->value = value;
+
+	int_entry** bucket = get_bucket(dictionary, hash);
+	e->next = *bucket;
+	*bucket = e;
+
+	dictionary->entry_count++;
+	if ((size_t)dictionary->entry_count > dictionary->bucket_count) grow_dictionary(dictionary);
+
+	*created = 1;
+	return e;
+}
+
+int_dictionary* create_int_dictionary(void) {
+	int_dictionary* dictionary = (int_dictionary*)malloc(sizeof(int_dictionary));
+
+	if (dictionary == NULL) return NULL;
+
+	dictionary->buckets = (int_entry**)calloc(INITIAL_BUCKET_COUNT, sizeof(int_entry*));
+	if (dictionary->buckets == NULL) {
+		free(dictionary);
+		return NULL;
+	}
+
+	dictionary->bucket_count = INITIAL_BUCKET_COUNT;
+	dictionary->entry_count = 0;
+	dictionary->key_hasher = get_default_hasher();
+
+	return dictionary;
+}
+
+void delete_int_dictionary(int_dictionary** dictionary) {
+	if (dictionary == NULL || *dictionary == NULL) return;
+
+	size_t i;
+	for (i = 0; i < (*dictionary)->bucket_count; i++) {
+		int_entry* iterator = (*dictionary)->buckets[i];
+
+		while (iterator != NULL) {
+			int_entry* next = iterator->next;
+			free(iterator);
+			iterator = next;
+		}
+	}
+
+	free((*dictionary)->buckets);
+	free(*dictionary);
+	*dictionary = NULL;
+}
+
+int_entry* add_int_entry(int_dictionary* dictionary, int value, const char* key) {
+	if (dictionary == NULL || key == NULL) return NULL;
+
+	int created;
+	int_entry* e = find_or_create_entry(dictionary, value, key, &created);
+
+	if (e != NULL) e->value = value;
+
+	return e;
+}
+
+int_entry* add_to_int_entry(int_dictionary* dictionary, int delta, const char* key) {
+	if (dictionary == NULL || key == NULL) return NULL;
+
+	int created;
+	int_entry* e = find_or_create_entry(dictionary, delta, key, &created);
+
+	if (e != NULL && !created) e->value += delta;
+
+	return e;
+}
+
+int_entry* increment_int_entry(int_dictionary* dictionary, const char* key) {
+	return add_to_int_entry(dictionary, 1, key);
+}
+
+int atomic_add_to_int_entry(int_entry* e, int delta) {
+	return __atomic_add_fetch(&e->value, delta, __ATOMIC_RELAXED);
+}
+
+int_dictionary* remove_int_entry(int_dictionary* dictionary, const char* key) {
+	if (dictionary == NULL || key == NULL) return NULL;
+
+	uint64_t hash = hash_key_with(&dictionary->key_hasher, key, strlen(key));
+	int_entry** link = get_bucket(dictionary, hash);
+
+	while (*link != NULL) {
+		int_entry* e = *link;
+
+		if (e->hash == hash && strcmp(e->key, key) == 0) {
+			*link = e->next;
+			free(e);
+			dictionary->entry_count--;
+			return dictionary;
+		}
+
+		link = &e->next;
+	}
+
+	return NULL;
+}
+
+int_entry* get_int_entry(int_dictionary* dictionary, const char* key) {
+	if (dictionary == NULL || key == NULL) return NULL;
+
+	return find_entry(dictionary, hash_key_with(&dictionary->key_hasher, key, strlen(key)), key);
+}
+
+int get_number_of_int_entries(int_dictionary* dictionary) {
+	if (dictionary == NULL) return -1;
+
+	return dictionary->entry_count;
+}
+
+int contains_int_key(int_dictionary* dictionary, const char* key) {
+	if (dictionary == NULL || key == NULL) return -1;
+
+	return get_int_entry(dictionary, key) != NULL;
+}
@@ -0,0 +1,284 @@
+/*
+MIT License
+
+Copyright (c) 2016 Julius Paffrath
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <double_column.h>
+#include <list_double.h>
+#include <simd.h>
+
+#include <string.h>
+#include <stdlib.h>
+#include <math.h>
+
+static int get_chunk_length(const double_column* column, int chunk) {
+	if (chunk < column->chunk_count - 1) return DOUBLE_COLUMN_CHUNK_SIZE;
+
+	return column->length - chunk * DOUBLE_COLUMN_CHUNK_SIZE;
+}
+
+static int add_chunk(double_column* column) {
+	if (column->chunk_count == column->chunk_capacity) {
+		int capacity = column->chunk_capacity == 0 ? 8 : column->chunk_capacity * 2;
+		double** grown = (double**)realloc(column->chunks, sizeof(double*) * capacity);
+
+		if (grown == NULL) return -1;
+
+		column->chunks = grown;
+		column->chunk_capacity = capacity;
+	}
+
+	double* chunk = (double*)aligned_alloc(DOUBLE_COLUMN_ALIGNMENT, sizeof(double) * DOUBLE_COLUMN_CHUNK_SIZE);
+
+	if (chunk == NULL) return -1;
+
+	column->chunks[column->chunk_count++] = chunk;
+
+	return 0;
+}
+
+double_column* create_double_column(void) {
+	double_column* column = (double_column*)malloc(sizeof(double_column));
+
+	if (column == NULL) return NULL;
+
+	column->chunks = NULL;
+	column->chunk_count = 0;
+	column->chunk_capacity = 0;
+	column->length = 0;
+
+	return column;
+}
+
+double_column* create_double_column_from_list(element* list) {
+	double_column* column = create_double_column();
+
+	if (column == NULL) return NULL;
+
+	element* iterator;
+	for (iterator = list; iterator != NULL; iterator = iterator->next) {
+		if (iterator->value == NULL) continue;
+
+		if (add_double_value(column, *(double*)iterator->value) != 0) {
+			delete_double_column(&column);
+			return NULL;
+		}
+	}
+
+	return column;
+}
+
+void delete_double_column(double_column** column) {
+	if (column == NULL || *column == NULL) return;
+
+	int i;
+	for (i = 0; i < (*column)->chunk_count; i++) {
+		free((*column)->chunks[i]);
+	}
+
+	free((*column)->chunks);
+	free(*column);
+
+	*column = NULL;
+}
+
+element* double_column_to_list(const double_column* column) {
+	if (column == NULL || column->length == 0) return NULL;
+
+	element* list = NULL;
+	element* tail = NULL;
+
+	int chunk;
+	for (chunk = 0; chunk < column->chunk_count; chunk++) {
+		int length = get_chunk_length(column, chunk);
+
+		int i;
+		for (i = 0; i < length; i++) {
+			element* e = create_double_list(column->chunks[chunk][i]);
+
+			if (e == NULL) {
+				delete_list(&list);
+				return NULL;
+			}
+
+			if (tail == NULL) list = e;
+			else tail->next = e;
+
+			tail = e;
+		}
+	}
+
+	return list;
+}
+
+int add_double_value(double_column* column, double value) {
+	return add_double_values(column, &value, 1);
+}
+
+int add_double_values(double_column* column, const double* values, int count) {
+	if (column == NULL || values == NULL || count < 0) return -1;
+
+	while (count > 0) {
+		int offset = column->length % DOUBLE_COLUMN_CHUNK_SIZE;
+
+		if (offset == 0 && column->length == column->chunk_count * DOUBLE_COLUMN_CHUNK_SIZE && add_chunk(column) != 0) {
+			return -1;
+		}
+
+		int space = DOUBLE_COLUMN_CHUNK_SIZE - offset;
+		int copied = count < space ? count : space;
+
+		memcpy(column->chunks[column->chunk_count - 1] + offset, values, sizeof(double) * copied);
+
+		column->length += copied;
+		values += copied;
+		count -= copied;
+	}
+
+	return 0;
+}
+
+int get_double_value_at_index(const double_column* column, int index, double* value) {
+	if (column == NULL || index < 0 || index >= column->length || value == NULL) return -1;
+
+	*value = column->chunks[index / DOUBLE_COLUMN_CHUNK_SIZE][index % DOUBLE_COLUMN_CHUNK_SIZE];
+
+	return 0;
+}
+
+int set_double_value_at_index(double_column* column, double value, int index) {
+	if (column == NULL || index < 0 || index >= column->length) return -1;
+
+	column->chunks[index / DOUBLE_COLUMN_CHUNK_SIZE][index % DOUBLE_COLUMN_CHUNK_SIZE] = value;
+
+	return 0;
+}
+
+int get_length_of_double_column(const double_column* column) {
+	if (column == NULL) return -1;
+
+	return column->length;
+}
+
+double get_sum_of_double_column(const double_column* column) {
+	if (column == NULL) return 0.0;
+
+	double sum = 0.0;
+
+	int chunk;
+	for (chunk = 0; chunk < column->chunk_count; chunk++) {
+		sum += get_sum_of_double_array(column->chunks[chunk], get_chunk_length(column, chunk));
+	}
+
+	return sum;
+}
+
+int get_mean_of_double_column(const double_column* column, double* result) {
+	if (column == NULL || column->length == 0 || result == NULL) return -1;
+
+	*result = get_sum_of_double_column(column) / column->length;
+
+	return 0;
+}
+
+int get_variance_of_double_column(const double_column* column, double* result) {
+	double mean;
+
+	if (result == NULL || get_mean_of_double_column(column, &mean) != 0) return -1;
+
+	double sum = 0.0;
+
+	int chunk;
+	for (chunk = 0; chunk < column->chunk_count; chunk++) {
+		sum += get_squared_deviation_of_double_array(column->chunks[chunk], get_chunk_length(column, chunk), mean);
+	}
+
+	*result = sum / column->length;
+
+	return 0;
+}
+
+int get_min_of_double_column(const double_column* column, double* result) {
+	if (column == NULL || column->length == 0 || result == NULL) return -1;
+
+	double min = column->chunks[0][0];
+
+	int chunk;
+	for (chunk = 0; chunk < column->chunk_count; chunk++) {
+		double chunk_min;
+		get_min_of_double_array(column->chunks[chunk], get_chunk_length(column, chunk), &chunk_min);
+
+		if (chunk_min < min) min = chunk_min;
+	}
+
+	*result = min;
+
+	return 0;
+}
+
+int get_max_of_double_column(const double_column* column, double* result) {
+	if (column == NULL || column->length == 0 || result == NULL) return -1;
+
+	double max = column->chunks[0][0];
+
+	int chunk;
+	for (chunk = 0; chunk < column->chunk_count; chunk++) {
+		double chunk_max;
+		get_max_of_double_array(column->chunks[chunk], get_chunk_length(column, chunk), &chunk_max);
+
+		if (chunk_max > max) max = chunk_max;
+	}
+
+	*result = max;
+
+	return 0;
+}
+
+int get_dot_product_of_double_columns(const double_column* first, const double_column* second, double* result) {
+	if (first == NULL || second == NULL || first->length != second->length || result == NULL) return -1;
+
+	double sum = 0.0;
+
+	// both columns split their values at the same indices
+	int chunk;
+	for (chunk = 0; chunk < first->chunk_count; chunk++) {
+		sum += get_dot_product_of_double_arrays(first->chunks[chunk], second->chunks[chunk], get_chunk_length(first, chunk));
+	}
+
+	*result = sum;
+
+	return 0;
+}
+
+int get_histogram_of_double_column(const double_column* column, double low, double high, int bins, int* counts) {
+	if (column == NULL || !(high > low) || bins <= 0 || counts == NULL) return -1;
+	if (!isfinite(high - low) || !isfinite(bins / (high - low))) return -1;
+
+	memset(counts, 0, sizeof(int) * bins);
+
+	int chunk;
+	for (chunk = 0; chunk < column->chunk_count; chunk++) {
+		add_double_array_to_histogram(column->chunks[chunk], get_chunk_length(column, chunk), low, high, bins, counts);
+	}
+
+	return 0;
+}
@@ -0,0 +1,214 @@
+/*
+MIT License
+
+Copyright (c) 2016 Julius Paffrath
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "epoch.h"
+
+#include <stdlib.h>
+#include <pthread.h>
+#include <sched.h>
+
+#define SLOT_ACTIVE 1
+#define NO_SLOT (-1)
+
+static pthread_mutex_t registry_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_once_t registry_once = PTHREAD_ONCE_INIT;
+static pthread_key_t registry_key;
+
+static int free_slots[EPOCH_MAX_THREADS];
+static int free_slot_count = 0;
+static atomic_int next_slot = 0;
+
+static _Thread_local int thread_slot = NO_SLOT;
+
+static void release_thread_slot(void* value) {
+	(void)value;
+
+	pthread_mutex_lock(&registry_lock);
+	free_slots[free_slot_count++] = thread_slot;
+	pthread_mutex_unlock(&registry_lock);
+
+	thread_slot = NO_SLOT;
+}
+
+static void create_registry(void) {
+	pthread_key_create(&registry_key, release_thread_slot);
+}
+
+static int get_thread_slot(void) {
+	if (thread_slot != NO_SLOT) return thread_slot;
+
+	pthread_once(&registry_once, create_registry);
+	pthread_mutex_lock(&registry_lock);
+
+	if (free_slot_count > 0) {
+		thread_slot = free_slots[--free_slot_count];
+	}
+	else if (atomic_load(&next_slot) < EPOCH_MAX_THREADS) {
+		thread_slot = atomic_fetch_add(&next_slot, 1);
+	}
+
+	pthread_mutex_unlock(&registry_lock);
+
+	// a non NULL value is required for the destructor to run on thread exit
+	if (thread_slot != NO_SLOT) pthread_setspecific(registry_key, &thread_slot);
+
+	return thread_slot;
+}
+
+epoch_domain* create_epoch_domain(void) {
+	epoch_domain* domain = (epoch_domain*)aligned_alloc(_Alignof(epoch_domain), sizeof(epoch_domain));
+
+	if (domain == NULL) return NULL;
+
+	atomic_init(&domain->global_epoch, 0);
+	atomic_init(&domain->overflow_readers, 0);
+
+	int i;
+	for (i = 0; i < EPOCH_MAX_THREADS; i++) {
+		atomic_init(&domain->slots[i].epoch, 0);
+	}
+
+	for (i = 0; i < 3; i++) {
+		domain->retired[i] = NULL;
+		domain->retired_count[i] = 0;
+		domain->retired_capacity[i] = 0;
+	}
+
+	return domain;
+}
+
+static void free_retired(epoch_domain* domain, int index) {
+	size_t i;
+	for (i = 0; i < domain->retired_count[index]; i++) {
+		epoch_retired* r = &domain->retired[index][i];
+		r->free_callback(r->pointer);
+	}
+
+	domain->retired_count[index] = 0;
+}
+
+void delete_epoch_domain(epoch_domain** domain) {
+	if (*domain == NULL) return;
+
+	epoch_domain* del = *domain;
+
+	int i;
+	for (i = 0; i < 3; i++) {
+		free_retired(del, i);
+		free(del->retired[i]);
+	}
+
+	free(del);
+
+	*domain = NULL;
+}
+
+int enter_epoch(epoch_domain* domain) {
+	int slot = get_thread_slot();
+
+	if (slot == NO_SLOT) {
+		// more threads than slots: fall back to a shared counter which blocks reclamation
+		atomic_fetch_add(&domain->overflow_readers, 1);
+		return NO_SLOT;
+	}
+
+	uint_fast64_t epoch = atomic_load_explicit(&domain->global_epoch, memory_order_relaxed);
+	atomic_store_explicit(&domain->slots[slot].epoch, (epoch << 1) | SLOT_ACTIVE, memory_order_relaxed);
+	atomic_thread_fence(memory_order_seq_cst);
+
+	return slot;
+}
+
+void leave_epoch(epoch_domain* domain, int slot) {
+	if (slot == NO_SLOT) {
+		atomic_fetch_sub_explicit(&domain->overflow_readers, 1, memory_order_release);
+		return;
+	}
+
+	atomic_store_explicit(&domain->slots[slot].epoch, 0, memory_order_release);
+}
+
+static int try_advance(epoch_domain* domain) {
+	atomic_thread_fence(memory_order_seq_cst);
+
+	if (atomic_load_explicit(&domain->overflow_readers, memory_order_acquire) != 0) return 0;
+
+	uint_fast64_t epoch = atomic_load_explicit(&domain->global_epoch, memory_order_relaxed);
+	uint_fast64_t current = (epoch << 1) | SLOT_ACTIVE;
+
+	int limit = atomic_load_explicit(&next_slot, memory_order_acquire);
+
+	int i;
+	for (i = 0; i < limit; i++) {
+		uint_fast64_t value = atomic_load_explicit(&domain->slots[i].epoch, memory_order_acquire);
+		if (value != 0 && value != current) return 0;
+	}
+
+	atomic_store_explicit(&domain->global_epoch, epoch + 1, memory_order_release);
+
+	// everything retired two epochs ago is unreachable for all readers now
+	free_retired(domain, (int)((epoch + 2) % 3));
+
+	return 1;
+}
+
+int retire_epoch(epoch_domain* domain, void* pointer, void (*free_callback)(void* pointer)) {
+	int index = (int)(atomic_load_explicit(&domain->global_epoch, memory_order_relaxed) % 3);
+
+	if (domain->retired_count[index] == domain->retired_capacity[index]) {
+		size_t capacity = domain->retired_capacity[index] == 0 ? 16 : domain->retired_capacity[index] * 2;
+		epoch_retired* retired = (epoch_retired*)realloc(domain->retired[index], capacity * sizeof(epoch_retired));
+
+		if (retired == NULL) {
+			// no memory for bookkeeping: wait for all readers and release immediately
+			synchronize_epoch(domain);
+			free_callback(pointer);
+			return 0;
+		}
+
+		domain->retired[index] = retired;
+		domain->retired_capacity[index] = capacity;
+	}
+
+	domain->retired[index][domain->retired_count[index]].pointer = pointer;
+	domain->retired[index][domain->retired_count[index]].free_callback = free_callback;
+	domain->retired_count[index]++;
+
+	try_advance(domain);
+
+	return 0;
+}
+
+void synchronize_epoch(epoch_domain* domain) {
+	int advanced = 0;
+
+	while (advanced < 3) {
+		if (try_advance(domain)) {
+			advanced++;
+		}
+		else {
+			sched_yield();
+		}
+	}
+}
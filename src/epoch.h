@@ -0,0 +1,77 @@
+/*
+MIT License
+
+Copyright (c) 2016 Julius Paffrath
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef LIBC_EPOCH
+#define LIBC_EPOCH
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdatomic.h>
+
+/*
+* Epoch based memory reclamation used by the lock-free containers.
+*
+* Readers announce the epoch they are running in by writing to a slot
+* owned by their thread only, so entering and leaving a critical section
+* never writes to a shared cache line. Writers are expected to be
+* serialized by the caller. Memory retired by a writer is released once
+* every reader has left the epoch the memory was unlinked in.
+*/
+
+#define EPOCH_MAX_THREADS 256
+
+struct epoch_slot {
+	_Alignas(64) atomic_uint_fast64_t epoch;
+};
+
+typedef struct epoch_slot epoch_slot;
+
+struct epoch_retired {
+	void* pointer;
+	void (*free_callback)(void* pointer);
+};
+
+typedef struct epoch_retired epoch_retired;
+
+struct epoch_domain {
+	_Alignas(64) atomic_uint_fast64_t global_epoch;
+	_Alignas(64) atomic_int overflow_readers;
+	epoch_slot slots[EPOCH_MAX_THREADS];
+	epoch_retired* retired[3];
+	size_t retired_count[3];
+	size_t retired_capacity[3];
+};
+
+typedef struct epoch_domain epoch_domain;
+
+epoch_domain* create_epoch_domain(void);
+void delete_epoch_domain(epoch_domain** domain);
+
+int enter_epoch(epoch_domain* domain);
+void leave_epoch(epoch_domain* domain, int slot);
+
+int retire_epoch(epoch_domain* domain, void* pointer, void (*free_callback)(void* pointer));
+void synchronize_epoch(epoch_domain* domain);
+
+#endif
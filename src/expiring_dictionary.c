@@ -0,0 +1,357 @@
+/*
+MIT License
+
+Copyright (c) 2016 Julius Paffrath
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <expiring_dictionary.h>
+#include <hash.h>
+
+#include <string.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define INITIAL_BUCKET_COUNT 16
+#define WHEEL_BITS 6
+#define WHEEL_MASK (EXPIRING_WHEEL_SLOTS - 1)
+#define WHEEL_SPAN (1ULL << (WHEEL_BITS * EXPIRING_WHEEL_LEVELS))
+
+/* number of expired entries reaped on every insertion */
+#define REAP_BUDGET 8
+
+static uint64_t monotonic_clock(void* user_data) {
+	(void)user_data;
+
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	return (uint64_t)now.tv_sec * 1000 + (uint64_t)now.tv_nsec / 1000000;
+}
+
+static expiring_entry** get_bucket(expiring_dictionary* dictionary, uint64_t hash) {
+	return &dictionary->buckets[hash & (dictionary->bucket_count - 1)];
+}
+
+static expiring_entry* find_entry(expiring_dictionary* dictionary, uint64_t hash, const char* key) {
+	expiring_entry* iterator = *get_bucket(dictionary, hash);
+
+	while (iterator != NULL) {
+		if (iterator->hash == hash && strcmp(iterator->key, key) == 0) return iterator;
+		iterator = iterator->chain;
+	}
+
+	return NULL;
+}
+
+static void grow_dictionary(expiring_dictionary* dictionary) {
+	size_t new_count = dictionary->bucket_count * 2;
+	expiring_entry** new_buckets = (expiring_entry**)calloc(new_count, sizeof(expiring_entry*));
+
+	if (new_buckets == NULL) return;
+
+	size_t i;
+	for (i = 0; i < dictionary->bucket_count; i++) {
+		expiring_entry* iterator = dictionary->buckets[i];
+
+		while (iterator != NULL) {
+			expiring_entry* next = iterator->chain;
+			expiring_entry** bucket = &new_buckets[iterator->hash & (new_count - 1)];
+
+			iterator->chain = *bucket;
+			*bucket = iterator;
+			iterator = next;
+		}
+	}
+
+	free(dictionary->buckets);
+	dictionary->buckets = new_buckets;
+	dictionary->bucket_count = new_count;
+}
+
+/* Puts an entry into the wheel relative to base, the first tick which has not been processed. */
+static void schedule_entry(expiring_dictionary* dictionary, expiring_entry* e, uint64_t base) {
+	uint64_t deadline = e->deadline < base ? base : e->deadline;
+	uint64_t delta = deadline - base;
+
+	/* entries beyond the wheel are parked in the last level and rescheduled on cascade */
+	if (delta >= WHEEL_SPAN) deadline = base + WHEEL_SPAN - 1;
+
+	unsigned level = 0;
+	while (level < EXPIRING_WHEEL_LEVELS - 1 && delta >= (1ULL << (WHEEL_BITS * (level + 1)))) level++;
+
+	unsigned slot = (unsigned)(deadline >> (WHEEL_BITS * level)) & WHEEL_MASK;
+	expiring_entry** head = &dictionary->wheel[level][slot];
+
+	e->level = (unsigned char)level;
+	e->slot = (unsigned char)slot;
+	e->prev = NULL;
+	e->next = *head;
+
+	if (*head != NULL) (*head)->prev = e;
+	*head = e;
+
+	dictionary->occupied[level] |= 1ULL << slot;
+}
+
+static void unschedule_entry(expiring_dictionary* dictionary, expiring_entry* e) {
+	if (e->prev != NULL) e->prev->next = e->next;
+	else dictionary->wheel[e->level][e->slot] = e->next;
+
+	if (e->next != NULL) e->next->prev = e->prev;
+
+	if (dictionary->wheel[e->level][e->slot] == NULL) dictionary->occupied[e->level] &= ~(1ULL << e->slot);
+}
+
+static void free_entry(expiring_entry* e) {
+	free(e->value);
+	free(e->key);
+	free(e);
+}
+
+static void drop_entry(expiring_dictionary* dictionary, expiring_entry* e) {
+	expiring_entry** link = get_bucket(dictionary, e->hash);
+
+	while (*link != e) link = &(*link)->chain;
+	*link = e->chain;
+
+	unschedule_entry(dictionary, e);
+	dictionary->entry_count--;
+	free_entry(e);
+}
+
+/* Moves the entries of the higher level slots which become due at tick down the wheel. */
+static void cascade(expiring_dictionary* dictionary, uint64_t tick) {
+	unsigned level;
+	for (level = 1; level < EXPIRING_WHEEL_LEVELS; level++) {
+		unsigned slot = (unsigned)(tick >> (WHEEL_BITS * level)) & WHEEL_MASK;
+		expiring_entry* iterator = dictionary->wheel[level][slot];
+
+		dictionary->wheel[level][slot] = NULL;
+		dictionary->occupied[level] &= ~(1ULL << slot);
+
+		while (iterator != NULL) {
+			expiring_entry* next = iterator->next;
+			schedule_entry(dictionary, iterator, tick);
+			iterator = next;
+		}
+
+		if (slot != 0) break;
+	}
+}
+
+static int is_wheel_empty(expiring_dictionary* dictionary) {
+	unsigned level;
+	for (level = 0; level < EXPIRING_WHEEL_LEVELS; level++) {
+		if (dictionary->occupied[level] != 0) return 0;
+	}
+
+	return 1;
+}
+
+/* Advances the wheel to now and reaps at most budget entries, 0 meaning no limit. */
+static int advance_wheel(expiring_dictionary* dictionary, uint64_t now, int budget) {
+	int reaped = 0;
+
+	while (dictionary->wheel_time < now) {
+		if (is_wheel_empty(dictionary)) {
+			dictionary->wheel_time = now;
+			break;
+		}
+
+		uint64_t tick = dictionary->wheel_time + 1;
+		unsigned slot = (unsigned)tick & WHEEL_MASK;
+
+		if (slot == 0) {
+			cascade(dictionary, tick);
+		}
+		else if ((dictionary->occupied[0] >> slot) == 0) {
+			/* nothing left in this rotation of the first level */
+			uint64_t last = tick | WHEEL_MASK;
+			dictionary->wheel_time = last < now ? last : now;
+			continue;
+		}
+
+		while (dictionary->wheel[0][slot] != NULL) {
+			if (budget > 0 && reaped == budget) return reaped;
+
+			drop_entry(dictionary, dictionary->wheel[0][slot]);
+			reaped++;
+		}
+
+		dictionary->wheel_time = tick;
+	}
+
+	return reaped;
+}
+
+static int is_expired(expiring_entry* e, uint64_t now) {
+	return e->deadline <= now;
+}
+
+expiring_dictionary* create_expiring_dictionary(expiring_clock clock, void* user_data) {
+	expiring_dictionary* dictionary = (expiring_dictionary*)calloc(1, sizeof(expiring_dictionary));
+
+	if (dictionary == NULL) return NULL;
+
+	dictionary->buckets = (expiring_entry**)calloc(INITIAL_BUCKET_COUNT, sizeof(expiring_entry*));
+	if (dictionary->buckets == NULL) {
+		free(dictionary);
+		return NULL;
+	}
+
+	dictionary->bucket_count = INITIAL_BUCKET_COUNT;
+	dictionary->key_hasher = get_default_hasher();
+	dictionary->clock = clock != NULL ? clock : monotonic_clock;
+	dictionary->user_data = user_data;
+	dictionary->wheel_time = dictionary->clock(user_data);
+
+	return dictionary;
+}
+
+void delete_expiring_dictionary(expiring_dictionary** dictionary) {
+	if (dictionary == NULL || *dictionary == NULL) return;
+
+	size_t i;
+	for (i = 0; i < (*dictionary)->bucket_count; i++) {
+		expiring_entry* iterator = (*dictionary)->buckets[i];
+
+		while (iterator != NULL) {
+			expiring_entry* next = iterator->chain;
+			free_entry(iterator);
+			iterator = next;
+		}
+	}
+
+	free((*dictionary)->buckets);
+	free(*dictionary);
+	*dictionary = NULL;
+}
+
+expiring_entry* add_expiring_entry(expiring_dictionary* dictionary, const void* value, size_t value_size, const char* key, uint64_t ttl) {
+	if (dictionary == NULL || value == NULL || value_size <= 0 || key == NULL) return NULL;
+
+	uint64_t now = dictionary->clock(dictionary->user_data);
+	advance_wheel(dictionary, now, REAP_BUDGET);
+
+	size_t key_length = strlen(key);
+	uint64_t hash = hash_key_with(&dictionary->key_hasher, key, key_length);
+	expiring_entry* e = find_entry(dictionary, hash, key);
+
+	void* copy = malloc(value_size);
+	if (copy == NULL) return NULL;
+	memcpy(copy, value, value_size);
+
+	if (e != NULL) {
+		unschedule_entry(dictionary, e);
+		free(e->value);
+	}
+	else {
+		e = (expiring_entry*)malloc(sizeof(expiring_entry));
+		char* key_copy = (char*)malloc(key_length + 1);
+
+		if (e == NULL || key_copy == NULL) {
+			free(e);
+			free(key_copy);
+			free(copy);
+			return NULL;
+		}
+
+		memcpy(key_copy, key, key_length + 1);
+		e->key = key_copy;
+		e->hash = hash;
+
+		expiring_entry** bucket = get_bucket(dictionary, hash);
+		e->chain = *bucket;
+		*bucket = e;
+
+		dictionary->entry_count++;
+		if ((size_t)dictionary->entry_count > dictionary->bucket_count) grow_dictionary(dictionary);
+	}
+
+	e->value = copy;
+	e->value_size = value_size;
+	e->deadline = ttl > UINT64_MAX - now ? UINT64_MAX : now + ttl;
+	schedule_entry(dictionary, e, dictionary->wheel_time + 1);
+
+	return e;
+}
+
+expiring_entry* refresh_expiring_entry(expiring_dictionary* dictionary, const char* key, uint64_t ttl) {
+	expiring_entry* e = get_expiring_entry(dictionary, key);
+
+	if (e == NULL) return NULL;
+
+	uint64_t now = dictionary->clock(dictionary->user_data);
+
+	unschedule_entry(dictionary, e);
+	e->deadline = ttl > UINT64_MAX - now ? UINT64_MAX : now + ttl;
+	schedule_entry(dictionary, e, dictionary->wheel_time + 1);
+
+	return e;
+}
+
+expiring_entry* get_expiring_entry(expiring_dictionary* dictionary, const char* key) {
+	if (dictionary == NULL || key == NULL) return NULL;
+
+	expiring_entry* e = find_entry(dictionary, hash_key_with(&dictionary->key_hasher, key, strlen(key)), key);
+
+	if (e == NULL) return NULL;
+
+	if (is_expired(e, dictionary->clock(dictionary->user_data))) {
+		drop_entry(dictionary, e);
+		return NULL;
+	}
+
+	return e;
+}
+
+expiring_dictionary* remove_expiring_entry(expiring_dictionary* dictionary, const char* key) {
+	if (dictionary == NULL || key == NULL) return NULL;
+
+	expiring_entry* e = find_entry(dictionary, hash_key_with(&dictionary->key_hasher, key, strlen(key)), key);
+
+	if (e == NULL) return NULL;
+
+	int expired = is_expired(e, dictionary->clock(dictionary->user_data));
+	drop_entry(dictionary, e);
+
+	return expired ? NULL : dictionary;
+}
+
+int expire_entries(expiring_dictionary* dictionary, int max_entries) {
+	if (dictionary == NULL || max_entries < 0) return -1;
+
+	return advance_wheel(dictionary, dictionary->clock(dictionary->user_data), max_entries);
+}
+
+int get_number_of_expiring_entries(expiring_dictionary* dictionary) {
+	if (dictionary == NULL) return -1;
+
+	expire_entries(dictionary, 0);
+
+	return dictionary->entry_count;
+}
+
+int contains_expiring_key(expiring_dictionary* dictionary, const char* key) {
+	if (dictionary == NULL || key == NULL) return -1;
+
+	return get_expiring_entry(dictionary, key) != NULL;
+}
@@ -0,0 +1,415 @@
+/*
+MIT License
+
+Copyright (c) 2016 Julius Paffrath
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <frozen_dictionary.h>
+#include <hash.h>
+
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+
+#define FROZEN_MAGIC 0x44464c4cU
+#define FROZEN_VERSION 1
+#define FROZEN_ALIGNMENT 16
+#define SEED_ATTEMPTS 8
+#define GOLDEN_RATIO 0x9e3779b97f4a7c15ULL
+
+struct frozen_header {
+	uint32_t magic;
+	uint32_t version;
+	uint64_t entry_count;
+	uint64_t bucket_count;
+	uint64_t value_size;
+	uint64_t seed;
+	uint64_t memory_size;
+};
+
+typedef struct frozen_header frozen_header;
+
+static uint64_t mix(uint64_t x) {
+	x ^= x >> 30;
+	x *= 0xbf58476d1ce4e5b9ULL;
+	x ^= x >> 27;
+	x *= 0x94d049bb133111ebULL;
+	x ^= x >> 31;
+
+	return x;
+}
+
+// saved images depend on this hash, so it does not follow the default hasher
+static uint64_t get_hash(const char* key, uint64_t seed) {
+	return mix(hash_fnv1a(key, strlen(key), 0) ^ seed);
+}
+
+static uint64_t get_bucket(uint64_t hash, uint64_t bucket_count) {
+	return ((hash >> 32) * bucket_count) >> 32;
+}
+
+static uint64_t get_slot(uint64_t hash, uint32_t displacement, uint64_t entry_count) {
+	return mix(hash + displacement * GOLDEN_RATIO) % entry_count;
+}
+
+static size_t align(size_t size) {
+	return (size + FROZEN_ALIGNMENT - 1) & ~(size_t)(FROZEN_ALIGNMENT - 1);
+}
+
+// adds size to offset and aligns the result, returns -1 on overflow
+static int add_aligned(size_t* offset, uint64_t size) {
+	if (size > SIZE_MAX - FROZEN_ALIGNMENT - *offset) return -1;
+
+	*offset = align(*offset + size);
+
+	return 0;
+}
+
+// the memory image is [displacements][key offsets][values][keys], returns -1 if it overflows
+static int get_keys_offset(uint64_t entry_count, uint64_t bucket_count, uint64_t value_size, size_t* offset) {
+	*offset = 0;
+
+	if (bucket_count > SIZE_MAX / sizeof(uint32_t) || entry_count >= SIZE_MAX / sizeof(uint32_t)) return -1;
+	if (value_size != 0 && entry_count > SIZE_MAX / value_size) return -1;
+
+	if (add_aligned(offset, bucket_count * sizeof(uint32_t)) != 0) return -1;
+	if (add_aligned(offset, (entry_count + 1) * sizeof(uint32_t)) != 0) return -1;
+
+	return add_aligned(offset, entry_count * value_size);
+}
+
+static void set_layout(frozen_dictionary* dictionary) {
+	char* memory = (char*)dictionary->memory;
+	size_t offset = align(dictionary->bucket_count * sizeof(uint32_t));
+
+	dictionary->displacements = (uint32_t*)memory;
+	dictionary->key_offsets = (uint32_t*)(memory + offset);
+	dictionary->values = memory + align(offset + (dictionary->entry_count + 1) * sizeof(uint32_t));
+
+	size_t keys_offset;
+	get_keys_offset(dictionary->entry_count, dictionary->bucket_count, dictionary->value_size, &keys_offset);
+
+	dictionary->keys = memory + keys_offset;
+}
+
+// checks that every key offset of a loaded image stays inside its nul terminated keys area
+static int check_keys(const frozen_header* header, const char* memory, size_t keys_offset) {
+	const uint32_t* key_offsets = (const uint32_t*)(memory + align(header->bucket_count * sizeof(uint32_t)));
+	uint64_t keys_size = header->memory_size - keys_offset;
+
+	if (memory[header->memory_size - 1] != '\0') return -1;
+	if (key_offsets[header->entry_count] > keys_size) return -1;
+
+	uint64_t i;
+	for (i = 0; i < header->entry_count; i++) {
+		if (key_offsets[i] >= key_offsets[i + 1]) return -1;
+	}
+
+	return 0;
+}
+
+// finds a displacement for every bucket so that all keys land in distinct slots
+static int place_buckets(uint64_t* hashes, uint64_t n, uint64_t r, uint32_t* displacements, uint64_t* slots) {
+	uint64_t* bucket_start = (uint64_t*)calloc(r + 1, sizeof(uint64_t));
+	uint64_t* order = (uint64_t*)malloc(sizeof(uint64_t) * n);
+	uint64_t* buckets = (uint64_t*)malloc(sizeof(uint64_t) * r);
+	unsigned char* taken = (unsigned char*)calloc(n, 1);
+	int result = -1;
+
+	if (bucket_start == NULL || order == NULL || buckets == NULL || taken == NULL) goto cleanup;
+
+	uint64_t i;
+	for (i = 0; i < n; i++) bucket_start[get_bucket(hashes[i], r) + 1]++;
+	for (i = 0; i < r; i++) bucket_start[i + 1] += bucket_start[i];
+
+	// counting sort of the keys by bucket, afterwards bucket b spans order[bucket_start[b]] to order[bucket_start[b + 1]]
+	for (i = 0; i < n; i++) {
+		uint64_t b = get_bucket(hashes[i], r);
+		order[bucket_start[b]++] = i;
+	}
+
+	for (i = r; i > 0; i--) bucket_start[i] = bucket_start[i - 1];
+	bucket_start[0] = 0;
+
+	uint64_t max_size = 0;
+
+	for (i = 0; i < r; i++) {
+		uint64_t size = bucket_start[i + 1] - bucket_start[i];
+		if (size > max_size) max_size = size;
+	}
+
+	// place large buckets first while most slots are still free
+	uint64_t placed = 0;
+	uint64_t size;
+
+	for (size = max_size; size > 0; size--) {
+		for (i = 0; i < r; i++) {
+			if (bucket_start[i + 1] - bucket_start[i] == size) buckets[placed++] = i;
+		}
+	}
+
+	uint64_t limit = 16 * n + 1024;
+	if (limit > UINT32_MAX) limit = UINT32_MAX;
+
+	for (i = 0; i < placed; i++) {
+		uint64_t b = buckets[i];
+		uint64_t first = bucket_start[b];
+		uint64_t last = bucket_start[b + 1];
+		uint64_t d;
+
+		for (d = 0; d < limit; d++) {
+			uint64_t k;
+
+			for (k = first; k < last; k++) {
+				uint64_t slot = get_slot(hashes[order[k]], (uint32_t)d, n);
+
+				if (taken[slot]) break;
+
+				taken[slot] = 1;
+				slots[order[k]] = slot;
+			}
+
+			if (k == last) break;
+
+			// roll back the slots taken by this attempt
+			uint64_t j;
+			for (j = first; j < k; j++) taken[slots[order[j]]] = 0;
+		}
+
+		if (d == limit) goto cleanup;
+
+		displacements[b] = (uint32_t)d;
+	}
+
+	for (i = 0; i < r; i++) {
+		if (bucket_start[i + 1] == bucket_start[i]) displacements[i] = 0;
+	}
+
+	result = 0;
+
+cleanup:
+	free(bucket_start);
+	free(order);
+	free(buckets);
+	free(taken);
+
+	return result;
+}
+
+frozen_dictionary* freeze_dictionary(entry* dictionary, size_t value_size) {
+	if (dictionary == NULL || value_size <= 0) return NULL;
+
+	uint64_t n = (uint64_t)get_number_of_entries(dictionary);
+	uint64_t r = n / 2 + 1;
+
+	entry** entries = (entry**)malloc(sizeof(entry*) * n);
+	uint64_t* hashes = (uint64_t*)malloc(sizeof(uint64_t) * n);
+	uint64_t* slots = (uint64_t*)malloc(sizeof(uint64_t) * n);
+	uint32_t* displacements = (uint32_t*)malloc(sizeof(uint32_t) * r);
+	frozen_dictionary* frozen = NULL;
+
+	if (entries == NULL || hashes == NULL || slots == NULL || displacements == NULL) goto cleanup;
+
+	uint64_t keys_size = 0;
+	entry* iterator = dictionary;
+
+	uint64_t i;
+	for (i = 0; i < n; i++) {
+		entries[i] = iterator;
+		keys_size += strlen(iterator->key) + 1;
+		iterator = iterator->next;
+	}
+
+	if (keys_size > UINT32_MAX) goto cleanup;
+
+	uint64_t seed = 0;
+	int attempt;
+
+	for (attempt = 0; attempt < SEED_ATTEMPTS; attempt++) {
+		seed = mix(GOLDEN_RATIO * (attempt + 1));
+
+		for (i = 0; i < n; i++) hashes[i] = get_hash(entries[i]->key, seed);
+
+		if (place_buckets(hashes, n, r, displacements, slots) == 0) break;
+	}
+
+	if (attempt == SEED_ATTEMPTS) goto cleanup;
+
+	frozen = (frozen_dictionary*)malloc(sizeof(frozen_dictionary));
+
+	if (frozen == NULL) goto cleanup;
+
+	frozen->entry_count = n;
+	frozen->bucket_count = r;
+	frozen->value_size = value_size;
+	frozen->seed = seed;
+
+	size_t keys_offset;
+
+	if (get_keys_offset(n, r, value_size, &keys_offset) != 0) {
+		free(frozen);
+		frozen = NULL;
+		goto cleanup;
+	}
+
+	frozen->memory_size = keys_offset + keys_size;
+	frozen->memory = aligned_alloc(FROZEN_ALIGNMENT, align(frozen->memory_size));
+
+	if (frozen->memory == NULL) {
+		free(frozen);
+		frozen = NULL;
+		goto cleanup;
+	}
+
+	set_layout(frozen);
+	memcpy(frozen->displacements, displacements, sizeof(uint32_t) * r);
+
+	// the hashes are not needed anymore, so their memory maps every slot to its entry
+	uint64_t* entry_of_slot = hashes;
+	for (i = 0; i < n; i++) entry_of_slot[slots[i]] = i;
+
+	uint32_t offset = 0;
+
+	for (i = 0; i < n; i++) {
+		entry* e = entries[entry_of_slot[i]];
+		size_t length = strlen(e->key) + 1;
+
+		frozen->key_offsets[i] = offset;
+		memcpy(frozen->keys + offset, e->key, length);
+		memcpy(frozen->values + i * value_size, e->value, value_size);
+
+		offset += (uint32_t)length;
+	}
+
+	frozen->key_offsets[n] = offset;
+
+cleanup:
+	free(entries);
+	free(hashes);
+	free(slots);
+	free(displacements);
+
+	return frozen;
+}
+
+void delete_frozen_dictionary(frozen_dictionary** dictionary) {
+	if (*dictionary == NULL) return;
+
+	free((*dictionary)->memory);
+	free(*dictionary);
+
+	*dictionary = NULL;
+}
+
+const void* get_frozen_entry(frozen_dictionary* dictionary, const char* key) {
+	if (dictionary == NULL || key == NULL) return NULL;
+
+	uint64_t hash = get_hash(key, dictionary->seed);
+	uint32_t displacement = dictionary->displacements[get_bucket(hash, dictionary->bucket_count)];
+	uint64_t slot = get_slot(hash, displacement, dictionary->entry_count);
+
+	if (strcmp(dictionary->keys + dictionary->key_offsets[slot], key) != 0) return NULL;
+
+	return dictionary->values + slot * dictionary->value_size;
+}
+
+int get_number_of_frozen_entries(frozen_dictionary* dictionary) {
+	if (dictionary == NULL) return -1;
+
+	return (int)dictionary->entry_count;
+}
+
+int contains_frozen_key(frozen_dictionary* dictionary, const char* key) {
+	if (dictionary == NULL || key == NULL) return -1;
+
+	return get_frozen_entry(dictionary, key) != NULL;
+}
+
+int save_frozen_dictionary(frozen_dictionary* dictionary, const char* path) {
+	if (dictionary == NULL || path == NULL) return -1;
+
+	FILE* file = fopen(path, "wb");
+
+	if (file == NULL) return -1;
+
+	frozen_header header;
+	header.magic = FROZEN_MAGIC;
+	header.version = FROZEN_VERSION;
+	header.entry_count = dictionary->entry_count;
+	header.bucket_count = dictionary->bucket_count;
+	header.value_size = dictionary->value_size;
+	header.seed = dictionary->seed;
+	header.memory_size = dictionary->memory_size;
+
+	int result = 0;
+
+	if (fwrite(&header, sizeof(header), 1, file) != 1) result = -1;
+	if (result == 0 && fwrite(dictionary->memory, dictionary->memory_size, 1, file) != 1) result = -1;
+	if (fclose(file) != 0) result = -1;
+
+	return result;
+}
+
+frozen_dictionary* load_frozen_dictionary(const char* path) {
+	if (path == NULL) return NULL;
+
+	FILE* file = fopen(path, "rb");
+
+	if (file == NULL) return NULL;
+
+	frozen_header header;
+	frozen_dictionary* dictionary = NULL;
+	size_t keys_offset;
+
+	if (fread(&header, sizeof(header), 1, file) != 1) goto cleanup;
+	if (header.magic != FROZEN_MAGIC || header.version != FROZEN_VERSION) goto cleanup;
+	if (header.entry_count == 0 || header.bucket_count == 0) goto cleanup;
+	if (get_keys_offset(header.entry_count, header.bucket_count, header.value_size, &keys_offset) != 0) goto cleanup;
+	if (header.memory_size <= keys_offset || header.memory_size > SIZE_MAX - FROZEN_ALIGNMENT) goto cleanup;
+
+	dictionary = (frozen_dictionary*)malloc(sizeof(frozen_dictionary));
+
+	if (dictionary == NULL) goto cleanup;
+
+	dictionary->entry_count = header.entry_count;
+	dictionary->bucket_count = header.bucket_count;
+	dictionary->value_size = header.value_size;
+	dictionary->seed = header.seed;
+	dictionary->memory_size = header.memory_size;
+	dictionary->memory = aligned_alloc(FROZEN_ALIGNMENT, align(header.memory_size));
+
+	if (dictionary->memory == NULL || fread(dictionary->memory, header.memory_size, 1, file) != 1) {
+		delete_frozen_dictionary(&dictionary);
+		goto cleanup;
+	}
+
+	if (check_keys(&header, (const char*)dictionary->memory, keys_offset) != 0) {
+		delete_frozen_dictionary(&dictionary);
+		goto cleanup;
+	}
+
+	set_layout(dictionary);
+
+cleanup:
+	fclose(file);
+
+	return dictionary;
+}
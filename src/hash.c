@@ -0,0 +1,323 @@
+/*
+MIT License
+
+Copyright (c) 2016 Julius Paffrath
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#include <hash.h>
+
+#include <string.h>
+#include <stdio.h>
+#include <time.h>
+#include <pthread.h>
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#include <nmmintrin.h>
+#define HAVE_SSE42_DISPATCH
+#endif
+
+#define FNV_OFFSET_BASIS 0xcbf29ce484222325ULL
+#define FNV_PRIME 0x100000001b3ULL
+
+#define CRC32C_POLYNOMIAL 0x82f63b78u
+
+static const uint64_t wyhash_secret[4] = {
+	0x2d358dccaa6c78a5ULL, 0x8bb84b93962eacc9ULL, 0x4b33a62ed433d4a3ULL, 0x4d5a2da51de1aa47ULL
+};
+
+static hasher default_hasher = {hash_wyhash, 0};
+static pthread_mutex_t default_hasher_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static uint32_t crc32c_table[256];
+static uint32_t (*crc32c_update)(uint32_t crc, const unsigned char* data, size_t length);
+static pthread_once_t crc32c_once = PTHREAD_ONCE_INIT;
+
+static uint64_t read64(const unsigned char* p) {
+	uint64_t value;
+	memcpy(&value, p, sizeof(value));
+	return value;
+}
+
+static uint64_t read32(const unsigned char* p) {
+	uint32_t value;
+	memcpy(&value, p, sizeof(value));
+	return value;
+}
+
+/* 64x64 -> 128 bit multiplication, the halves are returned in a and b */
+static void multiply(uint64_t* a, uint64_t* b) {
+#ifdef __SIZEOF_INT128__
+	__uint128_t r = (__uint128_t)*a * *b;
+	*a = (uint64_t)r;
+	*b = (uint64_t)(r >> 64);
+#else
+	uint64_t ha = *a >> 32, hb = *b >> 32, la = (uint32_t)*a, lb = (uint32_t)*b;
+	uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+	uint64_t t = rl + (rm0 << 32);
+	uint64_t carry = t < rl;
+	uint64_t lo = t + (rm1 << 32);
+	carry += lo < t;
+	*a = lo;
+	*b = rh + (rm0 >> 32) + (rm1 >> 32) + carry;
+#endif
+}
+
+static uint64_t mix(uint64_t a, uint64_t b) {
+	multiply(&a, &b);
+	return a ^ b;
+}
+
+/* finalizer of MurmurHash3 */
+static uint64_t avalanche(uint64_t x) {
+	x ^= x >> 33;
+	x *= 0xff51afd7ed558ccdULL;
+	x ^= x >> 33;
+	x *= 0xc4ceb9fe1a85ec53ULL;
+	x ^= x >> 33;
+
+	return x;
+}
+
+uint64_t hash_fnv1a(const char* key, size_t length, uint64_t seed) {
+	uint64_t hash = FNV_OFFSET_BASIS ^ seed;
+
+	size_t i;
+	for (i = 0; i < length; i++) {
+		hash ^= (unsigned char)key[i];
+		hash *= FNV_PRIME;
+	}
+
+	return hash;
+}
+
+uint64_t hash_wyhash(const char* key, size_t length, uint64_t seed) {
+	const unsigned char* p = (const unsigned char*)key;
+	uint64_t a, b;
+
+	seed ^= mix(seed ^ wyhash_secret[0], wyhash_secret[1]);
+
+	if (length <= 16) {
+		if (length >= 4) {
+			a = (read32(p) << 32) | read32(p + ((length >> 3) << 2));
+			b = (read32(p + length - 4) << 32) | read32(p + length - 4 - ((length >> 3) << 2));
+		}
+		else if (length > 0) {
+			a = ((uint64_t)p[0] << 16) | ((uint64_t)p[length >> 1] << 8) | p[length - 1];
+			b = 0;
+		}
+		else {
+			a = b = 0;
+		}
+	}
+	else {
+		size_t i = length;
+
+		if (i >= 48) {
+			uint64_t seed1 = seed, seed2 = seed;
+
+			do {
+				seed = mix(read64(p) ^ wyhash_secret[1], read64(p + 8) ^ seed);
+				seed1 = mix(read64(p + 16) ^ wyhash_secret[2], read64(p + 24) ^ seed1);
+				seed2 = mix(read64(p + 32) ^ wyhash_secret[3], read64(p + 40) ^ seed2);
+				p += 48;
+				i -= 48;
+			} while (i >= 48);
+
+			seed ^= seed1 ^ seed2;
+		}
+
+		while (i > 16) {
+			seed = mix(read64(p) ^ wyhash_secret[1], read64(p + 8) ^ seed);
+			i -= 16;
+			p += 16;
+		}
+
+		a = read64(p + i - 16);
+		b = read64(p + i - 8);
+	}
+
+	a ^= wyhash_secret[1];
+	b ^= seed;
+	multiply(&a, &b);
+
+	return mix(a ^ wyhash_secret[0] ^ length, b ^ wyhash_secret[1]);
+}
+
+static uint32_t crc32c_portable(uint32_t crc, const unsigned char* data, size_t length) {
+	size_t i;
+	for (i = 0; i < length; i++) {
+		crc = crc32c_table[(crc ^ data[i]) & 0xff] ^ (crc >> 8);
+	}
+
+	return crc;
+}
+
+#ifdef HAVE_SSE42_DISPATCH
+__attribute__((target("sse4.2")))
+static uint32_t crc32c_sse42(uint32_t crc, const unsigned char* data, size_t length) {
+	uint64_t crc64 = crc;
+
+	while (length >= 8) {
+		crc64 = _mm_crc32_u64(crc64, read64(data));
+		data += 8;
+		length -= 8;
+	}
+
+	crc = (uint32_t)crc64;
+
+	while (length > 0) {
+		crc = _mm_crc32_u8(crc, *data++);
+		length--;
+	}
+
+	return crc;
+}
+#endif
+
+static void init_crc32c(void) {
+	uint32_t i;
+	for (i = 0; i < 256; i++) {
+		uint32_t crc = i;
+
+		int bit;
+		for (bit = 0; bit < 8; bit++) {
+			crc = (crc >> 1) ^ (CRC32C_POLYNOMIAL & (0u - (crc & 1)));
+		}
+
+		crc32c_table[i] = crc;
+	}
+
+	crc32c_update = crc32c_portable;
+
+#ifdef HAVE_SSE42_DISPATCH
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("sse4.2")) crc32c_update = crc32c_sse42;
+#endif
+}
+
+uint64_t hash_crc32c(const char* key, size_t length, uint64_t seed) {
+	pthread_once(&crc32c_once, init_crc32c);
+
+	uint32_t crc = crc32c_update(~(uint32_t)seed, (const unsigned char*)key, length);
+
+	/* a crc only has 32 bits, spread them over all 64 for shard and bucket selection */
+	return avalanche(((uint64_t)~crc << 32 | length) ^ seed);
+}
+
+#define ROTATE(x, b) (((x) << (b)) | ((x) >> (64 - (b))))
+
+#define SIP_ROUND(v0, v1, v2, v3) \
+	do { \
+		v0 += v1; v1 = ROTATE(v1, 13); v1 ^= v0; v0 = ROTATE(v0, 32); \
+		v2 += v3; v3 = ROTATE(v3, 16); v3 ^= v2; \
+		v0 += v3; v3 = ROTATE(v3, 21); v3 ^= v0; \
+		v2 += v1; v1 = ROTATE(v1, 17); v1 ^= v2; v2 = ROTATE(v2, 32); \
+	} while (0)
+
+uint64_t hash_siphash(const char* key, size_t length, uint64_t seed) {
+	const unsigned char* p = (const unsigned char*)key;
+	uint64_t k0 = seed;
+	uint64_t k1 = avalanche(seed ^ 0x9e3779b97f4a7c15ULL);
+
+	uint64_t v0 = 0x736f6d6570736575ULL ^ k0;
+	uint64_t v1 = 0x646f72616e646f6dULL ^ k1;
+	uint64_t v2 = 0x6c7967656e657261ULL ^ k0;
+	uint64_t v3 = 0x7465646279746573ULL ^ k1;
+
+	size_t remaining = length;
+	while (remaining >= 8) {
+		uint64_t m = read64(p);
+
+		v3 ^= m;
+		SIP_ROUND(v0, v1, v2, v3);
+		SIP_ROUND(v0, v1, v2, v3);
+		v0 ^= m;
+
+		p += 8;
+		remaining -= 8;
+	}
+
+	uint64_t last = (uint64_t)length << 56;
+
+	size_t i;
+	for (i = 0; i < remaining; i++) {
+		last |= (uint64_t)p[i] << (8 * i);
+	}
+
+	v3 ^= last;
+	SIP_ROUND(v0, v1, v2, v3);
+	SIP_ROUND(v0, v1, v2, v3);
+	v0 ^= last;
+
+	v2 ^= 0xff;
+	SIP_ROUND(v0, v1, v2, v3);
+	SIP_ROUND(v0, v1, v2, v3);
+	SIP_ROUND(v0, v1, v2, v3);
+	SIP_ROUND(v0, v1, v2, v3);
+
+	return v0 ^ v1 ^ v2 ^ v3;
+}
+
+uint64_t create_hash_seed(void) {
+	uint64_t seed = 0;
+	FILE* random = fopen("/dev/urandom", "rb");
+
+	if (random != NULL) {
+		if (fread(&seed, sizeof(seed), 1, random) != 1) seed = 0;
+		fclose(random);
+	}
+
+	if (seed == 0) {
+		struct timespec now;
+		clock_gettime(CLOCK_REALTIME, &now);
+
+		/* weak fallback: time and the address of a stack variable */
+		seed = avalanche((uint64_t)now.tv_sec ^ ((uint64_t)now.tv_nsec << 32) ^ (uint64_t)(uintptr_t)&now);
+	}
+
+	return seed;
+}
+
+void set_default_hasher(hash_function function, uint64_t seed) {
+	pthread_mutex_lock(&default_hasher_lock);
+	default_hasher.function = function != NULL ? function : hash_wyhash;
+	default_hasher.seed = seed;
+	pthread_mutex_unlock(&default_hasher_lock);
+}
+
+hasher get_default_hasher(void) {
+	pthread_mutex_lock(&default_hasher_lock);
+	hasher current = default_hasher;
+	pthread_mutex_unlock(&default_hasher_lock);
+
+	return current;
+}
+
+uint64_t hash_key_with(const hasher* h, const char* key, size_t length) {
+	return h->function(key, length, h->seed);
+}
+
+uint64_t hash_key(const char* key, size_t length) {
+	hasher current = get_default_hasher();
+
+	return current.function(key, length, current.seed);
+}
@@ -24,14 +24,19 @@ SOFTWARE.
 
 #include <list.h>
 
+#include "list_memory.h"
+#include "prefetch.h"
+
 #include <string.h>
 #include <stdlib.h>
 #include <stdio.h>
 
+#define COMPACT_ALIGNMENT _Alignof(max_align_t)
+
 element* create_list(const void* value, size_t value_size) {
 	if (value == NULL || value_size <= 0) return NULL;
 
-	element* root = (element*)malloc(sizeof(element));
+	element* root = (element*)allocate_node(sizeof(element));
 
 	if (root == NULL) return NULL;
 
@@ -44,7 +49,7 @@ element* create_list(const void* value, size_t value_size) {
 }
 
 element* create_empty_list(void) {
-	element* root = (element*)malloc(sizeof(element));
+	element* root = (element*)allocate_node(sizeof(element));
 
 	if (root == NULL) return NULL;
 
@@ -103,7 +108,7 @@ element* create_list_with_string(const char* str) {
 element* create_list_alloc(void* value, void* (alloc_callback)(const void* e)) {
 	if (value == NULL || alloc_callback == NULL) return NULL;
 
-	element* root = (element*)malloc(sizeof(element));
+	element* root = (element*)allocate_node(sizeof(element));
 
 	if (root == NULL) return NULL;
 
@@ -122,12 +127,12 @@ void delete_list(element** list) {
 		element* last = del;
 		del = del->next;
 
-		free(last->value);
-		free(last);
+		free_element_value(last->value);
+		free_element(last);
 	}
 
-	free(del->value);
-	free(del);
+	free_element_value(del->value);
+	free_element(del);
 
 	*list = NULL;
 }
@@ -142,13 +147,13 @@ void delete_list_alloc(element** list, void (*free_callback)(const void* value))
 		del = del->next;
 
 		free_callback(last->value);
-		free(last->value);
-		free(last);
+		free_element_value(last->value);
+		free_element(last);
 	}
 
 	free_callback(del->value);
-	free(del->value);
-	free(del);
+	free_element_value(del->value);
+	free_element(del);
 
 	*list = NULL;
 }
@@ -172,6 +177,80 @@ element* clone_list(element* list, size_t value_size) {
 	return new_list;
 }
 
+static size_t align_compact(size_t size) {
+	return (size + COMPACT_ALIGNMENT - 1) & ~(COMPACT_ALIGNMENT - 1);
+}
+
+// moves up to count elements starting at *link into one block of a slab, next receives the following link
+static int relocate_elements(element** link, size_t value_size, int count, element*** next) {
+	int elements = 0;
+	int values = 0;
+
+	element* iterator;
+	for (iterator = *link; iterator != NULL && elements < count; iterator = iterator->next) {
+		elements++;
+		if (iterator->value != NULL) values++;
+	}
+
+	size_t node_size = align_compact(sizeof(element));
+	size_t value_stride = align_compact(value_size);
+	char* cursor = (char*)reserve_slab(node_size * elements + value_stride * values, elements + values);
+
+	if (cursor == NULL) return -1;
+
+	// every element is followed by its value, a traversal reads the block front to back
+	element** position = link;
+
+	int i;
+	for (i = 0; i < elements; i++) {
+		element* old = *position;
+		element* e = (element*)cursor;
+
+		cursor += node_size;
+		e->next = old->next;
+		e->value = NULL;
+
+		if (old->value != NULL) {
+			e->value = cursor;
+			memcpy(e->value, old->value, value_size);
+			cursor += value_stride;
+			free_element_value(old->value);
+		}
+
+		free_element(old);
+
+		*position = e;
+		position = &e->next;
+	}
+
+	*next = position;
+
+	return 0;
+}
+
+int compact_list(element** list, size_t value_size) {
+	if (list == NULL || *list == NULL || value_size <= 0) return -1;
+
+	element** next;
+
+	return relocate_elements(list, value_size, get_length_of_list(*list), &next);
+}
+
+int compact_list_incremental(element** link, size_t value_size, int count, element*** next) {
+	if (link == NULL || value_size <= 0 || count <= 0 || next == NULL) return -1;
+
+	if (*link == NULL) {
+		*next = NULL;
+		return 0;
+	}
+
+	if (relocate_elements(link, value_size, count, next) != 0) return -1;
+
+	if (**next == NULL) *next = NULL;
+
+	return 0;
+}
+
 element* add_element(element* list, const void* value, size_t value_size) {
 	if (list == NULL || value == NULL || value_size <= 0) return NULL;
 
@@ -231,9 +310,9 @@ element* remove_element_at_index(element* list, int index) {
 
 	if (index == 1) {
 		element* target = list->next;
-		free(target->value);
+		free_element_value(target->value);
 		list->next = target->next;
-		free(target);
+		free_element(target);
 
 		return list;
 	}
@@ -247,9 +326,9 @@ element* remove_element_at_index(element* list, int index) {
 	}
 
 	element* target = iterator->next;
-	free(target->value);
+	free_element_value(target->value);
 	iterator->next = target->next;
-	free(target);
+	free_element(target);
 
 	return iterator;
 }
@@ -298,7 +377,7 @@ element* set_value_at_index(element* list, const void* value, size_t value_size,
 
 	if (e == NULL) return NULL;
 
-	free(e->value);
+	free_element_value(e->value);
 
 	e->value = (void*)malloc(value_size);
 	memcpy(e->value, value, value_size);
@@ -358,17 +437,11 @@ int get_length_of_list(element* list) {
 int contains_element(element* list, element* e) {
 	if (list == NULL || e == NULL) return -1;
 
-	element* iterator = list;
+	element* iterator;
 	int counter = 0;
-	int length = get_length_of_list(list);
 
-	if (length == -1) return -1;
-
-	while (counter < length) {
+	for (iterator = list; iterator != NULL; iterator = iterator->next, counter++) {
 		if (iterator == e) return counter;
-
-		iterator = iterator->next;
-		counter++;
 	}
 
 	return -1;
@@ -377,17 +450,19 @@ int contains_element(element* list, element* e) {
 int contains_value(element* list, const void* value, size_t size) {
 	if (list == NULL || value == NULL) return -1;
 
-	element* iterator = list;
+	element* iterator;
 	int counter = 0;
-	int length = get_length_of_list(list);
 
-	if (length == -1) return -1;
+	for (iterator = list; iterator != NULL; iterator = iterator->next, counter++) {
+		element* next = iterator->next;
 
-	while (counter < length) {
-		if (memcmp(iterator->value, value, size) == 0) return counter;
+		// overlap the loads of the following element with the comparison of the current one
+		if (next != NULL) {
+			PREFETCH(next->next);
+			PREFETCH(next->value);
+		}
 
-		iterator = iterator->next;
-		counter++;
+		if (memcmp(iterator->value, value, size) == 0) return counter;
 	}
 
 	return -1;
@@ -24,6 +24,8 @@ SOFTWARE.
 
 #include <list_char.h>
 
+#include "list_search.h"
+
 element* create_char_list(char value) {
 	return create_list(&value, sizeof(char));
 }
@@ -45,5 +47,7 @@ element* set_char_at_index(element* list, char value, int index) {
 }
 
 int contains_char(element* list, char value) {
-	return contains_value(list, &value, sizeof(char));
+	if (list == NULL) return -1;
+
+	RETURN_INDEX_OF_VALUE(list, char, value);
 }
\ No newline at end of file
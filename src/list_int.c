@@ -24,6 +24,8 @@ SOFTWARE.
 
 #include <list_int.h>
 
+#include "list_search.h"
+
 element* create_int_list(int value) {
 	return create_list(&value, sizeof(int));
 }
@@ -45,5 +47,7 @@ element* set_int_at_index(element* list, int value, int index) {
 }
 
 int contains_int(element* list, int value) {
-	return contains_value(list, &value, sizeof(int));
+	if (list == NULL) return -1;
+
+	RETURN_INDEX_OF_VALUE(list, int, value);
 }
\ No newline at end of file
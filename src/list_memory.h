@@ -0,0 +1,48 @@
+/*
+MIT License
+
+Copyright (c) 2016 Julius Paffrath
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef LIBC_LIST_MEMORY
+#define LIBC_LIST_MEMORY
+
+#include <stdlib.h>
+
+#include "list.h"
+#include "node_cache.h"
+#include "slab.h"
+
+/*
+* Nodes and values of a list come from the node cache and malloc, or from a
+* slab after the list was compacted. Everything freeing list memory goes
+* through these functions.
+*/
+
+static inline void free_element_value(void* value) {
+	if (value != NULL && !release_slab_block(value)) free(value);
+}
+
+static inline void free_element(element* e) {
+	if (!release_slab_block(e)) release_node(e, sizeof(element));
+}
+
+#endif
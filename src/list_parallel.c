@@ -0,0 +1,313 @@
+/*
+MIT License
+
+Copyright (c) 2016 Julius Paffrath
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <list_parallel.h>
+#include <thread_pool.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+// segments per participating thread, smaller segments let stealing even out the load
+#define SEGMENTS_PER_THREAD 4
+
+struct list_segment {
+	element* first;
+	int length;
+};
+
+typedef struct list_segment list_segment;
+
+enum segment_operation {
+	SEGMENT_FOR_EACH,
+	SEGMENT_MAP,
+	SEGMENT_FILTER,
+	SEGMENT_REDUCE
+};
+
+struct segment_job {
+	enum segment_operation operation;
+	list_segment segment;
+	void (*function)(void);
+	void* context;
+	size_t size;
+	element* head;
+	element* tail;
+	void* partial;
+	int failed;
+};
+
+typedef struct segment_job segment_job;
+
+/*
+* Splits a list into at most 2 * target segments in one walk. A split point is
+* kept at every stride-th element; whenever the points run out, every other
+* point is dropped and the stride doubles, so all segments but the last one
+* have the same length.
+*/
+static list_segment* split_list(element* list, int target, int* count) {
+	int capacity = target * 2;
+	element** points = (element**)malloc(sizeof(element*) * capacity);
+
+	if (points == NULL) return NULL;
+
+	int stride = 1;
+	int point_count = 0;
+	int index = 0;
+
+	element* iterator;
+	for (iterator = list; iterator != NULL; iterator = iterator->next, index++) {
+		if (index % stride != 0) continue;
+
+		if (point_count == capacity) {
+			int i;
+			for (i = 0; i < capacity / 2; i++) {
+				points[i] = points[i * 2];
+			}
+
+			point_count = capacity / 2;
+			stride *= 2;
+
+			if (index % stride != 0) continue;
+		}
+
+		points[point_count++] = iterator;
+	}
+
+	list_segment* segments = (list_segment*)malloc(sizeof(list_segment) * point_count);
+
+	if (segments != NULL) {
+		int i;
+		for (i = 0; i < point_count; i++) {
+			segments[i].first = points[i];
+			segments[i].length = i + 1 < point_count ? stride : index - i * stride;
+		}
+
+		*count = point_count;
+	}
+
+	free(points);
+
+	return segments;
+}
+
+static int append_copy(segment_job* job, const void* value) {
+	element* e = create_list(value, job->size);
+
+	if (e == NULL) return -1;
+
+	if (job->tail == NULL) job->head = e;
+	else job->tail->next = e;
+
+	job->tail = e;
+
+	return 0;
+}
+
+static void run_segment(void* argument) {
+	segment_job* job = (segment_job*)argument;
+	element* iterator = job->segment.first;
+	void* buffer = NULL;
+
+	if (job->operation == SEGMENT_MAP) {
+		buffer = malloc(job->size);
+		if (buffer == NULL) job->failed = 1;
+	}
+
+	int i;
+	for (i = 0; i < job->segment.length && !job->failed; i++, iterator = iterator->next) {
+		if (iterator->value == NULL) continue;
+
+		switch (job->operation) {
+			case SEGMENT_FOR_EACH:
+				((void (*)(void*, void*))job->function)(iterator->value, job->context);
+				break;
+			case SEGMENT_MAP:
+				((void (*)(const void*, void*, void*))job->function)(iterator->value, buffer, job->context);
+				if (append_copy(job, buffer) != 0) job->failed = 1;
+				break;
+			case SEGMENT_FILTER:
+				if (((int (*)(const void*, void*))job->function)(iterator->value, job->context) &&
+					append_copy(job, iterator->value) != 0) {
+					job->failed = 1;
+				}
+				break;
+			case SEGMENT_REDUCE:
+				((void (*)(void*, const void*, void*))job->function)(job->partial, iterator->value, job->context);
+				break;
+		}
+	}
+
+	free(buffer);
+}
+
+/*
+* Runs an operation over all segments of a list on the default pool.
+* The caller owns the returned jobs.
+*/
+static segment_job* run_parallel(element* list, enum segment_operation operation, void (*function)(void),
+	void* context, size_t size, const void* identity, int* count) {
+	thread_pool* pool = get_default_thread_pool();
+
+	if (pool == NULL) return NULL;
+
+	int segment_count = 0;
+	list_segment* segments = split_list(list, (get_thread_count(pool) + 1) * SEGMENTS_PER_THREAD, &segment_count);
+
+	if (segments == NULL || segment_count <= 0) {
+		free(segments);
+		return NULL;
+	}
+
+	segment_job* jobs = (segment_job*)calloc((size_t)segment_count, sizeof(segment_job));
+
+	if (jobs == NULL) {
+		free(segments);
+		return NULL;
+	}
+
+	task_group group;
+	init_task_group(&group);
+
+	int i;
+	for (i = 0; i < segment_count; i++) {
+		jobs[i].operation = operation;
+		jobs[i].segment = segments[i];
+		jobs[i].function = function;
+		jobs[i].context = context;
+		jobs[i].size = size;
+
+		if (operation == SEGMENT_REDUCE) {
+			jobs[i].partial = malloc(size);
+
+			if (jobs[i].partial == NULL) {
+				jobs[i].failed = 1;
+				continue;
+			}
+
+			memcpy(jobs[i].partial, identity, size);
+		}
+
+		// the caller runs the segment itself when the pool cannot take it
+		if (submit_task(pool, &group, run_segment, &jobs[i]) != 0) run_segment(&jobs[i]);
+	}
+
+	wait_task_group(pool, &group);
+	free(segments);
+
+	*count = segment_count;
+
+	return jobs;
+}
+
+// links the lists built by the segments, NULL if a segment failed or nothing was built
+static element* join_segments(segment_job* jobs, int count) {
+	element* head = NULL;
+	element* tail = NULL;
+	int failed = 0;
+
+	int i;
+	for (i = 0; i < count; i++) {
+		failed |= jobs[i].failed;
+
+		if (jobs[i].head == NULL) continue;
+
+		if (tail == NULL) head = jobs[i].head;
+		else tail->next = jobs[i].head;
+
+		tail = jobs[i].tail;
+	}
+
+	if (failed) delete_list(&head);
+
+	return head;
+}
+
+int for_each_element_parallel(element* list, void (*function)(void* value, void* context), void* context) {
+	if (list == NULL || function == NULL) return -1;
+
+	int count = 0;
+	segment_job* jobs = run_parallel(list, SEGMENT_FOR_EACH, (void (*)(void))function, context, 0, NULL, &count);
+
+	if (jobs == NULL) return -1;
+
+	free(jobs);
+
+	return 0;
+}
+
+element* map_list_parallel(element* list, size_t result_size, void (*function)(const void* value, void* result, void* context), void* context) {
+	if (list == NULL || result_size <= 0 || function == NULL) return NULL;
+
+	int count = 0;
+	segment_job* jobs = run_parallel(list, SEGMENT_MAP, (void (*)(void))function, context, result_size, NULL, &count);
+
+	if (jobs == NULL) return NULL;
+
+	element* result = join_segments(jobs, count);
+	free(jobs);
+
+	return result;
+}
+
+element* filter_list_parallel(element* list, size_t value_size, int (*predicate)(const void* value, void* context), void* context) {
+	if (list == NULL || value_size <= 0 || predicate == NULL) return NULL;
+
+	int count = 0;
+	segment_job* jobs = run_parallel(list, SEGMENT_FILTER, (void (*)(void))predicate, context, value_size, NULL, &count);
+
+	if (jobs == NULL) return NULL;
+
+	element* result = join_segments(jobs, count);
+	free(jobs);
+
+	return result;
+}
+
+int reduce_list_parallel(element* list, void* result, size_t result_size, const void* identity,
+	void (*accumulate)(void* result, const void* value, void* context),
+	void (*merge)(void* destination, const void* source, void* context), void* context) {
+	if (list == NULL || result == NULL || result_size <= 0 || identity == NULL || accumulate == NULL || merge == NULL) return -1;
+
+	int count = 0;
+	segment_job* jobs = run_parallel(list, SEGMENT_REDUCE, (void (*)(void))accumulate, context, result_size, identity, &count);
+
+	if (jobs == NULL) return -1;
+
+	int failed = 0;
+
+	memcpy(result, identity, result_size);
+
+	int i;
+	for (i = 0; i < count; i++) {
+		failed |= jobs[i].failed;
+
+		if (!failed) merge(result, jobs[i].partial, context);
+
+		free(jobs[i].partial);
+	}
+
+	free(jobs);
+
+	return failed ? -1 : 0;
+}
@@ -0,0 +1,54 @@
+/*
+MIT License
+
+Copyright (c) 2016 Julius Paffrath
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef LIBC_LIST_SEARCH
+#define LIBC_LIST_SEARCH
+
+#include "prefetch.h"
+
+/*
+* Search of lists holding one integer type.
+*
+* contains_value compares every element through a call to memcmp. For int
+* and char the value is loaded and compared directly while the value of the
+* next element is prefetched. Doubles keep the byte compare, since == treats
+* -0.0 and NaN differently.
+*
+* Expands to the body of a contains function and returns from it.
+*/
+
+#define RETURN_INDEX_OF_VALUE(list, type, value) \
+	do { \
+		element* iterator; \
+		int counter = 0; \
+		\
+		for (iterator = (list); iterator != NULL; iterator = iterator->next, counter++) { \
+			if (iterator->next != NULL) PREFETCH(iterator->next->value); \
+			if (iterator->value != NULL && *(const type*)iterator->value == (value)) return counter; \
+		} \
+		\
+		return -1; \
+	} while (0)
+
+#endif
@@ -0,0 +1,184 @@
+/*
+MIT License
+
+Copyright (c) 2016 Julius Paffrath
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <list_skip_index.h>
+
+#include "prefetch.h"
+
+#include <string.h>
+#include <stdlib.h>
+
+// segments walked side by side, enough to keep the memory system busy
+#define SKIP_LANES 8
+
+list_skip_index* create_list_skip_index(element* list, int stride) {
+	if (list == NULL) return NULL;
+
+	if (stride <= 0) stride = SKIP_INDEX_DEFAULT_STRIDE;
+
+	list_skip_index* index = (list_skip_index*)malloc(sizeof(list_skip_index));
+
+	if (index == NULL) return NULL;
+
+	int capacity = 16;
+	index->points = (element**)malloc(sizeof(element*) * capacity);
+	index->count = 0;
+	index->stride = stride;
+	index->length = 0;
+
+	if (index->points == NULL) {
+		free(index);
+		return NULL;
+	}
+
+	element* iterator;
+	for (iterator = list; iterator != NULL; iterator = iterator->next, index->length++) {
+		if (index->length % stride != 0) continue;
+
+		if (index->count == capacity) {
+			element** grown = (element**)realloc(index->points, sizeof(element*) * capacity * 2);
+
+			if (grown == NULL) {
+				delete_list_skip_index(&index);
+				return NULL;
+			}
+
+			index->points = grown;
+			capacity *= 2;
+		}
+
+		index->points[index->count++] = iterator;
+	}
+
+	return index;
+}
+
+void delete_list_skip_index(list_skip_index** index) {
+	if (index == NULL || *index == NULL) return;
+
+	free((*index)->points);
+	free(*index);
+
+	*index = NULL;
+}
+
+element* get_element_with_skip_index(const list_skip_index* index, int position) {
+	if (index == NULL || position < 0 || position >= index->length) return NULL;
+
+	element* iterator = index->points[position / index->stride];
+
+	int i;
+	for (i = position % index->stride; i > 0; i--) {
+		iterator = iterator->next;
+	}
+
+	return iterator;
+}
+
+element* get_last_element_with_skip_index(const list_skip_index* index) {
+	if (index == NULL) return NULL;
+
+	return get_element_with_skip_index(index, index->length - 1);
+}
+
+int get_length_with_skip_index(const list_skip_index* index) {
+	if (index == NULL) return -1;
+
+	return index->length;
+}
+
+static int matches_value(const element* e, const void* target, size_t size) {
+	return memcmp(e->value, target, size) == 0;
+}
+
+static int matches_element(const element* e, const void* target, size_t size) {
+	(void)size;
+	return e == (const element*)target;
+}
+
+/*
+* Walks up to SKIP_LANES segments in lockstep. The chains of the lanes do not
+* depend on each other, so their loads are in flight at the same time. A lane
+* stops at its first match, the lowest matching lane holds the first match.
+*/
+static int find_interleaved(const list_skip_index* index, int (*match)(const element*, const void*, size_t),
+	const void* target, size_t size) {
+	int first;
+	for (first = 0; first < index->count; first += SKIP_LANES) {
+		element* cursors[SKIP_LANES];
+		int remaining[SKIP_LANES];
+		int found[SKIP_LANES];
+		int lanes = index->count - first < SKIP_LANES ? index->count - first : SKIP_LANES;
+		int active = lanes;
+
+		int lane;
+		for (lane = 0; lane < lanes; lane++) {
+			int segment = first + lane;
+
+			cursors[lane] = index->points[segment];
+			remaining[lane] = segment + 1 < index->count ? index->stride : index->length - segment * index->stride;
+			found[lane] = -1;
+		}
+
+		int step;
+		for (step = 0; active > 0; step++) {
+			for (lane = 0; lane < lanes; lane++) {
+				if (remaining[lane] == 0) continue;
+
+				element* e = cursors[lane];
+
+				// the element is in cache already, start fetching its successor before comparing
+				PREFETCH(e->next);
+
+				if (match(e, target, size)) {
+					found[lane] = step;
+					remaining[lane] = 0;
+					active--;
+					continue;
+				}
+
+				cursors[lane] = e->next;
+				if (--remaining[lane] == 0) active--;
+			}
+		}
+
+		for (lane = 0; lane < lanes; lane++) {
+			if (found[lane] != -1) return (first + lane) * index->stride + found[lane];
+		}
+	}
+
+	return -1;
+}
+
+int find_value_with_skip_index(const list_skip_index* index, const void* value, size_t size) {
+	if (index == NULL || value == NULL) return -1;
+
+	return find_interleaved(index, matches_value, value, size);
+}
+
+int find_element_with_skip_index(const list_skip_index* index, const element* e) {
+	if (index == NULL || e == NULL) return -1;
+
+	return find_interleaved(index, matches_element, e, 0);
+}
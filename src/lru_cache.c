@@ -0,0 +1,285 @@
+/*
+MIT License
+
+Copyright (c) 2016 Julius Paffrath
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <lru_cache.h>
+#include <hash.h>
+
+#include <string.h>
+#include <stdlib.h>
+
+#define INITIAL_BUCKET_COUNT 16
+
+static lru_entry** get_bucket(lru_cache* cache, uint64_t hash) {
+	return &cache->buckets[hash & (cache->bucket_count - 1)];
+}
+
+static lru_entry* find_entry(lru_cache* cache, uint64_t hash, const char* key) {
+	lru_entry* iterator = *get_bucket(cache, hash);
+
+	while (iterator != NULL) {
+		if (iterator->hash == hash && strcmp(iterator->key, key) == 0) return iterator;
+		iterator = iterator->chain;
+	}
+
+	return NULL;
+}
+
+static size_t get_entry_size(size_t value_size, size_t key_length) {
+	return value_size + key_length + 1;
+}
+
+static void grow_cache(lru_cache* cache) {
+	size_t new_count = cache->bucket_count * 2;
+	lru_entry** new_buckets = (lru_entry**)calloc(new_count, sizeof(lru_entry*));
+
+	if (new_buckets == NULL) return;
+
+	/* every entry is on the recency list, so rehash from there */
+	lru_entry* iterator = cache->head;
+	while (iterator != NULL) {
+		lru_entry** bucket = &new_buckets[iterator->hash & (new_count - 1)];
+
+		iterator->chain = *bucket;
+		*bucket = iterator;
+		iterator = iterator->next;
+	}
+
+	free(cache->buckets);
+	cache->buckets = new_buckets;
+	cache->bucket_count = new_count;
+}
+
+static void unlink_recency(lru_cache* cache, lru_entry* e) {
+	if (e->prev != NULL) e->prev->next = e->next;
+	else cache->head = e->next;
+
+	if (e->next != NULL) e->next->prev = e->prev;
+	else cache->tail = e->prev;
+}
+
+static void push_front(lru_cache* cache, lru_entry* e) {
+	e->prev = NULL;
+	e->next = cache->head;
+
+	if (cache->head != NULL) cache->head->prev = e;
+	else cache->tail = e;
+
+	cache->head = e;
+}
+
+static void move_to_front(lru_cache* cache, lru_entry* e) {
+	if (cache->head == e) return;
+
+	unlink_recency(cache, e);
+	push_front(cache, e);
+}
+
+/* Unlinks an entry from its bucket and the recency list and frees it. */
+static void drop_entry(lru_cache* cache, lru_entry* e, int evicted) {
+	lru_entry** link = get_bucket(cache, e->hash);
+
+	while (*link != e) link = &(*link)->chain;
+	*link = e->chain;
+
+	unlink_recency(cache, e);
+
+	cache->entry_count--;
+	cache->used_bytes -= get_entry_size(e->value_size, strlen(e->key));
+
+	if (evicted) {
+		cache->stats.evictions++;
+		if (cache->on_evict != NULL) cache->on_evict(e->key, e->value, e->value_size, cache->user_data);
+	}
+
+	free(e->value);
+	free(e->key);
+	free(e);
+}
+
+static int over_limit(lru_cache* cache) {
+	if (cache->max_entries > 0 && cache->entry_count > cache->max_entries) return 1;
+	if (cache->max_bytes > 0 && cache->used_bytes > cache->max_bytes) return 1;
+
+	return 0;
+}
+
+lru_cache* create_lru_cache(int max_entries, size_t max_bytes, lru_evict_callback on_evict, void* user_data) {
+	if (max_entries < 0) return NULL;
+
+	lru_cache* cache = (lru_cache*)malloc(sizeof(lru_cache));
+
+	if (cache == NULL) return NULL;
+
+	cache->buckets = (lru_entry**)calloc(INITIAL_BUCKET_COUNT, sizeof(lru_entry*));
+	if (cache->buckets == NULL) {
+		free(cache);
+		return NULL;
+	}
+
+	cache->bucket_count = INITIAL_BUCKET_COUNT;
+	cache->key_hasher = get_default_hasher();
+	cache->head = NULL;
+	cache->tail = NULL;
+	cache->entry_count = 0;
+	cache->max_entries = max_entries;
+	cache->max_bytes = max_bytes;
+	cache->used_bytes = 0;
+	cache->on_evict = on_evict;
+	cache->user_data = user_data;
+	memset(&cache->stats, 0, sizeof(lru_stats));
+
+	return cache;
+}
+
+void delete_lru_cache(lru_cache** cache) {
+	if (cache == NULL || *cache == NULL) return;
+
+	lru_entry* iterator = (*cache)->head;
+	while (iterator != NULL) {
+		lru_entry* next = iterator->next;
+
+		free(iterator->value);
+		free(iterator->key);
+		free(iterator);
+		iterator = next;
+	}
+
+	free((*cache)->buckets);
+	free(*cache);
+	*cache = NULL;
+}
+
+lru_entry* put_lru_entry(lru_cache* cache, const void* value, size_t value_size, const char* key) {
+	if (cache == NULL || value == NULL || value_size <= 0 || key == NULL) return NULL;
+
+	size_t key_length = strlen(key);
+	size_t size = get_entry_size(value_size, key_length);
+
+	if (cache->max_bytes > 0 && size > cache->max_bytes) return NULL;
+
+	uint64_t hash = hash_key_with(&cache->key_hasher, key, key_length);
+	lru_entry* e = find_entry(cache, hash, key);
+
+	void* copy = malloc(value_size);
+	if (copy == NULL) return NULL;
+	memcpy(copy, value, value_size);
+
+	if (e != NULL) {
+		cache->used_bytes -= get_entry_size(e->value_size, key_length);
+		free(e->value);
+		e->value = copy;
+		e->value_size = value_size;
+		move_to_front(cache, e);
+	}
+	else {
+		e = (lru_entry*)malloc(sizeof(lru_entry));
+		char* key_copy = (char*)malloc(key_length + 1);
+
+		if (e == NULL || key_copy == NULL) {
+			free(e);
+			free(key_copy);
+			free(copy);
+			return NULL;
+		}
+
+		memcpy(key_copy, key, key_length + 1);
+		e->value = copy;
+		e->value_size = value_size;
+		e->key = key_copy;
+		e->hash = hash;
+
+		lru_entry** bucket = get_bucket(cache, hash);
+		e->chain = *bucket;
+		*bucket = e;
+		push_front(cache, e);
+
+		cache->entry_count++;
+		if ((size_t)cache->entry_count > cache->bucket_count) grow_cache(cache);
+	}
+
+	cache->used_bytes += size;
+
+	/* the new entry is at the head and fits on its own, so it is never evicted here */
+	while (over_limit(cache)) drop_entry(cache, cache->tail, 1);
+
+	return e;
+}
+
+lru_entry* get_lru_entry(lru_cache* cache, const char* key) {
+	if (cache == NULL || key == NULL) return NULL;
+
+	lru_entry* e = find_entry(cache, hash_key_with(&cache->key_hasher, key, strlen(key)), key);
+
+	if (e == NULL) {
+		cache->stats.misses++;
+		return NULL;
+	}
+
+	cache->stats.hits++;
+	move_to_front(cache, e);
+
+	return e;
+}
+
+lru_entry* peek_lru_entry(lru_cache* cache, const char* key) {
+	if (cache == NULL || key == NULL) return NULL;
+
+	return find_entry(cache, hash_key_with(&cache->key_hasher, key, strlen(key)), key);
+}
+
+lru_cache* remove_lru_entry(lru_cache* cache, const char* key) {
+	lru_entry* e = peek_lru_entry(cache, key);
+
+	if (e == NULL) return NULL;
+
+	drop_entry(cache, e, 0);
+
+	return cache;
+}
+
+int get_number_of_lru_entries(lru_cache* cache) {
+	if (cache == NULL) return -1;
+
+	return cache->entry_count;
+}
+
+size_t get_lru_cache_size(lru_cache* cache) {
+	if (cache == NULL) return 0;
+
+	return cache->used_bytes;
+}
+
+int contains_lru_key(lru_cache* cache, const char* key) {
+	if (cache == NULL || key == NULL) return -1;
+
+	return peek_lru_entry(cache, key) != NULL;
+}
+
+int get_lru_stats(lru_cache* cache, lru_stats* stats) {
+	if (cache == NULL || stats == NULL) return -1;
+
+	*stats = cache->stats;
+
+	return 0;
+}
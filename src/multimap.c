@@ -0,0 +1,239 @@
+/*
+MIT License
+
+Copyright (c) 2016 Julius Paffrath
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <multimap.h>
+#include <hash.h>
+
+#include <string.h>
+#include <stdlib.h>
+
+#define INITIAL_BUCKET_COUNT 16
+#define INITIAL_VALUE_CAPACITY 4
+
+static multimap_entry** get_bucket(multimap* map, uint64_t hash) {
+	return &map->buckets[hash & (map->bucket_count - 1)];
+}
+
+static multimap_entry** find_link(multimap* map, uint64_t hash, const char* key) {
+	multimap_entry** link = get_bucket(map, hash);
+
+	while (*link != NULL) {
+		if ((*link)->hash == hash && strcmp((*link)->key, key) == 0) break;
+		link = &(*link)->next;
+	}
+
+	return link;
+}
+
+static void grow_multimap(multimap* map) {
+	size_t new_count = map->bucket_count * 2;
+	multimap_entry** new_buckets = (multimap_entry**)calloc(new_count, sizeof(multimap_entry*));
+
+	if (new_buckets == NULL) return;
+
+	size_t i;
+	for (i = 0; i < map->bucket_count; i++) {
+		multimap_entry* iterator = map->buckets[i];
+
+		while (iterator != NULL) {
+			multimap_entry* next = iterator->next;
+			multimap_entry** bucket = &new_buckets[iterator->hash & (new_count - 1)];
+
+			iterator->next = *bucket;
+			*bucket = iterator;
+			iterator = next;
+		}
+	}
+
+	free(map->buckets);
+	map->buckets = new_buckets;
+	map->bucket_count = new_count;
+}
+
+static void unlink_entry(multimap* map, multimap_entry** link) {
+	multimap_entry* e = *link;
+
+	*link = e->next;
+	map->key_count--;
+	map->value_count -= e->value_count;
+
+	free(e->values);
+	free(e);
+}
+
+multimap* create_multimap(size_t value_size) {
+	if (value_size <= 0) return NULL;
+
+	multimap* map = (multimap*)malloc(sizeof(multimap));
+
+	if (map == NULL) return NULL;
+
+	map->buckets = (multimap_entry**)calloc(INITIAL_BUCKET_COUNT, sizeof(multimap_entry*));
+	if (map->buckets == NULL) {
+		free(map);
+		return NULL;
+	}
+
+	map->bucket_count = INITIAL_BUCKET_COUNT;
+	map->key_hasher = get_default_hasher();
+	map->value_size = value_size;
+	map->key_count = 0;
+	map->value_count = 0;
+
+	return map;
+}
+
+void delete_multimap(multimap** map) {
+	if (map == NULL || *map == NULL) return;
+
+	size_t i;
+	for (i = 0; i < (*map)->bucket_count; i++) {
+		multimap_entry* iterator = (*map)->buckets[i];
+
+		while (iterator != NULL) {
+			multimap_entry* next = iterator->next;
+			free(iterator->values);
+			free(iterator);
+			iterator = next;
+		}
+	}
+
+	free((*map)->buckets);
+	free(*map);
+	*map = NULL;
+}
+
+multimap_entry* add_multimap_value(multimap* map, const void* value, const char* key) {
+	if (map == NULL || value == NULL || key == NULL) return NULL;
+
+	size_t key_length = strlen(key);
+	uint64_t hash = hash_key_with(&map->key_hasher, key, key_length);
+	multimap_entry** link = find_link(map, hash, key);
+	multimap_entry* e = *link;
+
+	if (e == NULL) {
+		e = (multimap_entry*)malloc(sizeof(multimap_entry) + key_length + 1);
+		if (e == NULL) return NULL;
+
+		e->values = malloc(map->value_size * INITIAL_VALUE_CAPACITY);
+		if (e->values == NULL) {
+			free(e);
+			return NULL;
+		}
+
+		memcpy(e->key, key, key_length + 1);
+		e->hash = hash;
+		e->value_count = 0;
+		e->capacity = INITIAL_VALUE_CAPACITY;
+
+		multimap_entry** bucket = get_bucket(map, hash);
+		e->next = *bucket;
+		*bucket = e;
+
+		map->key_count++;
+		if ((size_t)map->key_count > map->bucket_count) grow_multimap(map);
+	}
+	else if (e->value_count == e->capacity) {
+		void* values = realloc(e->values, map->value_size * (size_t)e->capacity * 2);
+		if (values == NULL) return NULL;
+
+		e->values = values;
+		e->capacity *= 2;
+	}
+
+	memcpy((char*)e->values + map->value_size * (size_t)e->value_count, value, map->value_size);
+	e->value_count++;
+	map->value_count++;
+
+	return e;
+}
+
+const void* get_multimap_values(multimap* map, const char* key, int* count) {
+	if (map == NULL || key == NULL) return NULL;
+
+	multimap_entry* e = *find_link(map, hash_key_with(&map->key_hasher, key, strlen(key)), key);
+
+	if (e == NULL) return NULL;
+
+	if (count != NULL) *count = e->value_count;
+
+	return e->values;
+}
+
+multimap* remove_multimap_value(multimap* map, const void* value, const char* key) {
+	if (map == NULL || value == NULL || key == NULL) return NULL;
+
+	multimap_entry** link = find_link(map, hash_key_with(&map->key_hasher, key, strlen(key)), key);
+	multimap_entry* e = *link;
+
+	if (e == NULL) return NULL;
+
+	char* values = (char*)e->values;
+	int i;
+	for (i = 0; i < e->value_count; i++) {
+		char* current = values + map->value_size * (size_t)i;
+
+		if (memcmp(current, value, map->value_size) == 0) {
+			memmove(current, current + map->value_size, map->value_size * (size_t)(e->value_count - i - 1));
+			e->value_count--;
+			map->value_count--;
+
+			if (e->value_count == 0) unlink_entry(map, link);
+
+			return map;
+		}
+	}
+
+	return NULL;
+}
+
+multimap* remove_multimap_key(multimap* map, const char* key) {
+	if (map == NULL || key == NULL) return NULL;
+
+	multimap_entry** link = find_link(map, hash_key_with(&map->key_hasher, key, strlen(key)), key);
+
+	if (*link == NULL) return NULL;
+
+	unlink_entry(map, link);
+
+	return map;
+}
+
+int get_number_of_multimap_keys(multimap* map) {
+	if (map == NULL) return -1;
+
+	return map->key_count;
+}
+
+int get_number_of_multimap_values(multimap* map) {
+	if (map == NULL) return -1;
+
+	return map->value_count;
+}
+
+int contains_multimap_key(multimap* map, const char* key) {
+	if (map == NULL || key == NULL) return -1;
+
+	return *find_link(map, hash_key_with(&map->key_hasher, key, strlen(key)), key) != NULL;
+}
@@ -0,0 +1,243 @@
+/*
+MIT License
+
+Copyright (c) 2016 Julius Paffrath
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "node_cache.h"
+
+#include <stdlib.h>
+#include <pthread.h>
+
+#define CLASS_COUNT (NODE_CACHE_MAX_SIZE / 8)
+#define NO_CLASS (-1)
+
+struct magazine {
+	struct magazine* next;
+	int count;
+	void* nodes[NODE_MAGAZINE_SIZE];
+};
+
+typedef struct magazine magazine;
+
+struct magazine_pair {
+	magazine* loaded;
+	magazine* previous;
+};
+
+typedef struct magazine_pair magazine_pair;
+
+struct depot {
+	pthread_mutex_t lock;
+	magazine* full;
+	magazine* empty;
+	int full_count;
+};
+
+typedef struct depot depot;
+
+static depot depots[CLASS_COUNT];
+static pthread_once_t depot_once = PTHREAD_ONCE_INIT;
+static pthread_key_t cache_key;
+
+static _Thread_local magazine_pair* thread_cache = NULL;
+
+static int get_class(size_t size) {
+	if (size == 0 || size > NODE_CACHE_MAX_SIZE || size % 8 != 0) return NO_CLASS;
+
+	return (int)(size / 8) - 1;
+}
+
+static void free_nodes(magazine* m) {
+	int i;
+	for (i = 0; i < m->count; i++) {
+		free(m->nodes[i]);
+	}
+
+	m->count = 0;
+}
+
+// hands a magazine to the depot, the depot lock must be held
+static void return_magazine(depot* d, magazine* m) {
+	if (m == NULL) return;
+
+	if (m->count > 0 && d->full_count < NODE_DEPOT_LIMIT) {
+		m->next = d->full;
+		d->full = m;
+		d->full_count++;
+		return;
+	}
+
+	free_nodes(m);
+	m->next = d->empty;
+	d->empty = m;
+}
+
+// runs on thread exit, the depot takes over everything the thread still caches
+static void release_thread_cache(void* value) {
+	magazine_pair* pairs = (magazine_pair*)value;
+
+	int i;
+	for (i = 0; i < CLASS_COUNT; i++) {
+		pthread_mutex_lock(&depots[i].lock);
+		return_magazine(&depots[i], pairs[i].loaded);
+		return_magazine(&depots[i], pairs[i].previous);
+		pthread_mutex_unlock(&depots[i].lock);
+	}
+
+	free(pairs);
+	thread_cache = NULL;
+}
+
+static void create_depots(void) {
+	int i;
+	for (i = 0; i < CLASS_COUNT; i++) {
+		pthread_mutex_init(&depots[i].lock, NULL);
+		depots[i].full = NULL;
+		depots[i].empty = NULL;
+		depots[i].full_count = 0;
+	}
+
+	pthread_key_create(&cache_key, release_thread_cache);
+}
+
+static magazine_pair* get_thread_cache(void) {
+	if (thread_cache != NULL) return thread_cache;
+
+	pthread_once(&depot_once, create_depots);
+
+	thread_cache = (magazine_pair*)calloc(CLASS_COUNT, sizeof(magazine_pair));
+
+	if (thread_cache != NULL) pthread_setspecific(cache_key, thread_cache);
+
+	return thread_cache;
+}
+
+static magazine* take_empty_magazine(depot* d) {
+	magazine* m = d->empty;
+
+	if (m != NULL) {
+		d->empty = m->next;
+	}
+	else {
+		m = (magazine*)malloc(sizeof(magazine));
+		if (m == NULL) return NULL;
+	}
+
+	m->next = NULL;
+	m->count = 0;
+
+	return m;
+}
+
+void* allocate_node(size_t size) {
+	int size_class = get_class(size);
+
+	if (size_class == NO_CLASS) return malloc(size);
+
+	magazine_pair* pairs = get_thread_cache();
+
+	if (pairs == NULL) return malloc(size);
+
+	magazine_pair* pair = &pairs[size_class];
+
+	if (pair->loaded != NULL && pair->loaded->count > 0) {
+		return pair->loaded->nodes[--pair->loaded->count];
+	}
+
+	if (pair->previous != NULL && pair->previous->count > 0) {
+		magazine* swap = pair->loaded;
+		pair->loaded = pair->previous;
+		pair->previous = swap;
+
+		return pair->loaded->nodes[--pair->loaded->count];
+	}
+
+	depot* d = &depots[size_class];
+	void* node = NULL;
+
+	pthread_mutex_lock(&d->lock);
+
+	if (d->full != NULL) {
+		// both magazines are empty, one of them goes back for a full one
+		magazine* full = d->full;
+		d->full = full->next;
+		d->full_count--;
+
+		if (pair->previous != NULL) {
+			pair->previous->next = d->empty;
+			d->empty = pair->previous;
+		}
+
+		pair->previous = pair->loaded;
+		pair->loaded = full;
+		node = full->nodes[--full->count];
+	}
+
+	pthread_mutex_unlock(&d->lock);
+
+	return node != NULL ? node : malloc(size);
+}
+
+void release_node(void* node, size_t size) {
+	if (node == NULL) return;
+
+	int size_class = get_class(size);
+	magazine_pair* pairs = size_class == NO_CLASS ? NULL : get_thread_cache();
+
+	if (pairs == NULL) {
+		free(node);
+		return;
+	}
+
+	magazine_pair* pair = &pairs[size_class];
+
+	if (pair->loaded != NULL && pair->loaded->count < NODE_MAGAZINE_SIZE) {
+		pair->loaded->nodes[pair->loaded->count++] = node;
+		return;
+	}
+
+	if (pair->previous != NULL && pair->previous->count < NODE_MAGAZINE_SIZE) {
+		magazine* swap = pair->loaded;
+		pair->loaded = pair->previous;
+		pair->previous = swap;
+		pair->loaded->nodes[pair->loaded->count++] = node;
+		return;
+	}
+
+	depot* d = &depots[size_class];
+
+	pthread_mutex_lock(&d->lock);
+
+	// both magazines are full or missing, the previous one goes to the depot
+	return_magazine(d, pair->previous);
+	pair->previous = pair->loaded;
+	pair->loaded = take_empty_magazine(d);
+
+	pthread_mutex_unlock(&d->lock);
+
+	if (pair->loaded == NULL) {
+		free(node);
+		return;
+	}
+
+	pair->loaded->nodes[pair->loaded->count++] = node;
+}
@@ -0,0 +1,54 @@
+/*
+MIT License
+
+Copyright (c) 2016 Julius Paffrath
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef LIBC_NODE_CACHE
+#define LIBC_NODE_CACHE
+
+#include <stddef.h>
+
+/*
+* Per thread caches for the small fixed size nodes of lists and dictionaries.
+*
+* Released nodes are kept in magazines owned by the releasing thread, two per
+* size class. Only when both are full or both are empty the thread exchanges a
+* whole magazine with a global depot, so the depot lock is taken once every
+* NODE_MAGAZINE_SIZE operations at most. A node may be released by any thread,
+* it simply moves into the cache of that thread.
+*
+* Every cached node is an ordinary malloc block of exactly the size of its
+* class, so nodes may still be freed with free and nodes allocated with malloc
+* may be released to the cache. Sizes which are no multiple of 8 or larger
+* than NODE_CACHE_MAX_SIZE bypass the cache.
+*/
+
+#define NODE_MAGAZINE_SIZE 64
+#define NODE_CACHE_MAX_SIZE 64
+
+// full magazines the depot keeps per size class, further nodes are freed
+#define NODE_DEPOT_LIMIT 64
+
+void* allocate_node(size_t size);
+void release_node(void* node, size_t size);
+
+#endif
@@ -0,0 +1,649 @@
+/*
+MIT License
+
+Copyright (c) 2016 Julius Paffrath
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <ordered_dictionary.h>
+
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+
+#define MIN_KEYS (ORDERED_NODE_KEYS / 2)
+
+struct split_result {
+	ordered_node* right;
+	char* separator;
+};
+
+typedef struct split_result split_result;
+
+// packs the first bytes of a key big endian so that integer order equals string order
+static uint64_t get_prefix(const char* key) {
+	uint64_t prefix = 0;
+
+	int i;
+	for (i = 0; i < 8; i++) {
+		prefix <<= 8;
+		if (*key != '\0') prefix |= (unsigned char)*key++;
+	}
+
+	return prefix;
+}
+
+static int compare_keys(uint64_t prefix_a, const char* a, uint64_t prefix_b, const char* b) {
+	if (prefix_a != prefix_b) return prefix_a < prefix_b ? -1 : 1;
+
+	return strcmp(a, b);
+}
+
+// returns the index of the first key which is not less than the given key
+static int lower_bound(const ordered_node* node, uint64_t prefix, const char* key) {
+	int low = 0;
+	int high = node->key_count;
+
+	while (low < high) {
+		int middle = (low + high) / 2;
+
+		if (compare_keys(node->prefixes[middle], node->keys[middle], prefix, key) < 0) low = middle + 1;
+		else high = middle;
+	}
+
+	return low;
+}
+
+// returns the index of the child which covers the given key
+static int find_child_index(const ordered_node* node, uint64_t prefix, const char* key) {
+	int low = 0;
+	int high = node->key_count;
+
+	while (low < high) {
+		int middle = (low + high) / 2;
+
+		if (compare_keys(node->prefixes[middle], node->keys[middle], prefix, key) <= 0) low = middle + 1;
+		else high = middle;
+	}
+
+	return low;
+}
+
+static ordered_node* create_node(int is_leaf) {
+	ordered_node* node = (ordered_node*)malloc(sizeof(ordered_node));
+
+	if (node == NULL) return NULL;
+
+	node->is_leaf = is_leaf;
+	node->key_count = 0;
+	node->next = NULL;
+
+	return node;
+}
+
+// inner nodes which may have to be split reserve a node in advance, an unused one is kept for the next insert
+static ordered_node* reserve_node(ordered_dictionary* dictionary) {
+	ordered_node* node = dictionary->spare;
+
+	if (node != NULL) {
+		dictionary->spare = NULL;
+		return node;
+	}
+
+	return create_node(0);
+}
+
+static void release_node(ordered_dictionary* dictionary, ordered_node* node) {
+	if (node == NULL) return;
+
+	if (dictionary->spare == NULL) dictionary->spare = node;
+	else free(node);
+}
+
+static void delete_node(ordered_node* node) {
+	int i;
+	for (i = 0; i < node->key_count; i++) {
+		free(node->keys[i]);
+		if (node->is_leaf) free(node->values[i]);
+	}
+
+	if (!node->is_leaf) {
+		for (i = 0; i <= node->key_count; i++) {
+			delete_node(node->children[i]);
+		}
+	}
+
+	free(node);
+}
+
+static char* copy_key(const char* key) {
+	size_t length = strlen(key) + 1;
+	char* copy = (char*)malloc(length);
+
+	if (copy != NULL) memcpy(copy, key, length);
+
+	return copy;
+}
+
+static void insert_key(ordered_node* node, int index, uint64_t prefix, char* key) {
+	memmove(&node->prefixes[index + 1], &node->prefixes[index], sizeof(uint64_t) * (node->key_count - index));
+	memmove(&node->keys[index + 1], &node->keys[index], sizeof(char*) * (node->key_count - index));
+
+	node->prefixes[index] = prefix;
+	node->keys[index] = key;
+}
+
+static void remove_key(ordered_node* node, int index) {
+	memmove(&node->prefixes[index], &node->prefixes[index + 1], sizeof(uint64_t) * (node->key_count - index - 1));
+	memmove(&node->keys[index], &node->keys[index + 1], sizeof(char*) * (node->key_count - index - 1));
+}
+
+static int split_leaf(ordered_node* leaf, split_result* split) {
+	ordered_node* right = create_node(1);
+
+	if (right == NULL) return -1;
+
+	int keep = leaf->key_count / 2;
+	right->key_count = leaf->key_count - keep;
+
+	memcpy(right->prefixes, &leaf->prefixes[keep], sizeof(uint64_t) * right->key_count);
+	memcpy(right->keys, &leaf->keys[keep], sizeof(char*) * right->key_count);
+	memcpy(right->values, &leaf->values[keep], sizeof(void*) * right->key_count);
+
+	split->separator = copy_key(right->keys[0]);
+
+	if (split->separator == NULL) {
+		free(right);
+		return -1;
+	}
+
+	leaf->key_count = keep;
+	right->next = leaf->next;
+	leaf->next = right;
+	split->right = right;
+
+	return 0;
+}
+
+static void split_inner(ordered_node* node, ordered_node* right, split_result* split) {
+	// the middle key moves up into the parent
+	int middle = node->key_count / 2;
+	right->key_count = node->key_count - middle - 1;
+
+	memcpy(right->prefixes, &node->prefixes[middle + 1], sizeof(uint64_t) * right->key_count);
+	memcpy(right->keys, &node->keys[middle + 1], sizeof(char*) * right->key_count);
+	memcpy(right->children, &node->children[middle + 1], sizeof(ordered_node*) * (right->key_count + 1));
+
+	split->separator = node->keys[middle];
+	node->key_count = middle;
+	split->right = right;
+}
+
+// inserts into the subtree of node, *value_out receives the stored value
+static int insert_into(ordered_dictionary* dictionary, ordered_node* node, uint64_t prefix, const char* key, void* value, void** value_out, split_result* split) {
+	split->right = NULL;
+
+	if (node->is_leaf) {
+		int index = lower_bound(node, prefix, key);
+
+		if (index < node->key_count && compare_keys(node->prefixes[index], node->keys[index], prefix, key) == 0) {
+			free(node->values[index]);
+			node->values[index] = value;
+			*value_out = value;
+			return 0;
+		}
+
+		char* new_key = copy_key(key);
+
+		if (new_key == NULL) return -1;
+
+		if (node->key_count == ORDERED_NODE_KEYS) {
+			if (split_leaf(node, split) != 0) {
+				free(new_key);
+				return -1;
+			}
+
+			if (index > node->key_count) {
+				index -= node->key_count;
+				node = split->right;
+			}
+		}
+
+		memmove(&node->values[index + 1], &node->values[index], sizeof(void*) * (node->key_count - index));
+		insert_key(node, index, prefix, new_key);
+		node->values[index] = value;
+		node->key_count++;
+
+		dictionary->entry_count++;
+		*value_out = value;
+
+		return 0;
+	}
+
+	// a full node may have to be split, so the new node is allocated before anything is changed
+	ordered_node* spare = NULL;
+
+	if (node->key_count == ORDERED_NODE_KEYS) {
+		spare = reserve_node(dictionary);
+		if (spare == NULL) return -1;
+	}
+
+	int index = find_child_index(node, prefix, key);
+	split_result child_split;
+
+	int result = insert_into(dictionary, node->children[index], prefix, key, value, value_out, &child_split);
+
+	if (result != 0 || child_split.right == NULL) {
+		release_node(dictionary, spare);
+		return result;
+	}
+
+	if (spare != NULL) {
+		spare->is_leaf = 0;
+		spare->key_count = 0;
+		split_inner(node, spare, split);
+
+		if (index > node->key_count) {
+			index -= node->key_count + 1;
+			node = split->right;
+		}
+	}
+
+	memmove(&node->children[index + 2], &node->children[index + 1], sizeof(ordered_node*) * (node->key_count - index));
+	insert_key(node, index, get_prefix(child_split.separator), child_split.separator);
+	node->children[index + 1] = child_split.right;
+	node->key_count++;
+
+	return 0;
+}
+
+static void rebalance_child(ordered_node* parent, int index) {
+	ordered_node* child = parent->children[index];
+	ordered_node* left = index > 0 ? parent->children[index - 1] : NULL;
+	ordered_node* right = index < parent->key_count ? parent->children[index + 1] : NULL;
+
+	if (left == NULL && right == NULL) return;
+
+	if (left != NULL && left->key_count > MIN_KEYS) {
+		// borrow the last entry of the left sibling
+		if (child->is_leaf) {
+			char* separator = copy_key(left->keys[left->key_count - 1]);
+
+			// without a new separator the child simply stays below the minimum fill
+			if (separator == NULL) return;
+
+			memmove(&child->values[1], &child->values[0], sizeof(void*) * child->key_count);
+			insert_key(child, 0, left->prefixes[left->key_count - 1], left->keys[left->key_count - 1]);
+			child->values[0] = left->values[left->key_count - 1];
+
+			free(parent->keys[index - 1]);
+			parent->keys[index - 1] = separator;
+			parent->prefixes[index - 1] = child->prefixes[0];
+		}
+		else {
+			memmove(&child->children[1], &child->children[0], sizeof(ordered_node*) * (child->key_count + 1));
+			insert_key(child, 0, parent->prefixes[index - 1], parent->keys[index - 1]);
+			child->children[0] = left->children[left->key_count];
+
+			parent->keys[index - 1] = left->keys[left->key_count - 1];
+			parent->prefixes[index - 1] = left->prefixes[left->key_count - 1];
+		}
+
+		child->key_count++;
+		left->key_count--;
+		return;
+	}
+
+	if (right != NULL && right->key_count > MIN_KEYS) {
+		// borrow the first entry of the right sibling
+		if (child->is_leaf) {
+			char* separator = copy_key(right->keys[1]);
+
+			if (separator == NULL) return;
+
+			child->prefixes[child->key_count] = right->prefixes[0];
+			child->keys[child->key_count] = right->keys[0];
+			child->values[child->key_count] = right->values[0];
+
+			memmove(&right->values[0], &right->values[1], sizeof(void*) * (right->key_count - 1));
+			remove_key(right, 0);
+
+			free(parent->keys[index]);
+			parent->keys[index] = separator;
+			parent->prefixes[index] = right->prefixes[0];
+		}
+		else {
+			child->prefixes[child->key_count] = parent->prefixes[index];
+			child->keys[child->key_count] = parent->keys[index];
+			child->children[child->key_count + 1] = right->children[0];
+
+			parent->keys[index] = right->keys[0];
+			parent->prefixes[index] = right->prefixes[0];
+
+			memmove(&right->children[0], &right->children[1], sizeof(ordered_node*) * right->key_count);
+			remove_key(right, 0);
+		}
+
+		child->key_count++;
+		right->key_count--;
+		return;
+	}
+
+	// merge the child with one of its siblings into the left node
+	int separator = left != NULL ? index - 1 : index;
+	ordered_node* target = left != NULL ? left : child;
+	ordered_node* source = left != NULL ? child : right;
+
+	if (target->is_leaf) {
+		memcpy(&target->prefixes[target->key_count], source->prefixes, sizeof(uint64_t) * source->key_count);
+		memcpy(&target->keys[target->key_count], source->keys, sizeof(char*) * source->key_count);
+		memcpy(&target->values[target->key_count], source->values, sizeof(void*) * source->key_count);
+		target->key_count += source->key_count;
+		target->next = source->next;
+
+		free(parent->keys[separator]);
+	}
+	else {
+		target->prefixes[target->key_count] = parent->prefixes[separator];
+		target->keys[target->key_count] = parent->keys[separator];
+		target->key_count++;
+
+		memcpy(&target->prefixes[target->key_count], source->prefixes, sizeof(uint64_t) * source->key_count);
+		memcpy(&target->keys[target->key_count], source->keys, sizeof(char*) * source->key_count);
+		memcpy(&target->children[target->key_count], source->children, sizeof(ordered_node*) * (source->key_count + 1));
+		target->key_count += source->key_count;
+	}
+
+	free(source);
+
+	memmove(&parent->children[separator + 1], &parent->children[separator + 2], sizeof(ordered_node*) * (parent->key_count - separator - 1));
+	remove_key(parent, separator);
+	parent->key_count--;
+}
+
+static int remove_from(ordered_node* node, uint64_t prefix, const char* key) {
+	if (node->is_leaf) {
+		int index = lower_bound(node, prefix, key);
+
+		if (index == node->key_count || compare_keys(node->prefixes[index], node->keys[index], prefix, key) != 0) return 0;
+
+		free(node->keys[index]);
+		free(node->values[index]);
+
+		memmove(&node->values[index], &node->values[index + 1], sizeof(void*) * (node->key_count - index - 1));
+		remove_key(node, index);
+		node->key_count--;
+
+		return 1;
+	}
+
+	int index = find_child_index(node, prefix, key);
+
+	if (!remove_from(node->children[index], prefix, key)) return 0;
+
+	if (node->children[index]->key_count < MIN_KEYS) rebalance_child(node, index);
+
+	return 1;
+}
+
+static ordered_node* find_leaf(ordered_dictionary* dictionary, uint64_t prefix, const char* key) {
+	ordered_node* node = dictionary->root;
+
+	while (!node->is_leaf) {
+		node = node->children[find_child_index(node, prefix, key)];
+	}
+
+	return node;
+}
+
+ordered_dictionary* create_ordered_dictionary(void) {
+	ordered_dictionary* dictionary = (ordered_dictionary*)malloc(sizeof(ordered_dictionary));
+
+	if (dictionary == NULL) return NULL;
+
+	dictionary->root = create_node(1);
+	dictionary->spare = NULL;
+	dictionary->entry_count = 0;
+
+	if (dictionary->root == NULL) {
+		free(dictionary);
+		return NULL;
+	}
+
+	return dictionary;
+}
+
+void delete_ordered_dictionary(ordered_dictionary** dictionary) {
+	if (*dictionary == NULL) return;
+
+	delete_node((*dictionary)->root);
+	free((*dictionary)->spare);
+	free(*dictionary);
+
+	*dictionary = NULL;
+}
+
+void* add_ordered_entry(ordered_dictionary* dictionary, const void* value, size_t value_size, const char* key) {
+	if (dictionary == NULL || value == NULL || value_size <= 0 || key == NULL) return NULL;
+
+	void* new_value = malloc(value_size);
+
+	if (new_value == NULL) return NULL;
+
+	memcpy(new_value, value, value_size);
+
+	// a full root may have to be split, so the new root is allocated before anything is changed
+	ordered_node* root = NULL;
+
+	if (dictionary->root->key_count == ORDERED_NODE_KEYS) {
+		root = reserve_node(dictionary);
+
+		if (root == NULL) {
+			free(new_value);
+			return NULL;
+		}
+	}
+
+	void* stored = NULL;
+	split_result split;
+
+	if (insert_into(dictionary, dictionary->root, get_prefix(key), key, new_value, &stored, &split) != 0) {
+		release_node(dictionary, root);
+		free(new_value);
+		return NULL;
+	}
+
+	if (split.right == NULL) {
+		release_node(dictionary, root);
+	}
+	else {
+		// the root was split, so the tree grows by one level
+		root->is_leaf = 0;
+		root->next = NULL;
+		root->prefixes[0] = get_prefix(split.separator);
+		root->keys[0] = split.separator;
+		root->children[0] = dictionary->root;
+		root->children[1] = split.right;
+		root->key_count = 1;
+
+		dictionary->root = root;
+	}
+
+	return stored;
+}
+
+ordered_dictionary* remove_ordered_entry(ordered_dictionary* dictionary, const char* key) {
+	if (dictionary == NULL || key == NULL) return NULL;
+
+	if (!remove_from(dictionary->root, get_prefix(key), key)) return NULL;
+
+	dictionary->entry_count--;
+
+	if (!dictionary->root->is_leaf && dictionary->root->key_count == 0) {
+		ordered_node* old_root = dictionary->root;
+		dictionary->root = old_root->children[0];
+		free(old_root);
+	}
+
+	return dictionary;
+}
+
+void* get_ordered_entry(ordered_dictionary* dictionary, const char* key) {
+	if (dictionary == NULL || key == NULL) return NULL;
+
+	uint64_t prefix = get_prefix(key);
+	ordered_node* leaf = find_leaf(dictionary, prefix, key);
+	int index = lower_bound(leaf, prefix, key);
+
+	if (index < leaf->key_count && compare_keys(leaf->prefixes[index], leaf->keys[index], prefix, key) == 0) {
+		return leaf->values[index];
+	}
+
+	return NULL;
+}
+
+int get_number_of_ordered_entries(ordered_dictionary* dictionary) {
+	if (dictionary == NULL) return -1;
+
+	return dictionary->entry_count;
+}
+
+int contains_ordered_key(ordered_dictionary* dictionary, const char* key) {
+	if (dictionary == NULL || key == NULL) return -1;
+
+	return get_ordered_entry(dictionary, key) != NULL;
+}
+
+element* get_ordered_keys(ordered_dictionary* dictionary) {
+	ordered_iterator* iterator = create_ordered_iterator(dictionary, NULL, NULL);
+
+	if (iterator == NULL) return NULL;
+
+	element* list = NULL;
+	element* last = NULL;
+	const char* key;
+
+	while (next_ordered_entry(iterator, &key, NULL)) {
+		element* e = create_list(key, strlen(key) + 1);
+
+		if (e == NULL) {
+			delete_list(&list);
+			break;
+		}
+
+		if (last == NULL) list = e;
+		else last->next = e;
+
+		last = e;
+	}
+
+	delete_ordered_iterator(&iterator);
+
+	return list;
+}
+
+ordered_iterator* create_ordered_iterator(ordered_dictionary* dictionary, const char* from, const char* to) {
+	if (dictionary == NULL) return NULL;
+
+	ordered_iterator* iterator = (ordered_iterator*)malloc(sizeof(ordered_iterator));
+
+	if (iterator == NULL) return NULL;
+
+	iterator->to = NULL;
+
+	if (to != NULL) {
+		iterator->to = copy_key(to);
+
+		if (iterator->to == NULL) {
+			free(iterator);
+			return NULL;
+		}
+	}
+
+	if (from == NULL) {
+		ordered_node* node = dictionary->root;
+
+		while (!node->is_leaf) node = node->children[0];
+
+		iterator->leaf = node;
+		iterator->index = 0;
+	}
+	else {
+		uint64_t prefix = get_prefix(from);
+
+		iterator->leaf = find_leaf(dictionary, prefix, from);
+		iterator->index = lower_bound(iterator->leaf, prefix, from);
+	}
+
+	return iterator;
+}
+
+int next_ordered_entry(ordered_iterator* iterator, const char** key, void** value) {
+	if (iterator == NULL) return 0;
+
+	while (iterator->leaf != NULL && iterator->index >= iterator->leaf->key_count) {
+		iterator->leaf = iterator->leaf->next;
+		iterator->index = 0;
+	}
+
+	if (iterator->leaf == NULL) return 0;
+
+	const char* current = iterator->leaf->keys[iterator->index];
+
+	if (iterator->to != NULL && strcmp(current, iterator->to) >= 0) {
+		iterator->leaf = NULL;
+		return 0;
+	}
+
+	if (key != NULL) *key = current;
+	if (value != NULL) *value = iterator->leaf->values[iterator->index];
+
+	iterator->index++;
+
+	return 1;
+}
+
+void delete_ordered_iterator(ordered_iterator** iterator) {
+	if (*iterator == NULL) return;
+
+	free((*iterator)->to);
+	free(*iterator);
+
+	*iterator = NULL;
+}
+
+void print_ordered_dictionary(ordered_dictionary* dictionary) {
+	ordered_iterator* iterator = create_ordered_iterator(dictionary, NULL, NULL);
+
+	if (iterator == NULL) return;
+
+	const char* key;
+	void* value;
+
+	puts("***");
+
+	while (next_ordered_entry(iterator, &key, &value)) {
+		printf("\t%s -> %s\n", key, (char*)value);
+	}
+
+	puts("***");
+
+	delete_ordered_iterator(&iterator);
+}
@@ -0,0 +1,452 @@
+/*
+MIT License
+
+Copyright (c) 2016 Julius Paffrath
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <persistent_dictionary.h>
+#include <hash.h>
+
+#include <string.h>
+#include <stdlib.h>
+
+#define TRIE_BITS 5
+#define TRIE_MASK ((1u << TRIE_BITS) - 1)
+
+/* below this depth the hash is used up and equal hashes share a collision node */
+#define MAX_SHIFT 64
+
+static uint32_t get_bit(uint64_t hash, unsigned shift) {
+	return 1u << ((hash >> shift) & TRIE_MASK);
+}
+
+static uint32_t get_index(uint32_t map, uint32_t bit) {
+	return (uint32_t)__builtin_popcount(map & (bit - 1));
+}
+
+static persistent_entry* create_entry(const void* value, size_t value_size, const char* key, size_t key_len, uint64_t hash) {
+	size_t value_offset = (key_len + 1 + _Alignof(max_align_t) - 1) & ~(_Alignof(max_align_t) - 1);
+	persistent_entry* e = (persistent_entry*)malloc(sizeof(persistent_entry) + value_offset + value_size);
+
+	if (e == NULL) return NULL;
+
+	atomic_init(&e->references, 1);
+	e->hash = hash;
+	e->value_size = value_size;
+	e->key = e->data;
+	e->value = e->data + value_offset;
+
+	memcpy(e->key, key, key_len + 1);
+	memcpy(e->value, value, value_size);
+
+	return e;
+}
+
+static void retain(atomic_int* references) {
+	atomic_fetch_add_explicit(references, 1, memory_order_relaxed);
+}
+
+static int drop_reference(atomic_int* references) {
+	return atomic_fetch_sub_explicit(references, 1, memory_order_acq_rel) == 1;
+}
+
+static void release_entry(persistent_entry* e) {
+	if (drop_reference(&e->references)) free(e);
+}
+
+static void release_node(persistent_node* node) {
+	if (node == NULL || !drop_reference(&node->references)) return;
+
+	uint32_t i;
+	for (i = 0; i < node->count; i++) {
+		if (i < node->entries) release_entry((persistent_entry*)node->slots[i]);
+		else release_node((persistent_node*)node->slots[i]);
+	}
+
+	free(node);
+}
+
+static persistent_node* create_node(uint32_t entry_map, uint32_t node_map, uint32_t entries, uint32_t count) {
+	persistent_node* node = (persistent_node*)malloc(sizeof(persistent_node) + sizeof(void*) * count);
+
+	if (node == NULL) return NULL;
+
+	atomic_init(&node->references, 1);
+	node->entry_map = entry_map;
+	node->node_map = node_map;
+	node->entries = entries;
+	node->count = count;
+
+	return node;
+}
+
+/* Retains every slot of a freshly copied node except the one at skip. */
+static void retain_slots(persistent_node* node, uint32_t skip) {
+	uint32_t i;
+	for (i = 0; i < node->count; i++) {
+		if (i == skip) continue;
+
+		if (i < node->entries) retain(&((persistent_entry*)node->slots[i])->references);
+		else retain(&((persistent_node*)node->slots[i])->references);
+	}
+}
+
+/* Copies a node and replaces one slot with an already owned pointer. */
+static persistent_node* replace_slot(persistent_node* node, uint32_t index, void* slot) {
+	persistent_node* copy = create_node(node->entry_map, node->node_map, node->entries, node->count);
+
+	if (copy == NULL) return NULL;
+
+	memcpy(copy->slots, node->slots, sizeof(void*) * node->count);
+	copy->slots[index] = slot;
+	retain_slots(copy, index);
+
+	return copy;
+}
+
+/* Builds the subtrie holding two entries with different keys, both are retained. */
+static persistent_node* create_pair(persistent_entry* a, persistent_entry* b, unsigned shift) {
+	persistent_node* node;
+
+	if (shift >= MAX_SHIFT) {
+		node = create_node(0, 0, 2, 2);
+		if (node == NULL) return NULL;
+
+		node->slots[0] = a;
+		node->slots[1] = b;
+	}
+	else {
+		uint32_t bit_a = get_bit(a->hash, shift);
+		uint32_t bit_b = get_bit(b->hash, shift);
+
+		if (bit_a == bit_b) {
+			persistent_node* child = create_pair(a, b, shift + TRIE_BITS);
+			if (child == NULL) return NULL;
+
+			node = create_node(0, bit_a, 0, 1);
+			if (node == NULL) {
+				release_node(child);
+				return NULL;
+			}
+
+			node->slots[0] = child;
+			return node;
+		}
+
+		node = create_node(bit_a | bit_b, 0, 2, 2);
+		if (node == NULL) return NULL;
+
+		node->slots[bit_a < bit_b ? 0 : 1] = a;
+		node->slots[bit_a < bit_b ? 1 : 0] = b;
+	}
+
+	retain(&a->references);
+	retain(&b->references);
+
+	return node;
+}
+
+/* Returns a new version of node containing e, which is consumed on success. */
+static persistent_node* insert_entry(persistent_node* node, unsigned shift, persistent_entry* e, int* added) {
+	if (shift >= MAX_SHIFT) {
+		uint32_t i;
+		for (i = 0; i < node->count; i++) {
+			if (strcmp(((persistent_entry*)node->slots[i])->key, e->key) == 0) {
+				*added = 0;
+				return replace_slot(node, i, e);
+			}
+		}
+
+		persistent_node* copy = create_node(0, 0, node->count + 1, node->count + 1);
+		if (copy == NULL) return NULL;
+
+		memcpy(copy->slots, node->slots, sizeof(void*) * node->count);
+		copy->slots[node->count] = e;
+		retain_slots(copy, node->count);
+
+		*added = 1;
+		return copy;
+	}
+
+	uint32_t bit = get_bit(e->hash, shift);
+
+	if (node->entry_map & bit) {
+		uint32_t index = get_index(node->entry_map, bit);
+		persistent_entry* existing = (persistent_entry*)node->slots[index];
+
+		if (existing->hash == e->hash && strcmp(existing->key, e->key) == 0) {
+			*added = 0;
+			return replace_slot(node, index, e);
+		}
+
+		/* the slot turns into a subtrie holding both entries */
+		persistent_node* child = create_pair(existing, e, shift + TRIE_BITS);
+		if (child == NULL) return NULL;
+
+		persistent_node* copy = create_node(node->entry_map & ~bit, node->node_map | bit, node->entries - 1, node->count);
+		if (copy == NULL) {
+			release_node(child);
+			return NULL;
+		}
+
+		uint32_t node_index = copy->entries + get_index(copy->node_map, bit);
+
+		memcpy(copy->slots, node->slots, sizeof(void*) * index);
+		memcpy(copy->slots + index, node->slots + index + 1, sizeof(void*) * (node_index - index));
+		copy->slots[node_index] = child;
+		memcpy(copy->slots + node_index + 1, node->slots + node_index + 1, sizeof(void*) * (node->count - node_index - 1));
+		retain_slots(copy, node_index);
+
+		/* create_pair took its own reference to e */
+		release_entry(e);
+
+		*added = 1;
+		return copy;
+	}
+
+	if (node->node_map & bit) {
+		uint32_t index = node->entries + get_index(node->node_map, bit);
+		persistent_node* child = insert_entry((persistent_node*)node->slots[index], shift + TRIE_BITS, e, added);
+
+		if (child == NULL) return NULL;
+
+		persistent_node* copy = replace_slot(node, index, child);
+		if (copy == NULL) {
+			/* give e back to the caller */
+			retain(&e->references);
+			release_node(child);
+		}
+
+		return copy;
+	}
+
+	uint32_t index = get_index(node->entry_map, bit);
+	persistent_node* copy = create_node(node->entry_map | bit, node->node_map, node->entries + 1, node->count + 1);
+
+	if (copy == NULL) return NULL;
+
+	memcpy(copy->slots, node->slots, sizeof(void*) * index);
+	copy->slots[index] = e;
+	memcpy(copy->slots + index + 1, node->slots + index, sizeof(void*) * (node->count - index));
+	retain_slots(copy, index);
+
+	*added = 1;
+	return copy;
+}
+
+/* Copies a node without the slot at index. */
+static persistent_node* remove_slot(persistent_node* node, uint32_t entry_map, uint32_t node_map, uint32_t entries, uint32_t index) {
+	persistent_node* copy = create_node(entry_map, node_map, entries, node->count - 1);
+
+	if (copy == NULL) return NULL;
+
+	memcpy(copy->slots, node->slots, sizeof(void*) * index);
+	memcpy(copy->slots + index, node->slots + index + 1, sizeof(void*) * (node->count - index - 1));
+	retain_slots(copy, copy->count);
+
+	return copy;
+}
+
+/* Stores a new version of node without the key in result, returns 1 if removed, 0 if missing or -1. */
+static int remove_key(persistent_node* node, unsigned shift, uint64_t hash, const char* key, persistent_node** result) {
+	if (shift >= MAX_SHIFT) {
+		uint32_t i;
+		for (i = 0; i < node->count; i++) {
+			if (strcmp(((persistent_entry*)node->slots[i])->key, key) == 0) {
+				*result = remove_slot(node, 0, 0, node->count - 1, i);
+				return *result != NULL ? 1 : -1;
+			}
+		}
+
+		return 0;
+	}
+
+	uint32_t bit = get_bit(hash, shift);
+
+	if (node->entry_map & bit) {
+		uint32_t index = get_index(node->entry_map, bit);
+		persistent_entry* existing = (persistent_entry*)node->slots[index];
+
+		if (existing->hash != hash || strcmp(existing->key, key) != 0) return 0;
+
+		*result = remove_slot(node, node->entry_map & ~bit, node->node_map, node->entries - 1, index);
+		return *result != NULL ? 1 : -1;
+	}
+
+	if (!(node->node_map & bit)) return 0;
+
+	uint32_t index = node->entries + get_index(node->node_map, bit);
+	persistent_node* child;
+	int status = remove_key((persistent_node*)node->slots[index], shift + TRIE_BITS, hash, key, &child);
+
+	if (status != 1) return status;
+
+	if (child->count == 1 && child->entries == 1) {
+		/* a subtrie with a single entry is pulled up into this node */
+		persistent_entry* single = (persistent_entry*)child->slots[0];
+		uint32_t entry_index = get_index(node->entry_map, bit);
+		persistent_node* copy = create_node(node->entry_map | bit, node->node_map & ~bit, node->entries + 1, node->count);
+
+		if (copy == NULL) {
+			release_node(child);
+			return -1;
+		}
+
+		memcpy(copy->slots, node->slots, sizeof(void*) * entry_index);
+		copy->slots[entry_index] = single;
+		memcpy(copy->slots + entry_index + 1, node->slots + entry_index, sizeof(void*) * (index - entry_index));
+		memcpy(copy->slots + index + 1, node->slots + index + 1, sizeof(void*) * (node->count - index - 1));
+		retain_slots(copy, copy->count);
+
+		release_node(child);
+		*result = copy;
+		return 1;
+	}
+
+	*result = replace_slot(node, index, child);
+	if (*result == NULL) {
+		release_node(child);
+		return -1;
+	}
+
+	return 1;
+}
+
+persistent_dictionary* create_persistent_dictionary(void) {
+	persistent_dictionary* dictionary = (persistent_dictionary*)malloc(sizeof(persistent_dictionary));
+
+	if (dictionary == NULL) return NULL;
+
+	dictionary->root = create_node(0, 0, 0, 0);
+	if (dictionary->root == NULL) {
+		free(dictionary);
+		return NULL;
+	}
+
+	dictionary->entry_count = 0;
+	dictionary->key_hasher = get_default_hasher();
+
+	return dictionary;
+}
+
+void delete_persistent_dictionary(persistent_dictionary** dictionary) {
+	if (dictionary == NULL || *dictionary == NULL) return;
+
+	release_node((*dictionary)->root);
+	free(*dictionary);
+	*dictionary = NULL;
+}
+
+persistent_dictionary* snapshot_persistent_dictionary(persistent_dictionary* dictionary) {
+	if (dictionary == NULL) return NULL;
+
+	persistent_dictionary* snapshot = (persistent_dictionary*)malloc(sizeof(persistent_dictionary));
+
+	if (snapshot == NULL) return NULL;
+
+	retain(&dictionary->root->references);
+	snapshot->root = dictionary->root;
+	snapshot->entry_count = dictionary->entry_count;
+	snapshot->key_hasher = dictionary->key_hasher;
+
+	return snapshot;
+}
+
+const persistent_entry* add_persistent_entry(persistent_dictionary* dictionary, const void* value, size_t value_size, const char* key) {
+	if (dictionary == NULL || value == NULL || value_size <= 0 || key == NULL) return NULL;
+
+	size_t key_len = strlen(key);
+	persistent_entry* e = create_entry(value, value_size, key, key_len, hash_key_with(&dictionary->key_hasher, key, key_len));
+
+	if (e == NULL) return NULL;
+
+	int added = 0;
+	persistent_node* root = insert_entry(dictionary->root, 0, e, &added);
+
+	if (root == NULL) {
+		release_entry(e);
+		return NULL;
+	}
+
+	release_node(dictionary->root);
+	dictionary->root = root;
+	dictionary->entry_count += added;
+
+	return e;
+}
+
+persistent_dictionary* remove_persistent_entry(persistent_dictionary* dictionary, const char* key) {
+	if (dictionary == NULL || key == NULL) return NULL;
+
+	persistent_node* root;
+
+	if (remove_key(dictionary->root, 0, hash_key_with(&dictionary->key_hasher, key, strlen(key)), key, &root) != 1) return NULL;
+
+	release_node(dictionary->root);
+	dictionary->root = root;
+	dictionary->entry_count--;
+
+	return dictionary;
+}
+
+const persistent_entry* get_persistent_entry(persistent_dictionary* dictionary, const char* key) {
+	if (dictionary == NULL || key == NULL) return NULL;
+
+	uint64_t hash = hash_key_with(&dictionary->key_hasher, key, strlen(key));
+	persistent_node* node = dictionary->root;
+	unsigned shift = 0;
+
+	while (shift < MAX_SHIFT) {
+		uint32_t bit = get_bit(hash, shift);
+
+		if (node->entry_map & bit) {
+			persistent_entry* e = (persistent_entry*)node->slots[get_index(node->entry_map, bit)];
+
+			if (e->hash == hash && strcmp(e->key, key) == 0) return e;
+			return NULL;
+		}
+
+		if (!(node->node_map & bit)) return NULL;
+
+		node = (persistent_node*)node->slots[node->entries + get_index(node->node_map, bit)];
+		shift += TRIE_BITS;
+	}
+
+	uint32_t i;
+	for (i = 0; i < node->count; i++) {
+		persistent_entry* e = (persistent_entry*)node->slots[i];
+		if (strcmp(e->key, key) == 0) return e;
+	}
+
+	return NULL;
+}
+
+int get_number_of_persistent_entries(persistent_dictionary* dictionary) {
+	if (dictionary == NULL) return -1;
+
+	return dictionary->entry_count;
+}
+
+int contains_persistent_key(persistent_dictionary* dictionary, const char* key) {
+	if (dictionary == NULL || key == NULL) return -1;
+
+	return get_persistent_entry(dictionary, key) != NULL;
+}
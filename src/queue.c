@@ -0,0 +1,244 @@
+/*
+MIT License
+
+Copyright (c) 2016 Julius Paffrath
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <queue.h>
+
+#include <string.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+#define CACHE_LINE 64
+#define RECYCLED_NODES 1024
+
+mpmc_queue* create_mpmc_queue(size_t capacity, size_t value_size) {
+	if (capacity == 0 || value_size <= 0) return NULL;
+
+	size_t count = 2;
+	while (count < capacity) count <<= 1;
+
+	mpmc_queue* queue = (mpmc_queue*)aligned_alloc(_Alignof(mpmc_queue), sizeof(mpmc_queue));
+
+	if (queue == NULL) return NULL;
+
+	queue->cell_size = (sizeof(mpmc_cell) + value_size + _Alignof(max_align_t) - 1) & ~(_Alignof(max_align_t) - 1);
+	queue->cells = (char*)aligned_alloc(CACHE_LINE, (queue->cell_size * count + CACHE_LINE - 1) & ~(size_t)(CACHE_LINE - 1));
+
+	if (queue->cells == NULL) {
+		free(queue);
+		return NULL;
+	}
+
+	size_t i;
+	for (i = 0; i < count; i++) {
+		atomic_init(&((mpmc_cell*)(queue->cells + i * queue->cell_size))->sequence, i);
+	}
+
+	queue->mask = count - 1;
+	queue->value_size = value_size;
+	atomic_init(&queue->enqueue_position, 0);
+	atomic_init(&queue->dequeue_position, 0);
+
+	return queue;
+}
+
+void delete_mpmc_queue(mpmc_queue** queue) {
+	if (queue == NULL || *queue == NULL) return;
+
+	free((*queue)->cells);
+	free(*queue);
+	*queue = NULL;
+}
+
+static mpmc_cell* get_cell(mpmc_queue* queue, size_t position) {
+	return (mpmc_cell*)(queue->cells + (position & queue->mask) * queue->cell_size);
+}
+
+int enqueue_mpmc(mpmc_queue* queue, const void* value) {
+	if (queue == NULL || value == NULL) return -1;
+
+	size_t position = atomic_load_explicit(&queue->enqueue_position, memory_order_relaxed);
+
+	for (;;) {
+		mpmc_cell* cell = get_cell(queue, position);
+		size_t sequence = atomic_load_explicit(&cell->sequence, memory_order_acquire);
+		intptr_t difference = (intptr_t)sequence - (intptr_t)position;
+
+		if (difference == 0) {
+			// the cell is free for this lap, claim it
+			if (atomic_compare_exchange_weak_explicit(&queue->enqueue_position, &position, position + 1, memory_order_relaxed, memory_order_relaxed)) {
+				memcpy(cell->data, value, queue->value_size);
+				atomic_store_explicit(&cell->sequence, position + 1, memory_order_release);
+				return 0;
+			}
+		}
+		else if (difference < 0) {
+			// the cell still holds a value from the previous lap
+			return -1;
+		}
+		else {
+			position = atomic_load_explicit(&queue->enqueue_position, memory_order_relaxed);
+		}
+	}
+}
+
+int dequeue_mpmc(mpmc_queue* queue, void* value) {
+	if (queue == NULL || value == NULL) return -1;
+
+	size_t position = atomic_load_explicit(&queue->dequeue_position, memory_order_relaxed);
+
+	for (;;) {
+		mpmc_cell* cell = get_cell(queue, position);
+		size_t sequence = atomic_load_explicit(&cell->sequence, memory_order_acquire);
+		intptr_t difference = (intptr_t)sequence - (intptr_t)(position + 1);
+
+		if (difference == 0) {
+			if (atomic_compare_exchange_weak_explicit(&queue->dequeue_position, &position, position + 1, memory_order_relaxed, memory_order_relaxed)) {
+				memcpy(value, cell->data, queue->value_size);
+				// hand the cell to the producers of the next lap
+				atomic_store_explicit(&cell->sequence, position + queue->mask + 1, memory_order_release);
+				return 0;
+			}
+		}
+		else if (difference < 0) {
+			return -1;
+		}
+		else {
+			position = atomic_load_explicit(&queue->dequeue_position, memory_order_relaxed);
+		}
+	}
+}
+
+mpsc_queue* create_mpsc_queue(size_t value_size) {
+	if (value_size <= 0) return NULL;
+
+	mpsc_queue* queue = (mpsc_queue*)aligned_alloc(_Alignof(mpsc_queue), sizeof(mpsc_queue));
+
+	if (queue == NULL) return NULL;
+
+	queue->recycled = create_mpmc_queue(RECYCLED_NODES, sizeof(queue_node*));
+	// the stub never carries a value, so it is allocated without space for one
+	queue->stub = (queue_node*)malloc(sizeof(queue_node));
+
+	if (queue->recycled == NULL || queue->stub == NULL) {
+		delete_mpmc_queue(&queue->recycled);
+		free(queue->stub);
+		free(queue);
+		return NULL;
+	}
+
+	queue->value_size = value_size;
+	queue->stub->value = NULL;
+	atomic_init(&queue->stub->next, NULL);
+	atomic_init(&queue->head, queue->stub);
+	queue->tail = queue->stub;
+
+	return queue;
+}
+
+void delete_mpsc_queue(mpsc_queue** queue) {
+	if (queue == NULL || *queue == NULL) return;
+
+	mpsc_queue* del = *queue;
+	queue_node* iterator = del->tail;
+
+	while (iterator != NULL) {
+		queue_node* next = atomic_load_explicit(&iterator->next, memory_order_relaxed);
+
+		if (iterator != del->stub) free(iterator);
+		iterator = next;
+	}
+
+	free(del->stub);
+
+	queue_node* node;
+	while (dequeue_mpmc(del->recycled, &node) == 0) free(node);
+
+	delete_mpmc_queue(&del->recycled);
+	free(del);
+	*queue = NULL;
+}
+
+static void push_node(mpsc_queue* queue, queue_node* node) {
+	atomic_store_explicit(&node->next, NULL, memory_order_relaxed);
+
+	queue_node* previous = atomic_exchange_explicit(&queue->head, node, memory_order_acq_rel);
+
+	// until this store the consumer sees the queue end at previous
+	atomic_store_explicit(&previous->next, node, memory_order_release);
+}
+
+static void recycle_node(mpsc_queue* queue, queue_node* node) {
+	if (enqueue_mpmc(queue->recycled, &node) == -1) free(node);
+}
+
+int enqueue_mpsc(mpsc_queue* queue, const void* value) {
+	if (queue == NULL || value == NULL) return -1;
+
+	queue_node* node;
+
+	if (dequeue_mpmc(queue->recycled, &node) == -1) {
+		node = (queue_node*)malloc(sizeof(queue_node) + queue->value_size);
+
+		if (node == NULL) return -1;
+
+		node->value = node->data;
+	}
+
+	memcpy(node->value, value, queue->value_size);
+	push_node(queue, node);
+
+	return 0;
+}
+
+int dequeue_mpsc(mpsc_queue* queue, void* value) {
+	if (queue == NULL || value == NULL) return -1;
+
+	queue_node* tail = queue->tail;
+	queue_node* next = atomic_load_explicit(&tail->next, memory_order_acquire);
+
+	if (tail == queue->stub) {
+		if (next == NULL) return -1;
+
+		queue->tail = next;
+		tail = next;
+		next = atomic_load_explicit(&tail->next, memory_order_acquire);
+	}
+
+	if (next == NULL) {
+		// tail is the last linked node, unless a producer is between exchange and link
+		if (tail != atomic_load_explicit(&queue->head, memory_order_acquire)) return -1;
+
+		// put the stub behind tail so tail can be handed out
+		push_node(queue, queue->stub);
+		next = atomic_load_explicit(&tail->next, memory_order_acquire);
+
+		if (next == NULL) return -1;
+	}
+
+	queue->tail = next;
+	memcpy(value, tail->value, queue->value_size);
+	recycle_node(queue, tail);
+
+	return 0;
+}
@@ -0,0 +1,563 @@
+/*
+MIT License
+
+Copyright (c) 2016 Julius Paffrath
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <radix_tree.h>
+
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+
+static radix_node* create_node(const char* label, size_t label_length) {
+	radix_node* node = (radix_node*)malloc(sizeof(radix_node));
+
+	if (node == NULL) return NULL;
+
+	node->label = (char*)malloc(label_length + 1);
+
+	if (node->label == NULL) {
+		free(node);
+		return NULL;
+	}
+
+	memcpy(node->label, label, label_length);
+	node->label[label_length] = '\0';
+	node->label_length = label_length;
+	node->value = NULL;
+	node->value_size = 0;
+	node->children = NULL;
+	node->next = NULL;
+
+	return node;
+}
+
+static void delete_nodes(radix_node* node) {
+	while (node != NULL) {
+		radix_node* next = node->next;
+
+		delete_nodes(node->children);
+		free(node->label);
+		free(node->value);
+		free(node);
+
+		node = next;
+	}
+}
+
+static radix_node* clone_nodes(const radix_node* node) {
+	radix_node* first = NULL;
+	radix_node** link = &first;
+
+	while (node != NULL) {
+		radix_node* copy = create_node(node->label, node->label_length);
+
+		if (copy == NULL) {
+			delete_nodes(first);
+			return NULL;
+		}
+
+		*link = copy;
+		link = &copy->next;
+
+		if (node->value != NULL) {
+			copy->value = malloc(node->value_size);
+
+			if (copy->value == NULL) {
+				delete_nodes(first);
+				return NULL;
+			}
+
+			memcpy(copy->value, node->value, node->value_size);
+			copy->value_size = node->value_size;
+		}
+
+		if (node->children != NULL) {
+			copy->children = clone_nodes(node->children);
+
+			if (copy->children == NULL) {
+				delete_nodes(first);
+				return NULL;
+			}
+		}
+
+		node = node->next;
+	}
+
+	return first;
+}
+
+static size_t get_common_prefix_length(const char* a, size_t a_length, const char* b) {
+	size_t i = 0;
+
+	while (i < a_length && a[i] == b[i]) i++;
+
+	return i;
+}
+
+// returns the link pointing to the child starting with c, or the link where such a child has to be inserted
+static radix_node** find_child_link(radix_node* node, char c) {
+	radix_node** link = &node->children;
+
+	while (*link != NULL && (unsigned char)(*link)->label[0] < (unsigned char)c) {
+		link = &(*link)->next;
+	}
+
+	return link;
+}
+
+static radix_node* find_node(radix_tree* tree, const char* key) {
+	radix_node* node = tree->root;
+
+	while (*key != '\0') {
+		radix_node* child = *find_child_link(node, *key);
+
+		if (child == NULL || child->label[0] != *key) return NULL;
+		if (strncmp(child->label, key, child->label_length) != 0) return NULL;
+
+		key += child->label_length;
+		node = child;
+	}
+
+	return node;
+}
+
+// merges a node without value into its only child
+static void merge_with_child(radix_node* node) {
+	radix_node* child = node->children;
+	char* label = (char*)malloc(node->label_length + child->label_length + 1);
+
+	if (label == NULL) return;
+
+	memcpy(label, node->label, node->label_length);
+	memcpy(label + node->label_length, child->label, child->label_length + 1);
+
+	free(node->label);
+	node->label = label;
+	node->label_length += child->label_length;
+	node->value = child->value;
+	node->value_size = child->value_size;
+	node->children = child->children;
+
+	free(child->label);
+	free(child);
+}
+
+static int remove_from_node(radix_node* node, const char* key) {
+	radix_node** link = find_child_link(node, *key);
+	radix_node* child = *link;
+
+	if (child == NULL || child->label[0] != *key) return 0;
+	if (strncmp(child->label, key, child->label_length) != 0) return 0;
+
+	key += child->label_length;
+
+	if (*key != '\0') {
+		if (!remove_from_node(child, key)) return 0;
+	}
+	else {
+		if (child->value == NULL) return 0;
+
+		free(child->value);
+		child->value = NULL;
+		child->value_size = 0;
+	}
+
+	if (child->value == NULL) {
+		if (child->children == NULL) {
+			*link = child->next;
+			free(child->label);
+			free(child);
+		}
+		else if (child->children->next == NULL) {
+			merge_with_child(child);
+		}
+	}
+
+	return 1;
+}
+
+static radix_node* next_node(radix_iterator* iterator);
+
+static int push_frame(radix_iterator* iterator, radix_node* node, size_t key_length, int visit_siblings) {
+	if (iterator->stack_size == iterator->stack_capacity) {
+		int capacity = iterator->stack_capacity * 2;
+		radix_frame* stack = (radix_frame*)realloc(iterator->stack, sizeof(radix_frame) * capacity);
+
+		if (stack == NULL) return -1;
+
+		iterator->stack = stack;
+		iterator->stack_capacity = capacity;
+	}
+
+	radix_frame* frame = &iterator->stack[iterator->stack_size++];
+	frame->node = node;
+	frame->key_length = key_length;
+	frame->visit_siblings = visit_siblings;
+
+	return 0;
+}
+
+static int reserve_key(radix_iterator* iterator, size_t length) {
+	if (length + 1 <= iterator->key_capacity) return 0;
+
+	size_t capacity = iterator->key_capacity * 2;
+	while (capacity < length + 1) capacity *= 2;
+
+	char* key = (char*)realloc(iterator->key, capacity);
+
+	if (key == NULL) return -1;
+
+	iterator->key = key;
+	iterator->key_capacity = capacity;
+
+	return 0;
+}
+
+radix_tree* create_radix_tree(void) {
+	radix_tree* tree = (radix_tree*)malloc(sizeof(radix_tree));
+
+	if (tree == NULL) return NULL;
+
+	tree->root = create_node("", 0);
+	tree->entry_count = 0;
+
+	if (tree->root == NULL) {
+		free(tree);
+		return NULL;
+	}
+
+	return tree;
+}
+
+void delete_radix_tree(radix_tree** tree) {
+	if (*tree == NULL) return;
+
+	delete_nodes((*tree)->root);
+	free(*tree);
+
+	*tree = NULL;
+}
+
+radix_tree* clone_radix_tree(radix_tree* tree) {
+	if (tree == NULL) return NULL;
+
+	radix_tree* new_tree = (radix_tree*)malloc(sizeof(radix_tree));
+
+	if (new_tree == NULL) return NULL;
+
+	new_tree->root = clone_nodes(tree->root);
+	new_tree->entry_count = tree->entry_count;
+
+	if (new_tree->root == NULL) {
+		free(new_tree);
+		return NULL;
+	}
+
+	return new_tree;
+}
+
+radix_node* add_radix_entry(radix_tree* tree, const void* value, size_t value_size, const char* key) {
+	if (tree == NULL || value == NULL || value_size <= 0 || key == NULL) return NULL;
+
+	void* new_value = malloc(value_size);
+
+	if (new_value == NULL) return NULL;
+
+	memcpy(new_value, value, value_size);
+
+	radix_node* node = tree->root;
+
+	while (*key != '\0') {
+		radix_node** link = find_child_link(node, *key);
+		radix_node* child = *link;
+
+		if (child == NULL || child->label[0] != *key) {
+			radix_node* leaf = create_node(key, strlen(key));
+
+			if (leaf == NULL) {
+				free(new_value);
+				return NULL;
+			}
+
+			leaf->next = child;
+			*link = leaf;
+			node = leaf;
+			break;
+		}
+
+		size_t common = get_common_prefix_length(child->label, child->label_length, key);
+
+		if (common < child->label_length) {
+			// split the edge at the end of the common prefix
+			radix_node* middle = create_node(child->label, common);
+			char* rest = (char*)malloc(child->label_length - common + 1);
+
+			if (middle == NULL || rest == NULL) {
+				if (middle != NULL) delete_nodes(middle);
+				free(rest);
+				free(new_value);
+				return NULL;
+			}
+
+			memcpy(rest, child->label + common, child->label_length - common + 1);
+			free(child->label);
+			child->label = rest;
+			child->label_length -= common;
+
+			middle->next = child->next;
+			middle->children = child;
+			child->next = NULL;
+			*link = middle;
+			child = middle;
+		}
+
+		key += common;
+		node = child;
+	}
+
+	if (node->value == NULL) tree->entry_count++;
+
+	free(node->value);
+	node->value = new_value;
+	node->value_size = value_size;
+
+	return node;
+}
+
+radix_tree* remove_radix_entry(radix_tree* tree, const char* key) {
+	if (tree == NULL || key == NULL) return NULL;
+
+	if (*key == '\0') {
+		if (tree->root->value == NULL) return NULL;
+
+		free(tree->root->value);
+		tree->root->value = NULL;
+		tree->root->value_size = 0;
+		tree->entry_count--;
+
+		return tree;
+	}
+
+	if (!remove_from_node(tree->root, key)) return NULL;
+
+	tree->entry_count--;
+
+	return tree;
+}
+
+void* get_radix_entry(radix_tree* tree, const char* key) {
+	if (tree == NULL || key == NULL) return NULL;
+
+	radix_node* node = find_node(tree, key);
+
+	if (node == NULL) return NULL;
+
+	return node->value;
+}
+
+int get_number_of_radix_entries(radix_tree* tree) {
+	if (tree == NULL) return -1;
+
+	return tree->entry_count;
+}
+
+int contains_radix_key(radix_tree* tree, const char* key) {
+	if (tree == NULL || key == NULL) return -1;
+
+	return get_radix_entry(tree, key) != NULL;
+}
+
+element* get_radix_keys(radix_tree* tree) {
+	radix_iterator* iterator = create_radix_iterator(tree, "");
+
+	if (iterator == NULL) return NULL;
+
+	element* list = NULL;
+	element* last = NULL;
+	const char* key;
+
+	while (next_radix_entry(iterator, &key, NULL)) {
+		element* e = create_list(key, strlen(key) + 1);
+
+		if (e == NULL) {
+			delete_list(&list);
+			break;
+		}
+
+		if (last == NULL) list = e;
+		else last->next = e;
+
+		last = e;
+	}
+
+	delete_radix_iterator(&iterator);
+
+	return list;
+}
+
+entry* get_entries_with_prefix(radix_tree* tree, const char* prefix) {
+	radix_iterator* iterator = create_radix_iterator(tree, prefix);
+
+	if (iterator == NULL) return NULL;
+
+	entry* dictionary = NULL;
+	entry* last = NULL;
+	radix_node* node;
+
+	while ((node = next_node(iterator)) != NULL) {
+		entry* e = create_dictionary(node->value, node->value_size, iterator->key);
+
+		if (e == NULL) {
+			delete_dictionary(&dictionary);
+			break;
+		}
+
+		if (last == NULL) dictionary = e;
+		else last->next = e;
+
+		last = e;
+	}
+
+	delete_radix_iterator(&iterator);
+
+	return dictionary;
+}
+
+radix_iterator* create_radix_iterator(radix_tree* tree, const char* prefix) {
+	if (tree == NULL || prefix == NULL) return NULL;
+
+	radix_iterator* iterator = (radix_iterator*)malloc(sizeof(radix_iterator));
+
+	if (iterator == NULL) return NULL;
+
+	iterator->stack_size = 0;
+	iterator->stack_capacity = 16;
+	iterator->stack = (radix_frame*)malloc(sizeof(radix_frame) * iterator->stack_capacity);
+	iterator->key_capacity = 64;
+	iterator->key = (char*)malloc(iterator->key_capacity);
+
+	if (iterator->stack == NULL || iterator->key == NULL) {
+		delete_radix_iterator(&iterator);
+		return NULL;
+	}
+
+	// descend to the node whose path covers the prefix, collecting the path as key
+	radix_node* node = tree->root;
+	const char* rest = prefix;
+	size_t key_length = 0;
+
+	while (*rest != '\0') {
+		radix_node* child = *find_child_link(node, *rest);
+
+		if (child == NULL || child->label[0] != *rest) return iterator;
+
+		size_t common = get_common_prefix_length(child->label, child->label_length, rest);
+
+		if (rest[common] != '\0' && common < child->label_length) return iterator;
+
+		rest += common;
+		node = child;
+
+		if (*rest != '\0') {
+			if (reserve_key(iterator, key_length + child->label_length) != 0) {
+				delete_radix_iterator(&iterator);
+				return NULL;
+			}
+
+			memcpy(iterator->key + key_length, child->label, child->label_length);
+			key_length += child->label_length;
+		}
+	}
+
+	push_frame(iterator, node, key_length, 0);
+
+	return iterator;
+}
+
+static radix_node* next_node(radix_iterator* iterator) {
+	while (iterator->stack_size > 0) {
+		radix_frame frame = iterator->stack[--iterator->stack_size];
+		radix_node* node = frame.node;
+		size_t key_length = frame.key_length + node->label_length;
+
+		if (reserve_key(iterator, key_length) != 0) return NULL;
+
+		memcpy(iterator->key + frame.key_length, node->label, node->label_length);
+		iterator->key[key_length] = '\0';
+
+		// siblings are pushed first so that the children are visited before them
+		if (frame.visit_siblings && node->next != NULL) {
+			if (push_frame(iterator, node->next, frame.key_length, 1) != 0) return NULL;
+		}
+
+		if (node->children != NULL) {
+			if (push_frame(iterator, node->children, key_length, 1) != 0) return NULL;
+		}
+
+		if (node->value != NULL) return node;
+	}
+
+	return NULL;
+}
+
+int next_radix_entry(radix_iterator* iterator, const char** key, void** value) {
+	if (iterator == NULL) return 0;
+
+	radix_node* node = next_node(iterator);
+
+	if (node == NULL) return 0;
+
+	if (key != NULL) *key = iterator->key;
+	if (value != NULL) *value = node->value;
+
+	return 1;
+}
+
+void delete_radix_iterator(radix_iterator** iterator) {
+	if (*iterator == NULL) return;
+
+	free((*iterator)->stack);
+	free((*iterator)->key);
+	free(*iterator);
+
+	*iterator = NULL;
+}
+
+void print_radix_tree(radix_tree* tree) {
+	radix_iterator* iterator = create_radix_iterator(tree, "");
+
+	if (iterator == NULL) return;
+
+	const char* key;
+	void* value;
+
+	puts("***");
+
+	while (next_radix_entry(iterator, &key, &value)) {
+		printf("\t%s -> %s\n", key, (char*)value);
+	}
+
+	puts("***");
+
+	delete_radix_iterator(&iterator);
+}
@@ -0,0 +1,295 @@
+/*
+MIT License
+
+Copyright (c) 2016 Julius Paffrath
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <rcu_dictionary.h>
+#include <hash.h>
+
+#include "epoch.h"
+
+#include <string.h>
+#include <stdlib.h>
+
+#define INITIAL_BUCKET_COUNT 16
+
+static rcu_table* create_table(size_t bucket_count) {
+	rcu_table* table = (rcu_table*)malloc(sizeof(rcu_table) + bucket_count * sizeof(_Atomic(rcu_entry*)));
+
+	if (table == NULL) return NULL;
+
+	table->bucket_count = bucket_count;
+
+	size_t i;
+	for (i = 0; i < bucket_count; i++) {
+		atomic_init(&table->buckets[i], NULL);
+	}
+
+	return table;
+}
+
+static rcu_entry* create_entry(const void* value, size_t value_size, const char* key, size_t key_len, uint64_t hash) {
+	// key and value are stored in the same allocation as the entry for read locality
+	size_t value_offset = (key_len + 1 + _Alignof(max_align_t) - 1) & ~(_Alignof(max_align_t) - 1);
+	rcu_entry* e = (rcu_entry*)malloc(sizeof(rcu_entry) + value_offset + value_size);
+
+	if (e == NULL) return NULL;
+
+	atomic_init(&e->next, NULL);
+	e->hash = hash;
+	e->value_size = value_size;
+	e->key = e->data;
+	e->value = e->data + value_offset;
+
+	memcpy(e->key, key, key_len + 1);
+	memcpy(e->value, value, value_size);
+
+	return e;
+}
+
+static rcu_entry* copy_entry(const rcu_entry* e) {
+	return create_entry(e->value, e->value_size, e->key, strlen(e->key), e->hash);
+}
+
+static void free_table(void* table) {
+	free(table);
+}
+
+static void free_entry(void* e) {
+	free(e);
+}
+
+static _Atomic(rcu_entry*)* get_bucket(rcu_table* table, uint64_t hash) {
+	return &table->buckets[hash & (table->bucket_count - 1)];
+}
+
+static rcu_entry* find_entry(rcu_table* table, uint64_t hash, const char* key) {
+	rcu_entry* iterator = atomic_load_explicit(get_bucket(table, hash), memory_order_acquire);
+
+	while (iterator != NULL) {
+		if (iterator->hash == hash && strcmp(iterator->key, key) == 0) return iterator;
+		iterator = atomic_load_explicit(&iterator->next, memory_order_acquire);
+	}
+
+	return NULL;
+}
+
+static void grow_table(rcu_dictionary* dictionary, rcu_table* table) {
+	rcu_table* new_table = create_table(table->bucket_count * 2);
+
+	if (new_table == NULL) return;
+
+	// readers may still walk the old chains, so the entries are copied instead of relinked
+	size_t i;
+	for (i = 0; i < table->bucket_count; i++) {
+		rcu_entry* iterator = atomic_load_explicit(&table->buckets[i], memory_order_relaxed);
+
+		while (iterator != NULL) {
+			rcu_entry* copy = copy_entry(iterator);
+
+			if (copy == NULL) {
+				size_t j;
+				for (j = 0; j < new_table->bucket_count; j++) {
+					rcu_entry* del = atomic_load_explicit(&new_table->buckets[j], memory_order_relaxed);
+
+					while (del != NULL) {
+						rcu_entry* next = atomic_load_explicit(&del->next, memory_order_relaxed);
+						free(del);
+						del = next;
+					}
+				}
+
+				free(new_table);
+				return;
+			}
+
+			_Atomic(rcu_entry*)* bucket = get_bucket(new_table, copy->hash);
+			atomic_store_explicit(&copy->next, atomic_load_explicit(bucket, memory_order_relaxed), memory_order_relaxed);
+			atomic_store_explicit(bucket, copy, memory_order_relaxed);
+
+			iterator = atomic_load_explicit(&iterator->next, memory_order_relaxed);
+		}
+	}
+
+	atomic_store_explicit(&dictionary->table, new_table, memory_order_release);
+
+	for (i = 0; i < table->bucket_count; i++) {
+		rcu_entry* iterator = atomic_load_explicit(&table->buckets[i], memory_order_relaxed);
+
+		while (iterator != NULL) {
+			rcu_entry* next = atomic_load_explicit(&iterator->next, memory_order_relaxed);
+			retire_epoch(dictionary->epoch, iterator, free_entry);
+			iterator = next;
+		}
+	}
+
+	retire_epoch(dictionary->epoch, table, free_table);
+}
+
+rcu_dictionary* create_rcu_dictionary(void) {
+	rcu_dictionary* dictionary = (rcu_dictionary*)aligned_alloc(_Alignof(rcu_dictionary), sizeof(rcu_dictionary));
+
+	if (dictionary == NULL) return NULL;
+
+	rcu_table* table = create_table(INITIAL_BUCKET_COUNT);
+	dictionary->epoch = create_epoch_domain();
+
+	if (table == NULL || dictionary->epoch == NULL || pthread_mutex_init(&dictionary->writer_lock, NULL) != 0) {
+		free(table);
+		delete_epoch_domain(&dictionary->epoch);
+		free(dictionary);
+		return NULL;
+	}
+
+	atomic_init(&dictionary->table, table);
+	atomic_init(&dictionary->entry_count, 0);
+	dictionary->key_hasher = get_default_hasher();
+
+	return dictionary;
+}
+
+void delete_rcu_dictionary(rcu_dictionary** dictionary) {
+	if (*dictionary == NULL) return;
+
+	rcu_dictionary* del = *dictionary;
+	rcu_table* table = atomic_load(&del->table);
+
+	size_t i;
+	for (i = 0; i < table->bucket_count; i++) {
+		rcu_entry* iterator = atomic_load_explicit(&table->buckets[i], memory_order_relaxed);
+
+		while (iterator != NULL) {
+			rcu_entry* next = atomic_load_explicit(&iterator->next, memory_order_relaxed);
+			free(iterator);
+			iterator = next;
+		}
+	}
+
+	free(table);
+	delete_epoch_domain(&del->epoch);
+	pthread_mutex_destroy(&del->writer_lock);
+	free(del);
+
+	*dictionary = NULL;
+}
+
+int add_rcu_entry(rcu_dictionary* dictionary, const void* value, size_t value_size, const char* key) {
+	if (dictionary == NULL || value == NULL || value_size <= 0 || key == NULL) return -1;
+
+	size_t key_len = strlen(key);
+	uint64_t hash = hash_key_with(&dictionary->key_hasher, key, key_len);
+	rcu_entry* e = create_entry(value, value_size, key, key_len, hash);
+
+	if (e == NULL) return -1;
+
+	pthread_mutex_lock(&dictionary->writer_lock);
+
+	rcu_table* table = atomic_load_explicit(&dictionary->table, memory_order_relaxed);
+	_Atomic(rcu_entry*)* link = get_bucket(table, hash);
+	rcu_entry* iterator;
+
+	while ((iterator = atomic_load_explicit(link, memory_order_relaxed)) != NULL) {
+		if (iterator->hash == hash && strcmp(iterator->key, key) == 0) {
+			atomic_store_explicit(&e->next, atomic_load_explicit(&iterator->next, memory_order_relaxed), memory_order_relaxed);
+			atomic_store_explicit(link, e, memory_order_release);
+			retire_epoch(dictionary->epoch, iterator, free_entry);
+
+			pthread_mutex_unlock(&dictionary->writer_lock);
+			return 0;
+		}
+
+		link = &iterator->next;
+	}
+
+	_Atomic(rcu_entry*)* bucket = get_bucket(table, hash);
+	atomic_store_explicit(&e->next, atomic_load_explicit(bucket, memory_order_relaxed), memory_order_relaxed);
+	atomic_store_explicit(bucket, e, memory_order_release);
+
+	int count = atomic_fetch_add_explicit(&dictionary->entry_count, 1, memory_order_relaxed) + 1;
+
+	if ((size_t)count > table->bucket_count) grow_table(dictionary, table);
+
+	pthread_mutex_unlock(&dictionary->writer_lock);
+
+	return 0;
+}
+
+int remove_rcu_entry(rcu_dictionary* dictionary, const char* key) {
+	if (dictionary == NULL || key == NULL) return -1;
+
+	uint64_t hash = hash_key_with(&dictionary->key_hasher, key, strlen(key));
+
+	pthread_mutex_lock(&dictionary->writer_lock);
+
+	rcu_table* table = atomic_load_explicit(&dictionary->table, memory_order_relaxed);
+	_Atomic(rcu_entry*)* link = get_bucket(table, hash);
+	rcu_entry* iterator;
+
+	while ((iterator = atomic_load_explicit(link, memory_order_relaxed)) != NULL) {
+		if (iterator->hash == hash && strcmp(iterator->key, key) == 0) {
+			atomic_store_explicit(link, atomic_load_explicit(&iterator->next, memory_order_relaxed), memory_order_release);
+			atomic_fetch_sub_explicit(&dictionary->entry_count, 1, memory_order_relaxed);
+			retire_epoch(dictionary->epoch, iterator, free_entry);
+
+			pthread_mutex_unlock(&dictionary->writer_lock);
+			return 0;
+		}
+
+		link = &iterator->next;
+	}
+
+	pthread_mutex_unlock(&dictionary->writer_lock);
+
+	return -1;
+}
+
+int get_rcu_entry(rcu_dictionary* dictionary, const char* key, void* value, size_t value_size) {
+	if (dictionary == NULL || key == NULL) return -1;
+
+	uint64_t hash = hash_key_with(&dictionary->key_hasher, key, strlen(key));
+	int slot = enter_epoch(dictionary->epoch);
+
+	rcu_table* table = atomic_load_explicit(&dictionary->table, memory_order_acquire);
+	rcu_entry* e = find_entry(table, hash, key);
+	int result = -1;
+
+	if (e != NULL) {
+		if (value != NULL) memcpy(value, e->value, value_size < e->value_size ? value_size : e->value_size);
+		result = (int)e->value_size;
+	}
+
+	leave_epoch(dictionary->epoch, slot);
+
+	return result;
+}
+
+int get_number_of_rcu_entries(rcu_dictionary* dictionary) {
+	if (dictionary == NULL) return -1;
+
+	return atomic_load_explicit(&dictionary->entry_count, memory_order_relaxed);
+}
+
+int contains_rcu_key(rcu_dictionary* dictionary, const char* key) {
+	if (dictionary == NULL || key == NULL) return -1;
+
+	return get_rcu_entry(dictionary, key, NULL, 0) == -1 ? 0 : 1;
+}
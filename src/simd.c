@@ -0,0 +1,1007 @@
+/*
+MIT License
+
+Copyright (c) 2016 Julius Paffrath
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <simd.h>
+
+#include <limits.h>
+#include <stdint.h>
+#include <math.h>
+#include <pthread.h>
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#include <immintrin.h>
+#define HAVE_AVX2_DISPATCH
+#endif
+
+struct simd_kernels {
+	int (*find_int)(const int* values, int count, int value);
+	int (*count_int)(const int* values, int count, int value);
+	int (*min_int)(const int* values, int count);
+	int (*max_int)(const int* values, int count);
+	long long (*sum_int)(const int* values, int count);
+	int (*filter_int)(const int* values, int count, int low, int high, int* result);
+	int (*find_double)(const double* values, int count, double value);
+	int (*count_double)(const double* values, int count, double value);
+	double (*min_double)(const double* values, int count);
+	double (*max_double)(const double* values, int count);
+	double (*sum_double)(const double* values, int count);
+	int (*filter_double)(const double* values, int count, double low, double high, double* result);
+	double (*dot_double)(const double* first, const double* second, int count);
+	double (*deviation_double)(const double* values, int count, double center);
+	void (*histogram_double)(const double* values, int count, double low, double high, int bins, int* counts);
+	int (*find_char)(const char* values, int count, char value);
+	int (*count_char)(const char* values, int count, char value);
+	char (*min_char)(const char* values, int count);
+	char (*max_char)(const char* values, int count);
+	long long (*sum_char)(const char* values, int count);
+	int (*filter_char)(const char* values, int count, char low, char high, char* result);
+};
+
+typedef struct simd_kernels simd_kernels;
+
+static simd_kernels kernels;
+static pthread_once_t kernels_once = PTHREAD_ONCE_INIT;
+
+/*
+* Portable kernels, also used by the vectorized ones for the values
+* which do not fill a whole vector. min and max expect count > 0.
+*/
+
+static int find_int_portable(const int* values, int count, int value) {
+	int i;
+	for (i = 0; i < count; i++) {
+		if (values[i] == value) return i;
+	}
+
+	return -1;
+}
+
+static int count_int_portable(const int* values, int count, int value) {
+	int found = 0;
+
+	int i;
+	for (i = 0; i < count; i++) {
+		found += values[i] == value;
+	}
+
+	return found;
+}
+
+static int min_int_portable(const int* values, int count) {
+	int min = values[0];
+
+	int i;
+	for (i = 1; i < count; i++) {
+		if (values[i] < min) min = values[i];
+	}
+
+	return min;
+}
+
+static int max_int_portable(const int* values, int count) {
+	int max = values[0];
+
+	int i;
+	for (i = 1; i < count; i++) {
+		if (values[i] > max) max = values[i];
+	}
+
+	return max;
+}
+
+static long long sum_int_portable(const int* values, int count) {
+	long long sum = 0;
+
+	int i;
+	for (i = 0; i < count; i++) {
+		sum += values[i];
+	}
+
+	return sum;
+}
+
+static int filter_int_portable(const int* values, int count, int low, int high, int* result) {
+	int written = 0;
+
+	int i;
+	for (i = 0; i < count; i++) {
+		if (values[i] >= low && values[i] <= high) result[written++] = values[i];
+	}
+
+	return written;
+}
+
+static int find_double_portable(const double* values, int count, double value) {
+	int i;
+	for (i = 0; i < count; i++) {
+		if (values[i] == value) return i;
+	}
+
+	return -1;
+}
+
+static int count_double_portable(const double* values, int count, double value) {
+	int found = 0;
+
+	int i;
+	for (i = 0; i < count; i++) {
+		found += values[i] == value;
+	}
+
+	return found;
+}
+
+static double min_double_portable(const double* values, int count) {
+	double min = values[0];
+
+	int i;
+	for (i = 1; i < count; i++) {
+		if (values[i] < min) min = values[i];
+	}
+
+	return min;
+}
+
+static double max_double_portable(const double* values, int count) {
+	double max = values[0];
+
+	int i;
+	for (i = 1; i < count; i++) {
+		if (values[i] > max) max = values[i];
+	}
+
+	return max;
+}
+
+static double sum_double_portable(const double* values, int count) {
+	double sum = 0.0;
+
+	int i;
+	for (i = 0; i < count; i++) {
+		sum += values[i];
+	}
+
+	return sum;
+}
+
+static int filter_double_portable(const double* values, int count, double low, double high, double* result) {
+	int written = 0;
+
+	int i;
+	for (i = 0; i < count; i++) {
+		if (values[i] >= low && values[i] <= high) result[written++] = values[i];
+	}
+
+	return written;
+}
+
+static double dot_double_portable(const double* first, const double* second, int count) {
+	double sum = 0.0;
+
+	int i;
+	for (i = 0; i < count; i++) {
+		sum += first[i] * second[i];
+	}
+
+	return sum;
+}
+
+static double deviation_double_portable(const double* values, int count, double center) {
+	double sum = 0.0;
+
+	int i;
+	for (i = 0; i < count; i++) {
+		double difference = values[i] - center;
+		sum += difference * difference;
+	}
+
+	return sum;
+}
+
+static void histogram_double_portable(const double* values, int count, double low, double high, int bins, int* counts) {
+	double scale = bins / (high - low);
+
+	int i;
+	for (i = 0; i < count; i++) {
+		if (!(values[i] >= low && values[i] <= high)) continue;
+
+		int bin = (int)((values[i] - low) * scale);
+		counts[bin < bins ? bin : bins - 1]++;
+	}
+}
+
+static int find_char_portable(const char* values, int count, char value) {
+	int i;
+	for (i = 0; i < count; i++) {
+		if (values[i] == value) return i;
+	}
+
+	return -1;
+}
+
+static int count_char_portable(const char* values, int count, char value) {
+	int found = 0;
+
+	int i;
+	for (i = 0; i < count; i++) {
+		found += values[i] == value;
+	}
+
+	return found;
+}
+
+static char min_char_portable(const char* values, int count) {
+	char min = values[0];
+
+	int i;
+	for (i = 1; i < count; i++) {
+		if (values[i] < min) min = values[i];
+	}
+
+	return min;
+}
+
+static char max_char_portable(const char* values, int count) {
+	char max = values[0];
+
+	int i;
+	for (i = 1; i < count; i++) {
+		if (values[i] > max) max = values[i];
+	}
+
+	return max;
+}
+
+static long long sum_char_portable(const char* values, int count) {
+	long long sum = 0;
+
+	int i;
+	for (i = 0; i < count; i++) {
+		sum += values[i];
+	}
+
+	return sum;
+}
+
+static int filter_char_portable(const char* values, int count, char low, char high, char* result) {
+	int written = 0;
+
+	int i;
+	for (i = 0; i < count; i++) {
+		if (values[i] >= low && values[i] <= high) result[written++] = values[i];
+	}
+
+	return written;
+}
+
+#ifdef HAVE_AVX2_DISPATCH
+
+// lane permutations moving the selected lanes of a vector to its front, indexed by the lane mask
+static int32_t compress_int_table[256][8];
+static int32_t compress_double_table[16][8];
+
+static void init_compress_tables(void) {
+	int mask;
+	for (mask = 0; mask < 256; mask++) {
+		int lanes = 0;
+
+		int lane;
+		for (lane = 0; lane < 8; lane++) {
+			if (mask & (1 << lane)) compress_int_table[mask][lanes++] = lane;
+		}
+
+		while (lanes < 8) compress_int_table[mask][lanes++] = 0;
+	}
+
+	for (mask = 0; mask < 16; mask++) {
+		int lanes = 0;
+
+		int lane;
+		for (lane = 0; lane < 4; lane++) {
+			if (mask & (1 << lane)) {
+				compress_double_table[mask][lanes++] = lane * 2;
+				compress_double_table[mask][lanes++] = lane * 2 + 1;
+			}
+		}
+
+		while (lanes < 8) compress_double_table[mask][lanes++] = 0;
+	}
+}
+
+__attribute__((target("avx2")))
+static int find_int_avx2(const int* values, int count, int value) {
+	__m256i needle = _mm256_set1_epi32(value);
+
+	int i = 0;
+	for (; i + 32 <= count; i += 32) {
+		__m256i a = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i*)(values + i)), needle);
+		__m256i b = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i*)(values + i + 8)), needle);
+		__m256i c = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i*)(values + i + 16)), needle);
+		__m256i d = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i*)(values + i + 24)), needle);
+
+		// one test for four vectors, the exact lane is searched only after a hit
+		__m256i any = _mm256_or_si256(_mm256_or_si256(a, b), _mm256_or_si256(c, d));
+
+		if (!_mm256_testz_si256(any, any)) break;
+	}
+
+	for (; i + 8 <= count; i += 8) {
+		__m256i hits = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i*)(values + i)), needle);
+		int mask = _mm256_movemask_ps(_mm256_castsi256_ps(hits));
+
+		if (mask != 0) return i + __builtin_ctz(mask);
+	}
+
+	int tail = find_int_portable(values + i, count - i, value);
+
+	return tail == -1 ? -1 : i + tail;
+}
+
+__attribute__((target("avx2")))
+static int count_int_avx2(const int* values, int count, int value) {
+	__m256i needle = _mm256_set1_epi32(value);
+	__m256i found = _mm256_setzero_si256();
+
+	// a match compares to -1, subtracting it counts per lane
+	int i = 0;
+	for (; i + 8 <= count; i += 8) {
+		__m256i hits = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i*)(values + i)), needle);
+		found = _mm256_sub_epi32(found, hits);
+	}
+
+	int32_t lanes[8];
+	_mm256_storeu_si256((__m256i*)lanes, found);
+
+	int total = count_int_portable(values + i, count - i, value);
+
+	int lane;
+	for (lane = 0; lane < 8; lane++) {
+		total += lanes[lane];
+	}
+
+	return total;
+}
+
+__attribute__((target("avx2")))
+static int min_int_avx2(const int* values, int count) {
+	if (count < 8) return min_int_portable(values, count);
+
+	__m256i min = _mm256_loadu_si256((const __m256i*)values);
+
+	int i = 8;
+	for (; i + 8 <= count; i += 8) {
+		min = _mm256_min_epi32(min, _mm256_loadu_si256((const __m256i*)(values + i)));
+	}
+
+	int32_t lanes[8];
+	_mm256_storeu_si256((__m256i*)lanes, min);
+
+	int result = min_int_portable(lanes, 8);
+
+	if (i < count) {
+		int tail = min_int_portable(values + i, count - i);
+		if (tail < result) result = tail;
+	}
+
+	return result;
+}
+
+__attribute__((target("avx2")))
+static int max_int_avx2(const int* values, int count) {
+	if (count < 8) return max_int_portable(values, count);
+
+	__m256i max = _mm256_loadu_si256((const __m256i*)values);
+
+	int i = 8;
+	for (; i + 8 <= count; i += 8) {
+		max = _mm256_max_epi32(max, _mm256_loadu_si256((const __m256i*)(values + i)));
+	}
+
+	int32_t lanes[8];
+	_mm256_storeu_si256((__m256i*)lanes, max);
+
+	int result = max_int_portable(lanes, 8);
+
+	if (i < count) {
+		int tail = max_int_portable(values + i, count - i);
+		if (tail > result) result = tail;
+	}
+
+	return result;
+}
+
+__attribute__((target("avx2")))
+static long long sum_int_avx2(const int* values, int count) {
+	__m256i sum = _mm256_setzero_si256();
+
+	// widened to 64 bit lanes, no partial sum can overflow
+	int i = 0;
+	for (; i + 8 <= count; i += 8) {
+		__m256i v = _mm256_loadu_si256((const __m256i*)(values + i));
+		sum = _mm256_add_epi64(sum, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(v)));
+		sum = _mm256_add_epi64(sum, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(v, 1)));
+	}
+
+	long long lanes[4];
+	_mm256_storeu_si256((__m256i*)lanes, sum);
+
+	return lanes[0] + lanes[1] + lanes[2] + lanes[3] + sum_int_portable(values + i, count - i);
+}
+
+__attribute__((target("avx2")))
+static int filter_int_avx2(const int* values, int count, int low, int high, int* result) {
+	__m256i lower = _mm256_set1_epi32(low);
+	__m256i upper = _mm256_set1_epi32(high);
+	int written = 0;
+
+	// a whole vector is stored, written + 8 never exceeds i + 8 <= count
+	int i = 0;
+	for (; i + 8 <= count; i += 8) {
+		__m256i v = _mm256_loadu_si256((const __m256i*)(values + i));
+		__m256i outside = _mm256_or_si256(_mm256_cmpgt_epi32(lower, v), _mm256_cmpgt_epi32(v, upper));
+		int mask = ~_mm256_movemask_ps(_mm256_castsi256_ps(outside)) & 0xff;
+		__m256i permutation = _mm256_loadu_si256((const __m256i*)compress_int_table[mask]);
+
+		_mm256_storeu_si256((__m256i*)(result + written), _mm256_permutevar8x32_epi32(v, permutation));
+		written += __builtin_popcount(mask);
+	}
+
+	return written + filter_int_portable(values + i, count - i, low, high, result + written);
+}
+
+__attribute__((target("avx2")))
+static int find_double_avx2(const double* values, int count, double value) {
+	__m256d needle = _mm256_set1_pd(value);
+
+	int i = 0;
+	for (; i + 4 <= count; i += 4) {
+		__m256d hits = _mm256_cmp_pd(_mm256_loadu_pd(values + i), needle, _CMP_EQ_OQ);
+		int mask = _mm256_movemask_pd(hits);
+
+		if (mask != 0) return i + __builtin_ctz(mask);
+	}
+
+	int tail = find_double_portable(values + i, count - i, value);
+
+	return tail == -1 ? -1 : i + tail;
+}
+
+__attribute__((target("avx2")))
+static int count_double_avx2(const double* values, int count, double value) {
+	__m256d needle = _mm256_set1_pd(value);
+	__m256i found = _mm256_setzero_si256();
+
+	int i = 0;
+	for (; i + 4 <= count; i += 4) {
+		__m256d hits = _mm256_cmp_pd(_mm256_loadu_pd(values + i), needle, _CMP_EQ_OQ);
+		found = _mm256_sub_epi64(found, _mm256_castpd_si256(hits));
+	}
+
+	long long lanes[4];
+	_mm256_storeu_si256((__m256i*)lanes, found);
+
+	return (int)(lanes[0] + lanes[1] + lanes[2] + lanes[3]) + count_double_portable(values + i, count - i, value);
+}
+
+__attribute__((target("avx2")))
+static double min_double_avx2(const double* values, int count) {
+	if (count < 4) return min_double_portable(values, count);
+
+	__m256d min = _mm256_loadu_pd(values);
+
+	int i = 4;
+	for (; i + 4 <= count; i += 4) {
+		min = _mm256_min_pd(min, _mm256_loadu_pd(values + i));
+	}
+
+	double lanes[4];
+	_mm256_storeu_pd(lanes, min);
+
+	double result = min_double_portable(lanes, 4);
+
+	if (i < count) {
+		double tail = min_double_portable(values + i, count - i);
+		if (tail < result) result = tail;
+	}
+
+	return result;
+}
+
+__attribute__((target("avx2")))
+static double max_double_avx2(const double* values, int count) {
+	if (count < 4) return max_double_portable(values, count);
+
+	__m256d max = _mm256_loadu_pd(values);
+
+	int i = 4;
+	for (; i + 4 <= count; i += 4) {
+		max = _mm256_max_pd(max, _mm256_loadu_pd(values + i));
+	}
+
+	double lanes[4];
+	_mm256_storeu_pd(lanes, max);
+
+	double result = max_double_portable(lanes, 4);
+
+	if (i < count) {
+		double tail = max_double_portable(values + i, count - i);
+		if (tail > result) result = tail;
+	}
+
+	return result;
+}
+
+__attribute__((target("avx2")))
+static double sum_double_avx2(const double* values, int count) {
+	// two accumulators hide the latency of the additions
+	__m256d first = _mm256_setzero_pd();
+	__m256d second = _mm256_setzero_pd();
+
+	int i = 0;
+	for (; i + 8 <= count; i += 8) {
+		first = _mm256_add_pd(first, _mm256_loadu_pd(values + i));
+		second = _mm256_add_pd(second, _mm256_loadu_pd(values + i + 4));
+	}
+
+	double lanes[4];
+	_mm256_storeu_pd(lanes, _mm256_add_pd(first, second));
+
+	return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]) + sum_double_portable(values + i, count - i);
+}
+
+__attribute__((target("avx2")))
+static int filter_double_avx2(const double* values, int count, double low, double high, double* result) {
+	__m256d lower = _mm256_set1_pd(low);
+	__m256d upper = _mm256_set1_pd(high);
+	int written = 0;
+
+	int i = 0;
+	for (; i + 4 <= count; i += 4) {
+		__m256d v = _mm256_loadu_pd(values + i);
+		__m256d inside = _mm256_and_pd(_mm256_cmp_pd(v, lower, _CMP_GE_OQ), _mm256_cmp_pd(v, upper, _CMP_LE_OQ));
+		int mask = _mm256_movemask_pd(inside);
+		__m256i permutation = _mm256_loadu_si256((const __m256i*)compress_double_table[mask]);
+		__m256 compressed = _mm256_permutevar8x32_ps(_mm256_castpd_ps(v), permutation);
+
+		_mm256_storeu_pd(result + written, _mm256_castps_pd(compressed));
+		written += __builtin_popcount(mask);
+	}
+
+	return written + filter_double_portable(values + i, count - i, low, high, result + written);
+}
+
+__attribute__((target("avx2")))
+static double dot_double_avx2(const double* first, const double* second, int count) {
+	__m256d a = _mm256_setzero_pd();
+	__m256d b = _mm256_setzero_pd();
+
+	int i = 0;
+	for (; i + 8 <= count; i += 8) {
+		a = _mm256_add_pd(a, _mm256_mul_pd(_mm256_loadu_pd(first + i), _mm256_loadu_pd(second + i)));
+		b = _mm256_add_pd(b, _mm256_mul_pd(_mm256_loadu_pd(first + i + 4), _mm256_loadu_pd(second + i + 4)));
+	}
+
+	double lanes[4];
+	_mm256_storeu_pd(lanes, _mm256_add_pd(a, b));
+
+	return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]) + dot_double_portable(first + i, second + i, count - i);
+}
+
+__attribute__((target("avx2")))
+static double deviation_double_avx2(const double* values, int count, double center) {
+	__m256d centers = _mm256_set1_pd(center);
+	__m256d a = _mm256_setzero_pd();
+	__m256d b = _mm256_setzero_pd();
+
+	int i = 0;
+	for (; i + 8 <= count; i += 8) {
+		__m256d x = _mm256_sub_pd(_mm256_loadu_pd(values + i), centers);
+		__m256d y = _mm256_sub_pd(_mm256_loadu_pd(values + i + 4), centers);
+		a = _mm256_add_pd(a, _mm256_mul_pd(x, x));
+		b = _mm256_add_pd(b, _mm256_mul_pd(y, y));
+	}
+
+	double lanes[4];
+	_mm256_storeu_pd(lanes, _mm256_add_pd(a, b));
+
+	return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]) + deviation_double_portable(values + i, count - i, center);
+}
+
+__attribute__((target("avx2")))
+static void histogram_double_avx2(const double* values, int count, double low, double high, int bins, int* counts) {
+	__m256d lower = _mm256_set1_pd(low);
+	__m256d upper = _mm256_set1_pd(high);
+	__m256d scale = _mm256_set1_pd(bins / (high - low));
+	__m128i last = _mm_set1_epi32(bins - 1);
+
+	// the bins are computed four at a time, only the increments are scalar
+	int i = 0;
+	for (; i + 4 <= count; i += 4) {
+		__m256d v = _mm256_loadu_pd(values + i);
+		__m256d inside = _mm256_and_pd(_mm256_cmp_pd(v, lower, _CMP_GE_OQ), _mm256_cmp_pd(v, upper, _CMP_LE_OQ));
+		int mask = _mm256_movemask_pd(inside);
+
+		if (mask == 0) continue;
+
+		__m128i index = _mm_min_epi32(_mm256_cvttpd_epi32(_mm256_mul_pd(_mm256_sub_pd(v, lower), scale)), last);
+
+		int32_t lanes[4];
+		_mm_storeu_si128((__m128i*)lanes, index);
+
+		while (mask != 0) {
+			counts[lanes[__builtin_ctz(mask)]]++;
+			mask &= mask - 1;
+		}
+	}
+
+	histogram_double_portable(values + i, count - i, low, high, bins, counts);
+}
+
+// flips the sign bit of unsigned chars so the signed byte instructions order them correctly
+#if CHAR_MIN < 0
+#define CHAR_BIAS 0
+#else
+#define CHAR_BIAS 0x80
+#endif
+
+__attribute__((target("avx2")))
+static int find_char_avx2(const char* values, int count, char value) {
+	__m256i needle = _mm256_set1_epi8(value);
+
+	int i = 0;
+	for (; i + 32 <= count; i += 32) {
+		__m256i hits = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(values + i)), needle);
+		unsigned mask = (unsigned)_mm256_movemask_epi8(hits);
+
+		if (mask != 0) return i + __builtin_ctz(mask);
+	}
+
+	int tail = find_char_portable(values + i, count - i, value);
+
+	return tail == -1 ? -1 : i + tail;
+}
+
+__attribute__((target("avx2")))
+static int count_char_avx2(const char* values, int count, char value) {
+	__m256i needle = _mm256_set1_epi8(value);
+	__m256i zero = _mm256_setzero_si256();
+	__m256i total = _mm256_setzero_si256();
+
+	int i = 0;
+	while (i + 32 <= count) {
+		// byte counters are folded into 64 bit lanes before they can overflow
+		__m256i found = _mm256_setzero_si256();
+
+		int round;
+		for (round = 0; round < 255 && i + 32 <= count; round++, i += 32) {
+			__m256i hits = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(values + i)), needle);
+			found = _mm256_sub_epi8(found, hits);
+		}
+
+		total = _mm256_add_epi64(total, _mm256_sad_epu8(found, zero));
+	}
+
+	long long lanes[4];
+	_mm256_storeu_si256((__m256i*)lanes, total);
+
+	return (int)(lanes[0] + lanes[1] + lanes[2] + lanes[3]) + count_char_portable(values + i, count - i, value);
+}
+
+__attribute__((target("avx2")))
+static char min_char_avx2(const char* values, int count) {
+	if (count < 32) return min_char_portable(values, count);
+
+	__m256i bias = _mm256_set1_epi8((char)CHAR_BIAS);
+	__m256i min = _mm256_xor_si256(_mm256_loadu_si256((const __m256i*)values), bias);
+
+	int i = 32;
+	for (; i + 32 <= count; i += 32) {
+		min = _mm256_min_epi8(min, _mm256_xor_si256(_mm256_loadu_si256((const __m256i*)(values + i)), bias));
+	}
+
+	char lanes[32];
+	_mm256_storeu_si256((__m256i*)lanes, _mm256_xor_si256(min, bias));
+
+	char result = min_char_portable(lanes, 32);
+
+	if (i < count) {
+		char tail = min_char_portable(values + i, count - i);
+		if (tail < result) result = tail;
+	}
+
+	return result;
+}
+
+__attribute__((target("avx2")))
+static char max_char_avx2(const char* values, int count) {
+	if (count < 32) return max_char_portable(values, count);
+
+	__m256i bias = _mm256_set1_epi8((char)CHAR_BIAS);
+	__m256i max = _mm256_xor_si256(_mm256_loadu_si256((const __m256i*)values), bias);
+
+	int i = 32;
+	for (; i + 32 <= count; i += 32) {
+		max = _mm256_max_epi8(max, _mm256_xor_si256(_mm256_loadu_si256((const __m256i*)(values + i)), bias));
+	}
+
+	char lanes[32];
+	_mm256_storeu_si256((__m256i*)lanes, _mm256_xor_si256(max, bias));
+
+	char result = max_char_portable(lanes, 32);
+
+	if (i < count) {
+		char tail = max_char_portable(values + i, count - i);
+		if (tail > result) result = tail;
+	}
+
+	return result;
+}
+
+__attribute__((target("avx2")))
+static long long sum_char_avx2(const char* values, int count) {
+	// signed bytes are shifted into 0 to 255 for the unsigned sum of absolute differences
+	__m256i shift = _mm256_set1_epi8((char)(0x80 ^ CHAR_BIAS));
+	__m256i zero = _mm256_setzero_si256();
+	__m256i sum = _mm256_setzero_si256();
+
+	int i = 0;
+	for (; i + 32 <= count; i += 32) {
+		__m256i v = _mm256_xor_si256(_mm256_loadu_si256((const __m256i*)(values + i)), shift);
+		sum = _mm256_add_epi64(sum, _mm256_sad_epu8(v, zero));
+	}
+
+	long long lanes[4];
+	_mm256_storeu_si256((__m256i*)lanes, sum);
+
+	long long offset = CHAR_BIAS == 0 ? 128LL * i : 0;
+
+	return lanes[0] + lanes[1] + lanes[2] + lanes[3] - offset + sum_char_portable(values + i, count - i);
+}
+
+__attribute__((target("avx2")))
+static int filter_char_avx2(const char* values, int count, char low, char high, char* result) {
+	__m256i bias = _mm256_set1_epi8((char)CHAR_BIAS);
+	__m256i lower = _mm256_xor_si256(_mm256_set1_epi8(low), bias);
+	__m256i upper = _mm256_xor_si256(_mm256_set1_epi8(high), bias);
+	int written = 0;
+
+	int i = 0;
+	for (; i + 32 <= count; i += 32) {
+		__m256i v = _mm256_xor_si256(_mm256_loadu_si256((const __m256i*)(values + i)), bias);
+		__m256i outside = _mm256_or_si256(_mm256_cmpgt_epi8(lower, v), _mm256_cmpgt_epi8(v, upper));
+		unsigned mask = ~(unsigned)_mm256_movemask_epi8(outside);
+
+		while (mask != 0) {
+			result[written++] = values[i + __builtin_ctz(mask)];
+			mask &= mask - 1;
+		}
+	}
+
+	return written + filter_char_portable(values + i, count - i, low, high, result + written);
+}
+
+#endif
+
+static void init_kernels(void) {
+	kernels.find_int = find_int_portable;
+	kernels.count_int = count_int_portable;
+	kernels.min_int = min_int_portable;
+	kernels.max_int = max_int_portable;
+	kernels.sum_int = sum_int_portable;
+	kernels.filter_int = filter_int_portable;
+	kernels.find_double = find_double_portable;
+	kernels.count_double = count_double_portable;
+	kernels.min_double = min_double_portable;
+	kernels.max_double = max_double_portable;
+	kernels.sum_double = sum_double_portable;
+	kernels.filter_double = filter_double_portable;
+	kernels.dot_double = dot_double_portable;
+	kernels.deviation_double = deviation_double_portable;
+	kernels.histogram_double = histogram_double_portable;
+	kernels.find_char = find_char_portable;
+	kernels.count_char = count_char_portable;
+	kernels.min_char = min_char_portable;
+	kernels.max_char = max_char_portable;
+	kernels.sum_char = sum_char_portable;
+	kernels.filter_char = filter_char_portable;
+
+#ifdef HAVE_AVX2_DISPATCH
+	__builtin_cpu_init();
+
+	if (__builtin_cpu_supports("avx2")) {
+		init_compress_tables();
+
+		kernels.find_int = find_int_avx2;
+		kernels.count_int = count_int_avx2;
+		kernels.min_int = min_int_avx2;
+		kernels.max_int = max_int_avx2;
+		kernels.sum_int = sum_int_avx2;
+		kernels.filter_int = filter_int_avx2;
+		kernels.find_double = find_double_avx2;
+		kernels.count_double = count_double_avx2;
+		kernels.min_double = min_double_avx2;
+		kernels.max_double = max_double_avx2;
+		kernels.sum_double = sum_double_avx2;
+		kernels.filter_double = filter_double_avx2;
+		kernels.dot_double = dot_double_avx2;
+		kernels.deviation_double = deviation_double_avx2;
+		kernels.histogram_double = histogram_double_avx2;
+		kernels.find_char = find_char_avx2;
+		kernels.count_char = count_char_avx2;
+		kernels.min_char = min_char_avx2;
+		kernels.max_char = max_char_avx2;
+		kernels.sum_char = sum_char_avx2;
+		kernels.filter_char = filter_char_avx2;
+	}
+#endif
+}
+
+static const simd_kernels* get_kernels(void) {
+	pthread_once(&kernels_once, init_kernels);
+
+	return &kernels;
+}
+
+int find_int_in_array(const int* values, int count, int value) {
+	if (values == NULL || count <= 0) return -1;
+
+	return get_kernels()->find_int(values, count, value);
+}
+
+int count_int_in_array(const int* values, int count, int value) {
+	if (values == NULL || count < 0) return -1;
+
+	return get_kernels()->count_int(values, count, value);
+}
+
+int get_min_of_int_array(const int* values, int count, int* result) {
+	if (values == NULL || count <= 0 || result == NULL) return -1;
+
+	*result = get_kernels()->min_int(values, count);
+
+	return 0;
+}
+
+int get_max_of_int_array(const int* values, int count, int* result) {
+	if (values == NULL || count <= 0 || result == NULL) return -1;
+
+	*result = get_kernels()->max_int(values, count);
+
+	return 0;
+}
+
+long long get_sum_of_int_array(const int* values, int count) {
+	if (values == NULL || count <= 0) return 0;
+
+	return get_kernels()->sum_int(values, count);
+}
+
+int filter_int_array_range(const int* values, int count, int low, int high, int* result) {
+	if (values == NULL || count < 0 || result == NULL) return -1;
+
+	return get_kernels()->filter_int(values, count, low, high, result);
+}
+
+int find_double_in_array(const double* values, int count, double value) {
+	if (values == NULL || count <= 0) return -1;
+
+	return get_kernels()->find_double(values, count, value);
+}
+
+int count_double_in_array(const double* values, int count, double value) {
+	if (values == NULL || count < 0) return -1;
+
+	return get_kernels()->count_double(values, count, value);
+}
+
+int get_min_of_double_array(const double* values, int count, double* result) {
+	if (values == NULL || count <= 0 || result == NULL) return -1;
+
+	*result = get_kernels()->min_double(values, count);
+
+	return 0;
+}
+
+int get_max_of_double_array(const double* values, int count, double* result) {
+	if (values == NULL || count <= 0 || result == NULL) return -1;
+
+	*result = get_kernels()->max_double(values, count);
+
+	return 0;
+}
+
+double get_sum_of_double_array(const double* values, int count) {
+	if (values == NULL || count <= 0) return 0.0;
+
+	return get_kernels()->sum_double(values, count);
+}
+
+int filter_double_array_range(const double* values, int count, double low, double high, double* result) {
+	if (values == NULL || count < 0 || result == NULL) return -1;
+
+	return get_kernels()->filter_double(values, count, low, high, result);
+}
+
+double get_dot_product_of_double_arrays(const double* first, const double* second, int count) {
+	if (first == NULL || second == NULL || count <= 0) return 0.0;
+
+	return get_kernels()->dot_double(first, second, count);
+}
+
+double get_squared_deviation_of_double_array(const double* values, int count, double center) {
+	if (values == NULL || count <= 0) return 0.0;
+
+	return get_kernels()->deviation_double(values, count, center);
+}
+
+int add_double_array_to_histogram(const double* values, int count, double low, double high, int bins, int* counts) {
+	if (values == NULL || count < 0 || !(high > low) || bins <= 0 || counts == NULL) return -1;
+
+	// a range that overflows or is too narrow for the bins has no usable bin width
+	if (!isfinite(high - low) || !isfinite(bins / (high - low))) return -1;
+
+	get_kernels()->histogram_double(values, count, low, high, bins, counts);
+
+	return 0;
+}
+
+int find_char_in_array(const char* values, int count, char value) {
+	if (values == NULL || count <= 0) return -1;
+
+	return get_kernels()->find_char(values, count, value);
+}
+
+int count_char_in_array(const char* values, int count, char value) {
+	if (values == NULL || count < 0) return -1;
+
+	return get_kernels()->count_char(values, count, value);
+}
+
+int get_min_of_char_array(const char* values, int count, char* result) {
+	if (values == NULL || count <= 0 || result == NULL) return -1;
+
+	*result = get_kernels()->min_char(values, count);
+
+	return 0;
+}
+
+int get_max_of_char_array(const char* values, int count, char* result) {
+	if (values == NULL || count <= 0 || result == NULL) return -1;
+
+	*result = get_kernels()->max_char(values, count);
+
+	return 0;
+}
+
+long long get_sum_of_char_array(const char* values, int count) {
+	if (values == NULL || count <= 0) return 0;
+
+	return get_kernels()->sum_char(values, count);
+}
+
+int filter_char_array_range(const char* values, int count, char low, char high, char* result) {
+	if (values == NULL || count < 0 || result == NULL) return -1;
+
+	return get_kernels()->filter_char(values, count, low, high, result);
+}
@@ -0,0 +1,175 @@
+/*
+MIT License
+
+Copyright (c) 2016 Julius Paffrath
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "slab.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <pthread.h>
+
+#define CHUNK_SHIFT 16
+#define CHUNK_SIZE ((size_t)1 << CHUNK_SHIFT)
+
+// two levels of 16 bits cover the chunks of 48 bit addresses
+#define TABLE_BITS 16
+#define TABLE_ENTRIES ((size_t)1 << TABLE_BITS)
+
+// reservations from half a chunk on get a slab of their own
+#define SHARED_LIMIT (CHUNK_SIZE / 2)
+
+// serializes reservations and table updates, the lookup takes no lock
+static pthread_mutex_t writer_lock = PTHREAD_MUTEX_INITIALIZER;
+static _Atomic(_Atomic(slab*)*) directory[TABLE_ENTRIES];
+static slab* open_slab = NULL;
+
+static size_t align_slab(size_t size) {
+	return (size + _Alignof(max_align_t) - 1) & ~(_Alignof(max_align_t) - 1);
+}
+
+// table pages stay allocated once created, there is at most one per 4 GiB of address space
+static _Atomic(slab*)* create_page(void) {
+	_Atomic(slab*)* page = (_Atomic(slab*)*)malloc(sizeof(_Atomic(slab*)) * TABLE_ENTRIES);
+
+	if (page == NULL) return NULL;
+
+	size_t i;
+	for (i = 0; i < TABLE_ENTRIES; i++) {
+		atomic_init(&page[i], NULL);
+	}
+
+	return page;
+}
+
+// enters value for every chunk of s, the writer lock must be held
+static int set_chunks(slab* s, slab* value) {
+	uint64_t chunk;
+	for (chunk = (uintptr_t)s >> CHUNK_SHIFT; chunk < (uintptr_t)s->end >> CHUNK_SHIFT; chunk++) {
+		if (chunk >> (2 * TABLE_BITS) != 0) return -1;
+
+		_Atomic(slab*)* page = atomic_load_explicit(&directory[chunk >> TABLE_BITS], memory_order_relaxed);
+
+		if (page == NULL) {
+			if (value == NULL) continue;
+
+			page = create_page();
+
+			if (page == NULL) return -1;
+
+			atomic_store_explicit(&directory[chunk >> TABLE_BITS], page, memory_order_release);
+		}
+
+		atomic_store_explicit(&page[chunk & (TABLE_ENTRIES - 1)], value, memory_order_release);
+	}
+
+	return 0;
+}
+
+// the writer lock must be held
+static slab* create_slab(size_t size) {
+	if (size > SIZE_MAX - sizeof(slab) - CHUNK_SIZE) return NULL;
+
+	size_t length = (sizeof(slab) + size + CHUNK_SIZE - 1) & ~(CHUNK_SIZE - 1);
+	slab* s = (slab*)aligned_alloc(CHUNK_SIZE, length);
+
+	if (s == NULL) return NULL;
+
+	s->cursor = s->data;
+	s->end = (char*)s + length;
+	atomic_init(&s->live, 0);
+
+	if (set_chunks(s, s) != 0) {
+		set_chunks(s, NULL);
+		free(s);
+		return NULL;
+	}
+
+	return s;
+}
+
+// the writer lock must be held
+static void remove_slab(slab* s) {
+	// a pointer of a freed slab may be handed out by malloc again, so its chunks are cleared first
+	set_chunks(s, NULL);
+	free(s);
+}
+
+void* reserve_slab(size_t size, int blocks) {
+	if (blocks <= 0) return NULL;
+
+	size = align_slab(size);
+
+	pthread_mutex_lock(&writer_lock);
+
+	slab* s = open_slab;
+
+	if (s == NULL || size > (size_t)(s->end - s->cursor)) {
+		s = create_slab(size);
+
+		if (s != NULL && size < SHARED_LIMIT) {
+			// the open slab holds one reference itself, so it survives until it is replaced
+			atomic_store_explicit(&s->live, 1, memory_order_relaxed);
+
+			if (open_slab != NULL && atomic_fetch_sub_explicit(&open_slab->live, 1, memory_order_acq_rel) == 1) {
+				remove_slab(open_slab);
+			}
+
+			open_slab = s;
+		}
+	}
+
+	char* block = NULL;
+
+	if (s != NULL) {
+		block = s->cursor;
+		s->cursor += size;
+		atomic_fetch_add_explicit(&s->live, blocks, memory_order_relaxed);
+	}
+
+	pthread_mutex_unlock(&writer_lock);
+
+	return block;
+}
+
+int release_slab_block(void* pointer) {
+	uint64_t chunk = (uintptr_t)pointer >> CHUNK_SHIFT;
+
+	if (chunk >> (2 * TABLE_BITS) != 0) return 0;
+
+	_Atomic(slab*)* page = atomic_load_explicit(&directory[chunk >> TABLE_BITS], memory_order_acquire);
+
+	if (page == NULL) return 0;
+
+	// the slab of a live block stays registered, so no lock is needed
+	slab* s = atomic_load_explicit(&page[chunk & (TABLE_ENTRIES - 1)], memory_order_acquire);
+
+	if (s == NULL) return 0;
+
+	if (atomic_fetch_sub_explicit(&s->live, 1, memory_order_acq_rel) == 1) {
+		pthread_mutex_lock(&writer_lock);
+		remove_slab(s);
+		pthread_mutex_unlock(&writer_lock);
+	}
+
+	return 1;
+}
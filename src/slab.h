@@ -0,0 +1,54 @@
+/*
+MIT License
+
+Copyright (c) 2016 Julius Paffrath
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#ifndef LIBC_SLAB
+#define LIBC_SLAB
+
+#include <stddef.h>
+#include <stdatomic.h>
+
+/*
+* Contiguous blocks holding many nodes and values of compacted lists.
+*
+* Slabs are aligned to a chunk size and span whole chunks, every chunk is
+* entered in a two level table indexed by its address. A pointer released by
+* the list functions is looked up by its chunk with two atomic loads, so
+* neither the lookup nor entering and removing a slab depends on the number
+* of slabs. Small reservations are appended to a shared open slab, so a list
+* compacted step by step does not create a slab per step. A slab is freed
+* once all blocks carved out of it are released and it is not open anymore.
+*/
+
+struct slab {
+	char* cursor;
+	char* end;
+	atomic_int live;
+	_Alignas(max_align_t) char data[];
+};
+
+typedef struct slab slab;
+
+void* reserve_slab(size_t size, int blocks);
+int release_slab_block(void* pointer);
+
+#endif
@@ -0,0 +1,294 @@
+/*
+MIT License
+
+Copyright (c) 2016 Julius Paffrath
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <thread_pool.h>
+
+#include <stdlib.h>
+#include <sched.h>
+#include <unistd.h>
+
+// set for worker threads, tasks submitted by a worker go to its own deque
+static _Thread_local thread_pool* current_pool = NULL;
+static _Thread_local int current_worker = -1;
+
+static thread_pool* default_pool = NULL;
+static pthread_once_t default_pool_once = PTHREAD_ONCE_INIT;
+
+static pool_task* take_injected(thread_pool* pool) {
+	if (atomic_load_explicit(&pool->injected_count, memory_order_relaxed) == 0) return NULL;
+
+	pthread_mutex_lock(&pool->lock);
+
+	pool_task* task = pool->injected_head;
+
+	if (task != NULL) {
+		pool->injected_head = task->next;
+		if (pool->injected_head == NULL) pool->injected_tail = NULL;
+		atomic_fetch_sub_explicit(&pool->injected_count, 1, memory_order_relaxed);
+	}
+
+	pthread_mutex_unlock(&pool->lock);
+
+	return task;
+}
+
+static pool_task* find_task(thread_pool* pool, int self) {
+	pool_task* task = NULL;
+
+	if (self >= 0) task = (pool_task*)pop_work(pool->deques[self]);
+	if (task == NULL) task = take_injected(pool);
+
+	// start at the neighbour so the thieves spread over the victims
+	int first = self < 0 ? 0 : self + 1;
+	int i;
+	for (i = 0; i < pool->thread_count && task == NULL; i++) {
+		int victim = (first + i) % pool->thread_count;
+
+		if (victim != self) task = (pool_task*)steal_work(pool->deques[victim]);
+	}
+
+	if (task != NULL) atomic_fetch_sub_explicit(&pool->pending, 1, memory_order_relaxed);
+
+	return task;
+}
+
+static void run_task(pool_task* task) {
+	task_group* group = task->group;
+
+	task->function(task->argument);
+	free(task);
+
+	atomic_fetch_sub_explicit(&group->remaining, 1, memory_order_release);
+}
+
+static void* worker_main(void* arg) {
+	pool_worker* worker = (pool_worker*)arg;
+	thread_pool* pool = worker->pool;
+
+	current_pool = pool;
+	current_worker = worker->index;
+
+	for (;;) {
+		pool_task* task = find_task(pool, worker->index);
+
+		if (task != NULL) {
+			run_task(task);
+			continue;
+		}
+
+		pthread_mutex_lock(&pool->lock);
+
+		// announced before pending is read, so a submitter sees the sleeper or the sleeper the task
+		atomic_fetch_add(&pool->sleeping, 1);
+
+		if (atomic_load(&pool->pending) > 0) {
+			// a task is counted but not yet published
+			atomic_fetch_sub(&pool->sleeping, 1);
+			pthread_mutex_unlock(&pool->lock);
+			sched_yield();
+			continue;
+		}
+
+		if (pool->stop) {
+			atomic_fetch_sub(&pool->sleeping, 1);
+			pthread_mutex_unlock(&pool->lock);
+			break;
+		}
+
+		pthread_cond_wait(&pool->wake, &pool->lock);
+		atomic_fetch_sub(&pool->sleeping, 1);
+		pthread_mutex_unlock(&pool->lock);
+	}
+
+	return NULL;
+}
+
+static void stop_workers(thread_pool* pool, int started) {
+	pthread_mutex_lock(&pool->lock);
+	pool->stop = 1;
+	pthread_cond_broadcast(&pool->wake);
+	pthread_mutex_unlock(&pool->lock);
+
+	int i;
+	for (i = 0; i < started; i++) {
+		pthread_join(pool->workers[i].thread, NULL);
+	}
+}
+
+static void free_thread_pool(thread_pool* pool, int deques) {
+	int i;
+	for (i = 0; i < deques; i++) {
+		delete_work_deque(&pool->deques[i]);
+	}
+
+	pthread_cond_destroy(&pool->wake);
+	pthread_mutex_destroy(&pool->lock);
+	free(pool->workers);
+	free(pool->deques);
+	free(pool);
+}
+
+thread_pool* create_thread_pool(int threads) {
+	if (threads <= 0) return NULL;
+
+	thread_pool* pool = (thread_pool*)calloc(1, sizeof(thread_pool));
+
+	if (pool == NULL) return NULL;
+
+	pool->workers = (pool_worker*)calloc((size_t)threads, sizeof(pool_worker));
+	pool->deques = (work_deque**)calloc((size_t)threads, sizeof(work_deque*));
+
+	if (pool->workers == NULL || pool->deques == NULL) {
+		free(pool->workers);
+		free(pool->deques);
+		free(pool);
+		return NULL;
+	}
+
+	pthread_mutex_init(&pool->lock, NULL);
+	pthread_cond_init(&pool->wake, NULL);
+	atomic_init(&pool->injected_count, 0);
+	atomic_init(&pool->pending, 0);
+	atomic_init(&pool->sleeping, 0);
+	pool->thread_count = threads;
+
+	int i;
+	for (i = 0; i < threads; i++) {
+		pool->deques[i] = create_work_deque(64);
+
+		if (pool->deques[i] == NULL) {
+			free_thread_pool(pool, i);
+			return NULL;
+		}
+	}
+
+	for (i = 0; i < threads; i++) {
+		pool->workers[i].pool = pool;
+		pool->workers[i].index = i;
+
+		if (pthread_create(&pool->workers[i].thread, NULL, worker_main, &pool->workers[i]) != 0) {
+			stop_workers(pool, i);
+			free_thread_pool(pool, threads);
+			return NULL;
+		}
+	}
+
+	return pool;
+}
+
+void delete_thread_pool(thread_pool** pool) {
+	if (pool == NULL || *pool == NULL) return;
+
+	// workers only leave once nothing is pending, so every task still runs
+	stop_workers(*pool, (*pool)->thread_count);
+	free_thread_pool(*pool, (*pool)->thread_count);
+
+	*pool = NULL;
+}
+
+static void delete_default_pool(void) {
+	delete_thread_pool(&default_pool);
+}
+
+static void create_default_pool(void) {
+	long processors = sysconf(_SC_NPROCESSORS_ONLN);
+
+	// the waiting thread helps, so one worker less keeps every processor busy
+	int threads = processors > 1 ? (int)processors - 1 : 1;
+
+	default_pool = create_thread_pool(threads);
+
+	if (default_pool != NULL) atexit(delete_default_pool);
+}
+
+thread_pool* get_default_thread_pool(void) {
+	pthread_once(&default_pool_once, create_default_pool);
+
+	return default_pool;
+}
+
+int get_thread_count(thread_pool* pool) {
+	if (pool == NULL) return -1;
+
+	return pool->thread_count;
+}
+
+void init_task_group(task_group* group) {
+	if (group == NULL) return;
+
+	atomic_init(&group->remaining, 0);
+}
+
+int submit_task(thread_pool* pool, task_group* group, void (*function)(void* argument), void* argument) {
+	if (pool == NULL || group == NULL || function == NULL) return -1;
+
+	pool_task* task = (pool_task*)malloc(sizeof(pool_task));
+
+	if (task == NULL) return -1;
+
+	task->function = function;
+	task->argument = argument;
+	task->group = group;
+	task->next = NULL;
+
+	atomic_fetch_add_explicit(&group->remaining, 1, memory_order_relaxed);
+	atomic_fetch_add_explicit(&pool->pending, 1, memory_order_relaxed);
+
+	if (current_pool == pool && push_work(pool->deques[current_worker], task) == 0) {
+		// pairs with the sleeping announcement of the workers, the lock is only taken to wake one
+		atomic_thread_fence(memory_order_seq_cst);
+
+		if (atomic_load_explicit(&pool->sleeping, memory_order_relaxed) == 0) return 0;
+
+		pthread_mutex_lock(&pool->lock);
+	}
+	else {
+		pthread_mutex_lock(&pool->lock);
+
+		if (pool->injected_tail == NULL) pool->injected_head = task;
+		else pool->injected_tail->next = task;
+
+		pool->injected_tail = task;
+		atomic_fetch_add_explicit(&pool->injected_count, 1, memory_order_relaxed);
+	}
+
+	if (atomic_load_explicit(&pool->sleeping, memory_order_relaxed) > 0) pthread_cond_signal(&pool->wake);
+
+	pthread_mutex_unlock(&pool->lock);
+
+	return 0;
+}
+
+void wait_task_group(thread_pool* pool, task_group* group) {
+	if (pool == NULL || group == NULL) return;
+
+	int self = current_pool == pool ? current_worker : -1;
+
+	while (atomic_load_explicit(&group->remaining, memory_order_acquire) > 0) {
+		pool_task* task = find_task(pool, self);
+
+		if (task != NULL) run_task(task);
+		else sched_yield();
+	}
+}
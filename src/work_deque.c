@@ -0,0 +1,167 @@
+/*
+MIT License
+
+Copyright (c) 2016 Julius Paffrath
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <work_deque.h>
+
+#include <stdlib.h>
+
+static work_array* create_array(int64_t capacity, work_array* previous) {
+	work_array* array = (work_array*)malloc(sizeof(work_array) + sizeof(_Atomic(void*)) * (size_t)capacity);
+
+	if (array == NULL) return NULL;
+
+	array->previous = previous;
+	array->mask = capacity - 1;
+
+	return array;
+}
+
+static work_array* grow_array(work_deque* deque, work_array* array, int64_t top, int64_t bottom) {
+	work_array* grown = create_array((array->mask + 1) * 2, array);
+
+	if (grown == NULL) return NULL;
+
+	int64_t i;
+	for (i = top; i < bottom; i++) {
+		void* item = atomic_load_explicit(&array->items[i & array->mask], memory_order_relaxed);
+		atomic_store_explicit(&grown->items[i & grown->mask], item, memory_order_relaxed);
+	}
+
+	atomic_store_explicit(&deque->array, grown, memory_order_release);
+
+	return grown;
+}
+
+work_deque* create_work_deque(size_t capacity) {
+	int64_t count = 16;
+	while ((size_t)count < capacity) count <<= 1;
+
+	work_deque* deque = (work_deque*)aligned_alloc(_Alignof(work_deque), sizeof(work_deque));
+
+	if (deque == NULL) return NULL;
+
+	work_array* array = create_array(count, NULL);
+
+	if (array == NULL) {
+		free(deque);
+		return NULL;
+	}
+
+	atomic_init(&deque->top, 0);
+	atomic_init(&deque->bottom, 0);
+	atomic_init(&deque->array, array);
+
+	return deque;
+}
+
+void delete_work_deque(work_deque** deque) {
+	if (deque == NULL || *deque == NULL) return;
+
+	work_array* array = atomic_load_explicit(&(*deque)->array, memory_order_relaxed);
+
+	while (array != NULL) {
+		work_array* previous = array->previous;
+		free(array);
+		array = previous;
+	}
+
+	free(*deque);
+	*deque = NULL;
+}
+
+int push_work(work_deque* deque, void* item) {
+	if (deque == NULL || item == NULL) return -1;
+
+	int64_t bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed);
+	int64_t top = atomic_load_explicit(&deque->top, memory_order_acquire);
+	work_array* array = atomic_load_explicit(&deque->array, memory_order_relaxed);
+
+	if (bottom - top > array->mask) {
+		array = grow_array(deque, array, top, bottom);
+
+		if (array == NULL) return -1;
+	}
+
+	atomic_store_explicit(&array->items[bottom & array->mask], item, memory_order_relaxed);
+	atomic_thread_fence(memory_order_release);
+	atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+
+	return 0;
+}
+
+void* pop_work(work_deque* deque) {
+	if (deque == NULL) return NULL;
+
+	int64_t bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed) - 1;
+	work_array* array = atomic_load_explicit(&deque->array, memory_order_relaxed);
+
+	// reserve the bottom item before looking at top, thieves see the reservation
+	atomic_store_explicit(&deque->bottom, bottom, memory_order_relaxed);
+	atomic_thread_fence(memory_order_seq_cst);
+
+	int64_t top = atomic_load_explicit(&deque->top, memory_order_relaxed);
+	void* item = NULL;
+
+	if (top <= bottom) {
+		item = atomic_load_explicit(&array->items[bottom & array->mask], memory_order_relaxed);
+
+		if (top == bottom) {
+			// the last item, race the thieves for it
+			if (!atomic_compare_exchange_strong_explicit(&deque->top, &top, top + 1, memory_order_seq_cst, memory_order_relaxed)) item = NULL;
+
+			atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+		}
+	}
+	else {
+		atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+	}
+
+	return item;
+}
+
+void* steal_work(work_deque* deque) {
+	if (deque == NULL) return NULL;
+
+	int64_t top = atomic_load_explicit(&deque->top, memory_order_acquire);
+	atomic_thread_fence(memory_order_seq_cst);
+	int64_t bottom = atomic_load_explicit(&deque->bottom, memory_order_acquire);
+
+	if (top >= bottom) return NULL;
+
+	work_array* array = atomic_load_explicit(&deque->array, memory_order_acquire);
+	void* item = atomic_load_explicit(&array->items[top & array->mask], memory_order_relaxed);
+
+	if (!atomic_compare_exchange_strong_explicit(&deque->top, &top, top + 1, memory_order_seq_cst, memory_order_relaxed)) return NULL;
+
+	return item;
+}
+
+int get_work_count(work_deque* deque) {
+	if (deque == NULL) return -1;
+
+	int64_t bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed);
+	int64_t top = atomic_load_explicit(&deque->top, memory_order_relaxed);
+
+	return bottom > top ? (int)(bottom - top) : 0;
+}
@@ -5,3 +5,27 @@ gcov list_int.c
 gcov list_char.c
 gcov list_double.c
 gcov dictionary.c
+gcov hash.c
+gcov concurrent_dictionary.c
+gcov epoch.c
+gcov rcu_dictionary.c
+gcov radix_tree.c
+gcov ordered_dictionary.c
+gcov frozen_dictionary.c
+gcov dictionary_int.c
+gcov dictionary_double.c
+gcov lru_cache.c
+gcov expiring_dictionary.c
+gcov persistent_dictionary.c
+gcov multimap.c
+gcov queue.c
+gcov work_deque.c
+gcov thread_pool.c
+gcov list_parallel.c
+gcov node_cache.c
+gcov deferred_delete.c
+gcov cow_list.c
+gcov slab.c
+gcov list_skip_index.c
+gcov simd.c
+gcov double_column.c
@@ -3,8 +3,12 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
+#include <limits.h>
 
 #include <time.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
 
 #include <CUnit/CUnit.h>
 #include <CUnit/Basic.h>
@@ -17,13 +21,66 @@ void test_int_list(void);
 void test_char_list(void);
 void test_double_list(void);
 
+void test_concurrent_dictionary(void);
+void test_rcu_dictionary(void);
+void test_radix_tree(void);
+void test_ordered_dictionary(void);
+void test_frozen_dictionary(void);
+void test_int_dictionary(void);
+void test_double_dictionary(void);
+void test_lru_cache(void);
+void test_expiring_dictionary(void);
+void test_persistent_dictionary(void);
+void test_multimap(void);
+void test_hash(void);
+void test_merge_concurrent_dictionaries(void);
+void test_queue(void);
+void test_work_deque(void);
+void test_thread_pool(void);
+void test_list_parallel(void);
+void test_node_cache(void);
+void test_deferred_delete(void);
+void test_cow_list(void);
+void test_compact_list(void);
+void test_list_skip_index(void);
+void test_simd(void);
+void test_double_column(void);
+
 void test_list_performance(void);
+void test_concurrent_dictionary_performance(void);
+void test_dictionary_batch_performance(void);
+void test_frozen_dictionary_performance(void);
+void test_int_dictionary_performance(void);
+void test_load_dictionary_performance(void);
+void test_hash_performance(void);
+void test_queue_performance(void);
+void test_list_parallel_performance(void);
+void test_node_cache_performance(void);
+void test_deferred_delete_performance(void);
+void test_compact_list_performance(void);
+void test_list_traversal_performance(void);
+void test_simd_performance(void);
+void test_double_column_performance(void);
 
 /* TEST MAIN */
 
 int main(int argc, char* argv[]) {
 	if (argc > 1 && strcmp(argv[1], "--performance") == 0) {
 		test_list_performance();
+		test_concurrent_dictionary_performance();
+		test_dictionary_batch_performance();
+		test_frozen_dictionary_performance();
+		test_int_dictionary_performance();
+		test_load_dictionary_performance();
+		test_hash_performance();
+		test_queue_performance();
+		test_list_parallel_performance();
+		test_node_cache_performance();
+		test_deferred_delete_performance();
+		test_compact_list_performance();
+		test_list_traversal_performance();
+		test_simd_performance();
+		test_double_column_performance();
 		return EXIT_SUCCESS;
 	}
 
@@ -33,6 +90,30 @@ int main(int argc, char* argv[]) {
 		{"test of int list", test_int_list},
 		{"test of char list", test_char_list},
 		{"test of double list", test_double_list},
+		{"test of concurrent dictionary", test_concurrent_dictionary},
+		{"test of rcu dictionary", test_rcu_dictionary},
+		{"test of radix tree", test_radix_tree},
+		{"test of ordered dictionary", test_ordered_dictionary},
+		{"test of frozen dictionary", test_frozen_dictionary},
+		{"test of int dictionary", test_int_dictionary},
+		{"test of double dictionary", test_double_dictionary},
+		{"test of lru cache", test_lru_cache},
+		{"test of expiring dictionary", test_expiring_dictionary},
+		{"test of persistent dictionary", test_persistent_dictionary},
+		{"test of multimap", test_multimap},
+		{"test of hash functions", test_hash},
+		{"test of concurrent dictionary merge", test_merge_concurrent_dictionaries},
+		{"test of lock-free queues", test_queue},
+		{"test of work-stealing deque", test_work_deque},
+		{"test of thread pool", test_thread_pool},
+		{"test of parallel list operations", test_list_parallel},
+		{"test of node caches", test_node_cache},
+		{"test of deferred deletes", test_deferred_delete},
+		{"test of copy-on-write list", test_cow_list},
+		{"test of list compaction", test_compact_list},
+		{"test of list skip index", test_list_skip_index},
+		{"test of simd kernels", test_simd},
+		{"test of double column", test_double_column},
 		CU_TEST_INFO_NULL,
 	};
 
@@ -229,6 +310,12 @@ void test_list(void) {
 	CU_ASSERT_PTR_NULL(list_array);
 }
 
+static void add_int_values(void* destination, const void* source, size_t value_size) {
+	(void)value_size;
+
+	*(int*)destination += *(const int*)source;
+}
+
 void test_dictionary(void) {
 	const int valueInt = -42;
 	const char valueChar = 'J';
@@ -275,8 +362,22 @@ void test_dictionary(void) {
 
 	element* keys = get_keys(dict_to_clone);
 	CU_ASSERT_STRING_EQUAL((char*)get_value_at_index(keys, 1), "valueInt1");
+	CU_ASSERT_EQUAL(get_length_of_list(keys), 5);
 	delete_list(&keys);
 
+	const char* keyView[8];
+	CU_ASSERT_EQUAL(get_key_view(dict_to_clone, NULL, 0), 5);
+	CU_ASSERT_EQUAL(get_key_view(dict_to_clone, keyView, 2), 5);
+	CU_ASSERT_PTR_EQUAL(keyView[1], dict_to_clone->next->key);
+	CU_ASSERT_EQUAL(get_key_view(dict_to_clone, keyView, 8), 5);
+	CU_ASSERT_STRING_EQUAL(keyView[4], "valueInt4");
+	CU_ASSERT_EQUAL(get_key_view(NULL, keyView, 8), -1);
+
+	entry* entryView[8];
+	CU_ASSERT_EQUAL(get_entry_view(dict_to_clone, entryView, 8), 5);
+	CU_ASSERT_PTR_EQUAL(entryView[0], dict_to_clone);
+	CU_ASSERT_EQUAL(*(int*)entryView[3]->value, valueInt);
+
 	entry* clone = clone_dictionary(dict_to_clone, sizeof(int));
 	CU_ASSERT_PTR_NOT_NULL(clone);
 
@@ -285,8 +386,100 @@ void test_dictionary(void) {
 
 	CU_ASSERT_EQUAL(get_number_of_entries(clone), 5);
 
+	const char* batchKeys[5] = {"valueInt3", "noKey", "valueInt", "valueInt3", "valueInt9"};
+	entry* batchEntries[5];
+
+	CU_ASSERT_EQUAL(get_entries_batch(clone, batchKeys, 5, batchEntries), 3);
+	CU_ASSERT_PTR_EQUAL(batchEntries[0], get_entry(clone, "valueInt3"));
+	CU_ASSERT_PTR_NULL(batchEntries[1]);
+	CU_ASSERT_PTR_EQUAL(batchEntries[2], clone);
+	CU_ASSERT_PTR_EQUAL(batchEntries[3], batchEntries[0]);
+	CU_ASSERT_PTR_NULL(batchEntries[4]);
+
+	const int batchValues[5] = {1, 2, 3, 4, 5};
+	const void* batchValuePtrs[5] = {&batchValues[0], &batchValues[1], &batchValues[2], &batchValues[3], &batchValues[4]};
+
+	CU_ASSERT_EQUAL(add_entries_batch(clone, batchValuePtrs, sizeof(int), batchKeys, 5, batchEntries), 5);
+	CU_ASSERT_EQUAL(get_number_of_entries(clone), 7);
+	CU_ASSERT_EQUAL(*(int*)get_entry(clone, "valueInt3")->value, 4);
+	CU_ASSERT_EQUAL(*(int*)get_entry(clone, "noKey")->value, 2);
+	CU_ASSERT_EQUAL(*(int*)get_entry(clone, "valueInt9")->value, 5);
+	CU_ASSERT_EQUAL(contains_key(clone, "noKey"), 5);
+
 	delete_dictionary(&clone);
 	CU_ASSERT_PTR_NULL(clone);
+
+	const char* path = "dictionary_delimited.txt";
+	FILE* file = fopen(path, "wb");
+	fputs("alpha=1\nbeta=two=2\r\nmalformed\n=empty key\nalpha=3\ngamma=", file);
+
+	// a line longer than the read buffer
+	int i;
+	fputs("\nlong=", file);
+	for (i = 0; i < 3 * (1 << 20); i++) fputc('x', file);
+	fputs("\nlast=no newline", file);
+	fclose(file);
+
+	entry* loaded = load_dictionary_delimited(path, '=');
+	CU_ASSERT_PTR_NOT_NULL(loaded);
+	CU_ASSERT_EQUAL(get_number_of_entries(loaded), 6);
+	CU_ASSERT_STRING_EQUAL((char*)loaded->value, "3");
+	CU_ASSERT_STRING_EQUAL((char*)get_entry(loaded, "beta")->value, "two=2");
+	CU_ASSERT_STRING_EQUAL((char*)get_entry(loaded, "")->value, "empty key");
+	CU_ASSERT_STRING_EQUAL((char*)get_entry(loaded, "gamma")->value, "");
+	CU_ASSERT_EQUAL(strlen((char*)get_entry(loaded, "long")->value), 3 * (1 << 20));
+	CU_ASSERT_STRING_EQUAL((char*)get_entry(loaded, "last")->value, "no newline");
+	CU_ASSERT_EQUAL(contains_key(loaded, "malformed"), -1);
+
+	delete_dictionary(&loaded);
+
+	file = fopen(path, "wb");
+	fputs("no separator\n", file);
+	fclose(file);
+
+	CU_ASSERT_PTR_NULL(load_dictionary_delimited(path, '='));
+	CU_ASSERT_PTR_NULL(load_dictionary_delimited("does/not/exist.txt", '='));
+	CU_ASSERT_PTR_NULL(load_dictionary_delimited(path, '\n'));
+	remove(path);
+
+	int values[6] = {0, 1, 2, 3, 4, 5};
+	entry* left = create_dictionary(&values[1], sizeof(int), "a");
+	add_entry(left, &values[2], sizeof(int), "b");
+	add_entry(left, &values[3], sizeof(int), "c");
+
+	entry* right = create_dictionary(&values[4], sizeof(int), "c");
+	add_entry(right, &values[5], sizeof(int), "d");
+
+	entry* common = intersect_dictionaries(left, right, sizeof(int));
+	CU_ASSERT_EQUAL(get_number_of_entries(common), 1);
+	CU_ASSERT_STRING_EQUAL(common->key, "c");
+	CU_ASSERT_EQUAL(*(int*)common->value, 3);
+	delete_dictionary(&common);
+
+	entry* only_left = difference_dictionaries(left, right, sizeof(int));
+	CU_ASSERT_EQUAL(get_number_of_entries(only_left), 2);
+	CU_ASSERT_PTR_NOT_NULL(get_entry(only_left, "a"));
+	CU_ASSERT_PTR_NOT_NULL(get_entry(only_left, "b"));
+	CU_ASSERT_PTR_NULL(get_entry(only_left, "c"));
+	CU_ASSERT_PTR_NULL(difference_dictionaries(left, left, sizeof(int)));
+	delete_dictionary(&only_left);
+
+	CU_ASSERT_PTR_EQUAL(merge_dictionaries(left, right, sizeof(int), MERGE_KEEP_DESTINATION, NULL), left);
+	CU_ASSERT_EQUAL(get_number_of_entries(left), 4);
+	CU_ASSERT_EQUAL(*(int*)get_entry(left, "c")->value, 3);
+	CU_ASSERT_EQUAL(*(int*)get_entry(left, "d")->value, 5);
+
+	CU_ASSERT_PTR_EQUAL(merge_dictionaries(left, right, sizeof(int), MERGE_OVERWRITE, NULL), left);
+	CU_ASSERT_EQUAL(*(int*)get_entry(left, "c")->value, 4);
+
+	CU_ASSERT_PTR_EQUAL(merge_dictionaries(left, right, sizeof(int), MERGE_COMBINE, add_int_values), left);
+	CU_ASSERT_EQUAL(*(int*)get_entry(left, "c")->value, 8);
+	CU_ASSERT_EQUAL(*(int*)get_entry(left, "d")->value, 10);
+	CU_ASSERT_EQUAL(get_number_of_entries(left), 4);
+	CU_ASSERT_PTR_NULL(merge_dictionaries(left, right, sizeof(int), MERGE_COMBINE, NULL));
+
+	delete_dictionary(&left);
+	delete_dictionary(&right);
 }
 
 void test_list_performance(void) {
@@ -409,4 +602,3018 @@ void test_double_list(void) {
 
 	delete_list(&double_list);
 	CU_ASSERT_PTR_NULL(double_list);
-}
\ No newline at end of file
+}
+
+static double get_wall_seconds(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+typedef struct concurrent_test_args {
+	concurrent_dictionary* dict;
+	int thread_id;
+	int operations;
+	int key_range;
+} concurrent_test_args;
+
+static void* concurrent_add_worker(void* arg) {
+	concurrent_test_args* args = (concurrent_test_args*)arg;
+	char key[32];
+
+	int i;
+	for (i = 0; i < args->operations; i++) {
+		sprintf(key, "t%d-k%d", args->thread_id, i);
+		add_concurrent_entry(args->dict, &i, sizeof(int), key);
+	}
+
+	return NULL;
+}
+
+void test_concurrent_dictionary(void) {
+	const int valueInt = -42;
+	const double valueDouble = 3.3;
+	const char* valueString = "Test";
+
+	CU_ASSERT_PTR_NULL(create_concurrent_dictionary(0));
+
+	concurrent_dictionary* dict = create_concurrent_dictionary(6);
+	CU_ASSERT_PTR_NOT_NULL(dict);
+	CU_ASSERT_EQUAL(dict->shard_count, 8);
+
+	CU_ASSERT_EQUAL(get_number_of_concurrent_entries(dict), 0);
+
+	CU_ASSERT_EQUAL(add_concurrent_entry(dict, &valueInt, sizeof(int), "valueInt"), 0);
+	CU_ASSERT_EQUAL(add_concurrent_entry(dict, valueString, strlen(valueString) + 1, "valueString"), 0);
+	CU_ASSERT_EQUAL(add_concurrent_entry(dict, &valueDouble, sizeof(double), "valueDouble"), 0);
+	CU_ASSERT_EQUAL(add_concurrent_entry(dict, &valueDouble, sizeof(double), "valueDouble"), 0);
+
+	CU_ASSERT_EQUAL(get_number_of_concurrent_entries(dict), 3);
+
+	int resultInt = 0;
+	CU_ASSERT_EQUAL(get_concurrent_entry(dict, "valueInt", &resultInt, sizeof(int)), (int)sizeof(int));
+	CU_ASSERT_EQUAL(resultInt, valueInt);
+
+	char resultString[16];
+	CU_ASSERT_EQUAL(get_concurrent_entry(dict, "valueString", resultString, sizeof(resultString)), 5);
+	CU_ASSERT_STRING_EQUAL(resultString, valueString);
+
+	CU_ASSERT_EQUAL(add_concurrent_entry(dict, &valueDouble, sizeof(double), "valueInt"), 0);
+	double resultDouble = 0;
+	CU_ASSERT_EQUAL(get_concurrent_entry(dict, "valueInt", &resultDouble, sizeof(double)), (int)sizeof(double));
+	CU_ASSERT_EQUAL(resultDouble, valueDouble);
+
+	CU_ASSERT_EQUAL(contains_concurrent_key(dict, "valueString"), 1);
+	CU_ASSERT_EQUAL(contains_concurrent_key(dict, "noKey"), 0);
+	CU_ASSERT_EQUAL(get_concurrent_entry(dict, "noKey", NULL, 0), -1);
+
+	CU_ASSERT_EQUAL(remove_concurrent_entry(dict, "valueString"), 0);
+	CU_ASSERT_EQUAL(remove_concurrent_entry(dict, "valueString"), -1);
+	CU_ASSERT_EQUAL(contains_concurrent_key(dict, "valueString"), 0);
+	CU_ASSERT_EQUAL(get_number_of_concurrent_entries(dict), 2);
+
+	delete_concurrent_dictionary(&dict);
+	CU_ASSERT_PTR_NULL(dict);
+
+	dict = create_concurrent_dictionary(4);
+	CU_ASSERT_PTR_NOT_NULL(dict);
+
+	pthread_t threads[4];
+	concurrent_test_args args[4];
+
+	int i;
+	for (i = 0; i < 4; i++) {
+		args[i].dict = dict;
+		args[i].thread_id = i;
+		args[i].operations = 1000;
+		args[i].key_range = 0;
+		pthread_create(&threads[i], NULL, concurrent_add_worker, &args[i]);
+	}
+
+	for (i = 0; i < 4; i++) {
+		pthread_join(threads[i], NULL);
+	}
+
+	CU_ASSERT_EQUAL(get_number_of_concurrent_entries(dict), 4000);
+
+	int value = 0;
+	CU_ASSERT_EQUAL(get_concurrent_entry(dict, "t3-k999", &value, sizeof(int)), (int)sizeof(int));
+	CU_ASSERT_EQUAL(value, 999);
+
+	delete_concurrent_dictionary(&dict);
+	CU_ASSERT_PTR_NULL(dict);
+}
+
+static void* concurrent_mixed_worker(void* arg) {
+	concurrent_test_args* args = (concurrent_test_args*)arg;
+	unsigned int seed = (unsigned int)args->thread_id + 1;
+	char key[32];
+	int value = 0;
+
+	int i;
+	for (i = 0; i < args->operations; i++) {
+		sprintf(key, "key%d", rand_r(&seed) % args->key_range);
+
+		if (i % 10 == 0) {
+			add_concurrent_entry(args->dict, &i, sizeof(int), key);
+		}
+		else {
+			get_concurrent_entry(args->dict, key, &value, sizeof(int));
+		}
+	}
+
+	return NULL;
+}
+
+void test_concurrent_dictionary_performance(void) {
+	const int key_range = 100000;
+	const int operations = 200000;
+	const int shard_counts[2] = {1, 64};
+	const int thread_counts[6] = {1, 2, 4, 8, 16, 32};
+
+	char key[32];
+
+	int s;
+	for (s = 0; s < 2; s++) {
+		concurrent_dictionary* dict = create_concurrent_dictionary(shard_counts[s]);
+
+		int i;
+		for (i = 0; i < key_range; i++) {
+			sprintf(key, "key%d", i);
+			add_concurrent_entry(dict, &i, sizeof(int), key);
+		}
+
+		int t;
+		for (t = 0; t < 6; t++) {
+			int thread_count = thread_counts[t];
+			pthread_t threads[32];
+			concurrent_test_args args[32];
+
+			double start = get_wall_seconds();
+
+			for (i = 0; i < thread_count; i++) {
+				args[i].dict = dict;
+				args[i].thread_id = i;
+				args[i].operations = operations;
+				args[i].key_range = key_range;
+				pthread_create(&threads[i], NULL, concurrent_mixed_worker, &args[i]);
+			}
+
+			for (i = 0; i < thread_count; i++) {
+				pthread_join(threads[i], NULL);
+			}
+
+			double seconds = get_wall_seconds() - start;
+
+			printf("Concurrent dictionary with %d shards, %d threads: %.2f million operations per second\n",
+				shard_counts[s], thread_count, (double)thread_count * operations / seconds / 1e6);
+		}
+
+		delete_concurrent_dictionary(&dict);
+	}
+}
+
+typedef struct rcu_test_args {
+	rcu_dictionary* dict;
+	atomic_int* running;
+	int errors;
+} rcu_test_args;
+
+static void* rcu_reader_worker(void* arg) {
+	rcu_test_args* args = (rcu_test_args*)arg;
+	char key[32];
+	int value = 0;
+	int i = 0;
+
+	while (atomic_load(args->running)) {
+		sprintf(key, "stable%d", i % 100);
+
+		if (get_rcu_entry(args->dict, key, &value, sizeof(int)) != (int)sizeof(int) || value % 100 != i % 100) {
+			args->errors++;
+		}
+
+		i++;
+	}
+
+	return NULL;
+}
+
+void test_rcu_dictionary(void) {
+	const int valueInt = -42;
+	const char* valueString = "Test";
+
+	rcu_dictionary* dict = create_rcu_dictionary();
+	CU_ASSERT_PTR_NOT_NULL(dict);
+
+	CU_ASSERT_EQUAL(get_number_of_rcu_entries(dict), 0);
+
+	CU_ASSERT_EQUAL(add_rcu_entry(dict, &valueInt, sizeof(int), "valueInt"), 0);
+	CU_ASSERT_EQUAL(add_rcu_entry(dict, valueString, strlen(valueString) + 1, "valueString"), 0);
+	CU_ASSERT_EQUAL(add_rcu_entry(dict, valueString, strlen(valueString) + 1, "valueString"), 0);
+
+	CU_ASSERT_EQUAL(get_number_of_rcu_entries(dict), 2);
+
+	int resultInt = 0;
+	CU_ASSERT_EQUAL(get_rcu_entry(dict, "valueInt", &resultInt, sizeof(int)), (int)sizeof(int));
+	CU_ASSERT_EQUAL(resultInt, valueInt);
+
+	char resultString[16];
+	CU_ASSERT_EQUAL(get_rcu_entry(dict, "valueString", resultString, sizeof(resultString)), 5);
+	CU_ASSERT_STRING_EQUAL(resultString, valueString);
+
+	CU_ASSERT_EQUAL(contains_rcu_key(dict, "valueInt"), 1);
+	CU_ASSERT_EQUAL(contains_rcu_key(dict, "noKey"), 0);
+
+	CU_ASSERT_EQUAL(remove_rcu_entry(dict, "valueInt"), 0);
+	CU_ASSERT_EQUAL(remove_rcu_entry(dict, "valueInt"), -1);
+	CU_ASSERT_EQUAL(contains_rcu_key(dict, "valueInt"), 0);
+	CU_ASSERT_EQUAL(get_number_of_rcu_entries(dict), 1);
+
+	delete_rcu_dictionary(&dict);
+	CU_ASSERT_PTR_NULL(dict);
+
+	dict = create_rcu_dictionary();
+	CU_ASSERT_PTR_NOT_NULL(dict);
+
+	char key[32];
+
+	int i;
+	for (i = 0; i < 100; i++) {
+		sprintf(key, "stable%d", i);
+		add_rcu_entry(dict, &i, sizeof(int), key);
+	}
+
+	atomic_int running;
+	atomic_init(&running, 1);
+
+	pthread_t threads[4];
+	rcu_test_args args[4];
+
+	for (i = 0; i < 4; i++) {
+		args[i].dict = dict;
+		args[i].running = &running;
+		args[i].errors = 0;
+		pthread_create(&threads[i], NULL, rcu_reader_worker, &args[i]);
+	}
+
+	// update the stable keys and force table growth while readers are running
+	for (i = 0; i < 5000; i++) {
+		int value = i;
+		sprintf(key, "stable%d", i % 100);
+		add_rcu_entry(dict, &value, sizeof(int), key);
+
+		sprintf(key, "volatile%d", i);
+		add_rcu_entry(dict, &value, sizeof(int), key);
+
+		if (i % 2 == 0) remove_rcu_entry(dict, key);
+	}
+
+	atomic_store(&running, 0);
+
+	for (i = 0; i < 4; i++) {
+		pthread_join(threads[i], NULL);
+		CU_ASSERT_EQUAL(args[i].errors, 0);
+	}
+
+	CU_ASSERT_EQUAL(get_number_of_rcu_entries(dict), 2600);
+
+	delete_rcu_dictionary(&dict);
+	CU_ASSERT_PTR_NULL(dict);
+}
+
+void test_radix_tree(void) {
+	const int valueInt = -42;
+	const char* valueString = "Test";
+
+	radix_tree* tree = create_radix_tree();
+	CU_ASSERT_PTR_NOT_NULL(tree);
+
+	CU_ASSERT_EQUAL(get_number_of_radix_entries(tree), 0);
+	CU_ASSERT_PTR_NULL(get_radix_keys(tree));
+
+	const char* paths[6] = {
+		"svc/eu/host1/cpu",
+		"svc/eu/host1/mem",
+		"svc/eu/host2/cpu",
+		"svc/us/host1/cpu",
+		"svc",
+		"db/eu/host9/disk"
+	};
+
+	int i;
+	for (i = 0; i < 6; i++) {
+		CU_ASSERT_PTR_NOT_NULL(add_radix_entry(tree, &i, sizeof(int), paths[i]));
+	}
+
+	CU_ASSERT_PTR_NOT_NULL(add_radix_entry(tree, valueString, strlen(valueString) + 1, "svc/eu/host1/mem"));
+	CU_ASSERT_EQUAL(get_number_of_radix_entries(tree), 6);
+
+	CU_ASSERT_EQUAL(*(int*)get_radix_entry(tree, "svc/eu/host2/cpu"), 2);
+	CU_ASSERT_EQUAL(*(int*)get_radix_entry(tree, "svc"), 4);
+	CU_ASSERT_STRING_EQUAL((char*)get_radix_entry(tree, "svc/eu/host1/mem"), valueString);
+	CU_ASSERT_PTR_NULL(get_radix_entry(tree, "svc/eu"));
+	CU_ASSERT_PTR_NULL(get_radix_entry(tree, "svc/eu/host1/cpu/x"));
+
+	CU_ASSERT_EQUAL(contains_radix_key(tree, "db/eu/host9/disk"), 1);
+	CU_ASSERT_EQUAL(contains_radix_key(tree, "db/eu"), 0);
+
+	element* keys = get_radix_keys(tree);
+	CU_ASSERT_EQUAL(get_length_of_list(keys), 6);
+	CU_ASSERT_STRING_EQUAL((char*)get_value_at_index(keys, 0), "db/eu/host9/disk");
+	CU_ASSERT_STRING_EQUAL((char*)get_value_at_index(keys, 1), "svc");
+	CU_ASSERT_STRING_EQUAL((char*)get_value_at_index(keys, 2), "svc/eu/host1/cpu");
+	CU_ASSERT_STRING_EQUAL((char*)get_value_at_index(keys, 5), "svc/us/host1/cpu");
+	delete_list(&keys);
+
+	entry* subtree = get_entries_with_prefix(tree, "svc/eu/h");
+	CU_ASSERT_EQUAL(get_number_of_entries(subtree), 3);
+	CU_ASSERT_STRING_EQUAL(subtree->key, "svc/eu/host1/cpu");
+	CU_ASSERT_EQUAL(*(int*)get_entry(subtree, "svc/eu/host2/cpu")->value, 2);
+	CU_ASSERT_STRING_EQUAL((char*)get_entry(subtree, "svc/eu/host1/mem")->value, valueString);
+	delete_dictionary(&subtree);
+
+	CU_ASSERT_PTR_NULL(get_entries_with_prefix(tree, "svc/asia"));
+
+	radix_iterator* iterator = create_radix_iterator(tree, "svc/eu/host1/");
+	CU_ASSERT_PTR_NOT_NULL(iterator);
+
+	const char* key;
+	void* value;
+	CU_ASSERT_EQUAL(next_radix_entry(iterator, &key, &value), 1);
+	CU_ASSERT_STRING_EQUAL(key, "svc/eu/host1/cpu");
+	CU_ASSERT_EQUAL(*(int*)value, 0);
+	CU_ASSERT_EQUAL(next_radix_entry(iterator, &key, &value), 1);
+	CU_ASSERT_STRING_EQUAL(key, "svc/eu/host1/mem");
+	CU_ASSERT_EQUAL(next_radix_entry(iterator, &key, &value), 0);
+
+	delete_radix_iterator(&iterator);
+	CU_ASSERT_PTR_NULL(iterator);
+
+	radix_tree* clone = clone_radix_tree(tree);
+	CU_ASSERT_PTR_NOT_NULL(clone);
+
+	CU_ASSERT_PTR_NOT_NULL(remove_radix_entry(tree, "svc/eu/host1/cpu"));
+	CU_ASSERT_PTR_NOT_NULL(remove_radix_entry(tree, "svc/eu/host1/mem"));
+	CU_ASSERT_PTR_NULL(remove_radix_entry(tree, "svc/eu/host1/mem"));
+	CU_ASSERT_PTR_NULL(remove_radix_entry(tree, "svc/eu"));
+	CU_ASSERT_PTR_NOT_NULL(remove_radix_entry(tree, "svc"));
+	CU_ASSERT_EQUAL(get_number_of_radix_entries(tree), 3);
+
+	CU_ASSERT_EQUAL(*(int*)get_radix_entry(tree, "svc/eu/host2/cpu"), 2);
+	CU_ASSERT_EQUAL(*(int*)get_radix_entry(tree, "svc/us/host1/cpu"), 3);
+
+	entry* all = get_entries_with_prefix(tree, "");
+	CU_ASSERT_EQUAL(get_number_of_entries(all), 3);
+	delete_dictionary(&all);
+
+	CU_ASSERT_EQUAL(get_number_of_radix_entries(clone), 6);
+	CU_ASSERT_EQUAL(*(int*)get_radix_entry(clone, "svc/eu/host1/cpu"), 0);
+
+	delete_radix_tree(&clone);
+	CU_ASSERT_PTR_NULL(clone);
+
+	CU_ASSERT_PTR_NOT_NULL(add_radix_entry(tree, &valueInt, sizeof(int), ""));
+	CU_ASSERT_EQUAL(*(int*)get_radix_entry(tree, ""), valueInt);
+	CU_ASSERT_PTR_NOT_NULL(remove_radix_entry(tree, ""));
+
+	delete_radix_tree(&tree);
+	CU_ASSERT_PTR_NULL(tree);
+}
+
+void test_ordered_dictionary(void) {
+	const char* valueString = "Test";
+
+	ordered_dictionary* dict = create_ordered_dictionary();
+	CU_ASSERT_PTR_NOT_NULL(dict);
+
+	CU_ASSERT_EQUAL(get_number_of_ordered_entries(dict), 0);
+	CU_ASSERT_PTR_NULL(get_ordered_keys(dict));
+
+	char key[32];
+	const int max = 5000;
+
+	// insert in a scrambled order so that splits happen all over the tree
+	int i;
+	for (i = 0; i < max; i++) {
+		int k = (i * 7919) % max;
+		sprintf(key, "key%05d", k);
+		CU_ASSERT_PTR_NOT_NULL(add_ordered_entry(dict, &k, sizeof(int), key));
+	}
+
+	CU_ASSERT_PTR_NOT_NULL(add_ordered_entry(dict, valueString, strlen(valueString) + 1, "key00042"));
+	CU_ASSERT_STRING_EQUAL((char*)get_ordered_entry(dict, "key00042"), valueString);
+
+	CU_ASSERT_EQUAL(get_number_of_ordered_entries(dict), max);
+	CU_ASSERT_EQUAL(*(int*)get_ordered_entry(dict, "key04999"), 4999);
+	CU_ASSERT_PTR_NULL(get_ordered_entry(dict, "key05000"));
+	CU_ASSERT_EQUAL(contains_ordered_key(dict, "key00000"), 1);
+	CU_ASSERT_EQUAL(contains_ordered_key(dict, "noKey"), 0);
+
+	ordered_iterator* iterator = create_ordered_iterator(dict, NULL, NULL);
+	CU_ASSERT_PTR_NOT_NULL(iterator);
+
+	const char* k;
+	void* v;
+	int count = 0;
+	char last[32] = "";
+
+	while (next_ordered_entry(iterator, &k, &v)) {
+		CU_ASSERT(strcmp(last, k) < 0);
+		strcpy(last, k);
+		count++;
+	}
+
+	CU_ASSERT_EQUAL(count, max);
+	delete_ordered_iterator(&iterator);
+	CU_ASSERT_PTR_NULL(iterator);
+
+	// remove every odd key, which forces borrowing and merging of nodes
+	for (i = 1; i < max; i += 2) {
+		sprintf(key, "key%05d", i);
+		CU_ASSERT_PTR_NOT_NULL(remove_ordered_entry(dict, key));
+	}
+
+	CU_ASSERT_PTR_NULL(remove_ordered_entry(dict, "key00001"));
+	CU_ASSERT_EQUAL(get_number_of_ordered_entries(dict), max / 2);
+	CU_ASSERT_PTR_NULL(get_ordered_entry(dict, "key00001"));
+	CU_ASSERT_EQUAL(*(int*)get_ordered_entry(dict, "key04998"), 4998);
+
+	iterator = create_ordered_iterator(dict, "key00100", "key00110");
+	CU_ASSERT_PTR_NOT_NULL(iterator);
+
+	count = 0;
+	while (next_ordered_entry(iterator, &k, &v)) {
+		sprintf(key, "key%05d", 100 + count * 2);
+		CU_ASSERT_STRING_EQUAL(k, key);
+		CU_ASSERT_EQUAL(*(int*)v, 100 + count * 2);
+		count++;
+	}
+
+	CU_ASSERT_EQUAL(count, 5);
+	delete_ordered_iterator(&iterator);
+
+	iterator = create_ordered_iterator(dict, "key00101", "key00103");
+	CU_ASSERT_EQUAL(next_ordered_entry(iterator, &k, NULL), 1);
+	CU_ASSERT_STRING_EQUAL(k, "key00102");
+	CU_ASSERT_EQUAL(next_ordered_entry(iterator, &k, NULL), 0);
+	delete_ordered_iterator(&iterator);
+
+	element* keys = get_ordered_keys(dict);
+	CU_ASSERT_EQUAL(get_length_of_list(keys), max / 2);
+	CU_ASSERT_STRING_EQUAL((char*)get_value_at_index(keys, 0), "key00000");
+	CU_ASSERT_STRING_EQUAL((char*)get_value_at_index(keys, 1), "key00002");
+	delete_list(&keys);
+
+	for (i = 0; i < max; i += 2) {
+		sprintf(key, "key%05d", i);
+		CU_ASSERT_PTR_NOT_NULL(remove_ordered_entry(dict, key));
+	}
+
+	CU_ASSERT_EQUAL(get_number_of_ordered_entries(dict), 0);
+	CU_ASSERT_TRUE(dict->root->is_leaf);
+
+	delete_ordered_dictionary(&dict);
+	CU_ASSERT_PTR_NULL(dict);
+}
+
+void test_dictionary_batch_performance(void) {
+	const int max = 100000;
+	const int batch = 200;
+
+	static char keyStorage[100000][16];
+	const char* keys[1000];
+	const void* values[1000];
+
+	int i;
+	for (i = 0; i < max; i++) {
+		sprintf(keyStorage[i], "key%d", i);
+	}
+
+	clock_t start = clock();
+
+	entry* dict = create_dictionary(&i, sizeof(int), "root");
+
+	for (i = 0; i < max; i += 1000) {
+		int j;
+		for (j = 0; j < 1000; j++) {
+			keys[j] = keyStorage[i + j];
+			values[j] = &i;
+		}
+
+		add_entries_batch(dict, values, sizeof(int), keys, 1000, NULL);
+	}
+
+	clock_t end = clock();
+	printf("Adding %d entries in batches of 1000 has taken %f seconds\n", max, (float)(end - start) / CLOCKS_PER_SEC);
+
+	for (i = 0; i < batch; i++) {
+		keys[i] = keyStorage[(i * 7919) % max];
+	}
+
+	start = clock();
+
+	for (i = 0; i < batch; i++) {
+		get_entry(dict, keys[i]);
+	}
+
+	end = clock();
+	printf("Resolving %d keys with get_entry has taken %f seconds\n", batch, (float)(end - start) / CLOCKS_PER_SEC);
+
+	entry* entries[1000];
+	start = clock();
+
+	get_entries_batch(dict, keys, batch, entries);
+
+	end = clock();
+	printf("Resolving %d keys with get_entries_batch has taken %f seconds\n", batch, (float)(end - start) / CLOCKS_PER_SEC);
+
+	delete_dictionary(&dict);
+}
+
+// writes image with the little endian value patched in at position, returns 1 if it still loads
+static int load_corrupted_frozen(const char* path, const unsigned char* image, size_t size, size_t position, uint64_t value, size_t width) {
+	unsigned char copy[256];
+	memcpy(copy, image, size);
+
+	size_t i;
+	for (i = 0; i < width; i++) copy[position + i] = (unsigned char)(value >> (8 * i));
+
+	FILE* file = fopen(path, "wb");
+	fwrite(copy, 1, size, file);
+	fclose(file);
+
+	frozen_dictionary* frozen = load_frozen_dictionary(path);
+
+	if (frozen == NULL) return 0;
+
+	delete_frozen_dictionary(&frozen);
+
+	return 1;
+}
+
+void test_frozen_dictionary(void) {
+	const int max = 2000;
+	char key[32];
+
+	int i = 0;
+	entry* dict = create_dictionary(&i, sizeof(int), "key0");
+	CU_ASSERT_PTR_NOT_NULL(dict);
+
+	const char* keys[2000];
+	const void* values[2000];
+	static char keyStorage[2000][16];
+	static int valueStorage[2000];
+
+	for (i = 1; i < max; i++) {
+		sprintf(keyStorage[i], "key%d", i);
+		valueStorage[i] = i;
+		keys[i - 1] = keyStorage[i];
+		values[i - 1] = &valueStorage[i];
+	}
+
+	CU_ASSERT_EQUAL(add_entries_batch(dict, values, sizeof(int), keys, max - 1, NULL), max - 1);
+
+	frozen_dictionary* frozen = freeze_dictionary(dict, sizeof(int));
+	CU_ASSERT_PTR_NOT_NULL(frozen);
+
+	delete_dictionary(&dict);
+
+	CU_ASSERT_EQUAL(get_number_of_frozen_entries(frozen), max);
+
+	int errors = 0;
+
+	for (i = 0; i < max; i++) {
+		sprintf(key, "key%d", i);
+		const int* value = (const int*)get_frozen_entry(frozen, key);
+		if (value == NULL || *value != i) errors++;
+	}
+
+	CU_ASSERT_EQUAL(errors, 0);
+	CU_ASSERT_PTR_NULL(get_frozen_entry(frozen, "noKey"));
+	CU_ASSERT_EQUAL(contains_frozen_key(frozen, "key1999"), 1);
+	CU_ASSERT_EQUAL(contains_frozen_key(frozen, "key2000"), 0);
+
+	const char* path = "frozen_dictionary.bin";
+	CU_ASSERT_EQUAL(save_frozen_dictionary(frozen, path), 0);
+
+	delete_frozen_dictionary(&frozen);
+	CU_ASSERT_PTR_NULL(frozen);
+
+	frozen = load_frozen_dictionary(path);
+	CU_ASSERT_PTR_NOT_NULL(frozen);
+	remove(path);
+
+	CU_ASSERT_EQUAL(get_number_of_frozen_entries(frozen), max);
+	CU_ASSERT_EQUAL(*(const int*)get_frozen_entry(frozen, "key1234"), 1234);
+	CU_ASSERT_PTR_NULL(get_frozen_entry(frozen, "noKey"));
+
+	delete_frozen_dictionary(&frozen);
+	CU_ASSERT_PTR_NULL(frozen);
+
+	CU_ASSERT_PTR_NULL(load_frozen_dictionary("does/not/exist.bin"));
+
+	entry* single = create_dictionary(&max, sizeof(int), "only");
+	frozen = freeze_dictionary(single, sizeof(int));
+	CU_ASSERT_PTR_NOT_NULL(frozen);
+	CU_ASSERT_EQUAL(*(const int*)get_frozen_entry(frozen, "only"), max);
+	CU_ASSERT_PTR_NULL(get_frozen_entry(frozen, "other"));
+
+	const char* corrupt = "frozen_corrupt.bin";
+	CU_ASSERT_EQUAL(save_frozen_dictionary(frozen, corrupt), 0);
+
+	unsigned char image[256];
+	FILE* file = fopen(corrupt, "rb");
+	size_t size = fread(image, 1, sizeof(image), file);
+	fclose(file);
+
+	// the header holds magic, version, entry count, bucket count, value size, seed and memory size
+	const size_t header_size = 48;
+	const size_t entry_count = 8, bucket_count = 16, memory_size = 40;
+	// the single entry image keeps its two key offsets behind one aligned displacement
+	const size_t key_offsets = header_size + 16;
+
+	CU_ASSERT_EQUAL(load_corrupted_frozen(corrupt, image, size, 0, 0, 0), 1);
+	CU_ASSERT_EQUAL(load_corrupted_frozen(corrupt, image, size - 1, 0, 0, 0), 0);
+	CU_ASSERT_EQUAL(load_corrupted_frozen(corrupt, image, size, bucket_count, 0, sizeof(uint64_t)), 0);
+	CU_ASSERT_EQUAL(load_corrupted_frozen(corrupt, image, size, entry_count, UINT64_MAX / 2, sizeof(uint64_t)), 0);
+	CU_ASSERT_EQUAL(load_corrupted_frozen(corrupt, image, size, bucket_count, UINT64_MAX / 2, sizeof(uint64_t)), 0);
+	CU_ASSERT_EQUAL(load_corrupted_frozen(corrupt, image, size, memory_size, UINT64_MAX, sizeof(uint64_t)), 0);
+	CU_ASSERT_EQUAL(load_corrupted_frozen(corrupt, image, size, size - 1, 'x', 1), 0);
+	CU_ASSERT_EQUAL(load_corrupted_frozen(corrupt, image, size, key_offsets, 5, sizeof(uint32_t)), 0);
+	CU_ASSERT_EQUAL(load_corrupted_frozen(corrupt, image, size, key_offsets + 4, 1000, sizeof(uint32_t)), 0);
+	remove(corrupt);
+
+	delete_frozen_dictionary(&frozen);
+	delete_dictionary(&single);
+}
+
+void test_frozen_dictionary_performance(void) {
+	const int max = 1000000;
+	const int batch = 10000;
+
+	char* keyStorage = (char*)malloc((size_t)max * 16);
+	const char** keys = (const char**)malloc(sizeof(char*) * batch);
+	const void** values = (const void**)malloc(sizeof(void*) * batch);
+
+	int i;
+	for (i = 0; i < max; i++) {
+		sprintf(keyStorage + (size_t)i * 16, "key%d", i);
+	}
+
+	entry* dict = create_dictionary(&i, sizeof(int), "root");
+
+	for (i = 0; i < max; i += batch) {
+		int j;
+		for (j = 0; j < batch; j++) {
+			keys[j] = keyStorage + (size_t)(i + j) * 16;
+			values[j] = &j;
+		}
+
+		add_entries_batch(dict, values, sizeof(int), keys, batch, NULL);
+	}
+
+	clock_t start = clock();
+	frozen_dictionary* frozen = freeze_dictionary(dict, sizeof(int));
+	clock_t end = clock();
+
+	printf("Freezing %d entries has taken %f seconds\n", max, (float)(end - start) / CLOCKS_PER_SEC);
+
+	start = clock();
+
+	int found = 0;
+	for (i = 0; i < max; i++) {
+		if (get_frozen_entry(frozen, keyStorage + (size_t)(((long long)i * 7919) % max) * 16) != NULL) found++;
+	}
+
+	end = clock();
+
+	printf("Looking up %d keys in a frozen dictionary has taken %f seconds (%d found)\n", max, (float)(end - start) / CLOCKS_PER_SEC, found);
+
+	delete_frozen_dictionary(&frozen);
+	delete_dictionary(&dict);
+	free(keyStorage);
+	free(keys);
+	free(values);
+}
+
+static void* int_dictionary_worker(void* arg) {
+	int_entry* e = (int_entry*)arg;
+
+	int i;
+	for (i = 0; i < 10000; i++) {
+		atomic_add_to_int_entry(e, 1);
+	}
+
+	return NULL;
+}
+
+void test_int_dictionary(void) {
+	int_dictionary* dict = create_int_dictionary();
+	CU_ASSERT_PTR_NOT_NULL(dict);
+	CU_ASSERT_EQUAL(get_number_of_int_entries(dict), 0);
+
+	char key[32];
+	const int max = 1000;
+
+	int i;
+	for (i = 0; i < max; i++) {
+		sprintf(key, "key%d", i);
+		CU_ASSERT_PTR_NOT_NULL(add_int_entry(dict, i, key));
+	}
+
+	CU_ASSERT_EQUAL(get_number_of_int_entries(dict), max);
+	CU_ASSERT_EQUAL(get_int_entry(dict, "key123")->value, 123);
+	CU_ASSERT_PTR_NULL(get_int_entry(dict, "noKey"));
+
+	int_entry* e = get_int_entry(dict, "key42");
+	CU_ASSERT_PTR_EQUAL(increment_int_entry(dict, "key42"), e);
+	CU_ASSERT_EQUAL(e->value, 43);
+	CU_ASSERT_PTR_EQUAL(add_to_int_entry(dict, -50, "key42"), e);
+	CU_ASSERT_EQUAL(e->value, -7);
+	CU_ASSERT_PTR_EQUAL(add_int_entry(dict, 5, "key42"), e);
+	CU_ASSERT_EQUAL(e->value, 5);
+
+	CU_ASSERT_EQUAL(increment_int_entry(dict, "counter")->value, 1);
+	CU_ASSERT_EQUAL(add_to_int_entry(dict, 10, "other")->value, 10);
+	CU_ASSERT_EQUAL(get_number_of_int_entries(dict), max + 2);
+
+	CU_ASSERT_EQUAL(contains_int_key(dict, "counter"), 1);
+	CU_ASSERT_PTR_EQUAL(remove_int_entry(dict, "counter"), dict);
+	CU_ASSERT_PTR_NULL(remove_int_entry(dict, "counter"));
+	CU_ASSERT_EQUAL(contains_int_key(dict, "counter"), 0);
+	CU_ASSERT_EQUAL(contains_int_key(NULL, "counter"), -1);
+	CU_ASSERT_EQUAL(get_number_of_int_entries(dict), max + 1);
+
+	int_entry* shared = add_int_entry(dict, 0, "shared");
+	pthread_t threads[4];
+
+	for (i = 0; i < 4; i++) {
+		pthread_create(&threads[i], NULL, int_dictionary_worker, shared);
+	}
+
+	for (i = 0; i < 4; i++) {
+		pthread_join(threads[i], NULL);
+	}
+
+	CU_ASSERT_EQUAL(get_int_entry(dict, "shared")->value, 40000);
+	CU_ASSERT_EQUAL(atomic_add_to_int_entry(shared, 2), 40002);
+
+	delete_int_dictionary(&dict);
+	CU_ASSERT_PTR_NULL(dict);
+	CU_ASSERT_EQUAL(get_number_of_int_entries(dict), -1);
+}
+
+static void* double_dictionary_worker(void* arg) {
+	double_entry* e = (double_entry*)arg;
+
+	int i;
+	for (i = 0; i < 10000; i++) {
+		atomic_add_to_double_entry(e, 0.5);
+	}
+
+	return NULL;
+}
+
+void test_double_dictionary(void) {
+	double_dictionary* dict = create_double_dictionary();
+	CU_ASSERT_PTR_NOT_NULL(dict);
+
+	CU_ASSERT_PTR_NOT_NULL(add_double_entry(dict, 1.5, "a"));
+	CU_ASSERT_DOUBLE_EQUAL(add_to_double_entry(dict, 0.25, "a")->value, 1.75, 0.0001);
+	CU_ASSERT_DOUBLE_EQUAL(increment_double_entry(dict, "a")->value, 2.75, 0.0001);
+	CU_ASSERT_DOUBLE_EQUAL(add_to_double_entry(dict, -0.5, "b")->value, -0.5, 0.0001);
+	CU_ASSERT_EQUAL(get_number_of_double_entries(dict), 2);
+	CU_ASSERT_EQUAL(contains_double_key(dict, "b"), 1);
+
+	CU_ASSERT_PTR_EQUAL(remove_double_entry(dict, "b"), dict);
+	CU_ASSERT_PTR_NULL(get_double_entry(dict, "b"));
+	CU_ASSERT_EQUAL(get_number_of_double_entries(dict), 1);
+
+	double_entry* shared = add_double_entry(dict, 0.0, "shared");
+	pthread_t threads[4];
+
+	int i;
+	for (i = 0; i < 4; i++) {
+		pthread_create(&threads[i], NULL, double_dictionary_worker, shared);
+	}
+
+	for (i = 0; i < 4; i++) {
+		pthread_join(threads[i], NULL);
+	}
+
+	CU_ASSERT_DOUBLE_EQUAL(shared->value, 20000.0, 0.0001);
+
+	delete_double_dictionary(&dict);
+	CU_ASSERT_PTR_NULL(dict);
+}
+
+void test_int_dictionary_performance(void) {
+	const int keys = 1000;
+	const int bumps = 10000000;
+
+	char key[32];
+	int zero = 0;
+
+	entry* dict = create_dictionary(&zero, sizeof(int), "key0");
+	int_dictionary* counters = create_int_dictionary();
+
+	int i;
+	for (i = 0; i < keys; i++) {
+		sprintf(key, "key%d", i);
+		add_entry(dict, &zero, sizeof(int), key);
+		add_int_entry(counters, 0, key);
+	}
+
+	char** names = (char**)malloc(sizeof(char*) * keys);
+	for (i = 0; i < keys; i++) {
+		names[i] = (char*)malloc(16);
+		sprintf(names[i], "key%d", i);
+	}
+
+	double start = get_wall_seconds();
+
+	for (i = 0; i < bumps / 100; i++) {
+		const char* name = names[i % keys];
+		int value = *(int*)get_entry(dict, name)->value + 1;
+		add_entry(dict, &value, sizeof(int), name);
+	}
+
+	double end = get_wall_seconds();
+
+	printf("%d counter bumps in a dictionary have taken %f seconds\n", bumps / 100, end - start);
+
+	start = get_wall_seconds();
+
+	for (i = 0; i < bumps; i++) {
+		increment_int_entry(counters, names[i % keys]);
+	}
+
+	end = get_wall_seconds();
+
+	printf("%d counter bumps in an int dictionary have taken %f seconds\n", bumps, end - start);
+
+	for (i = 0; i < keys; i++) {
+		free(names[i]);
+	}
+
+	free(names);
+	delete_int_dictionary(&counters);
+	delete_dictionary(&dict);
+}
+
+static void lru_evict_counter(const char* key, void* value, size_t value_size, void* user_data) {
+	(void)key;
+	(void)value_size;
+
+	*(int*)user_data += *(int*)value;
+}
+
+void test_lru_cache(void) {
+	int evicted = 0;
+	lru_cache* cache = create_lru_cache(3, 0, lru_evict_counter, &evicted);
+	CU_ASSERT_PTR_NOT_NULL(cache);
+	CU_ASSERT_PTR_NULL(create_lru_cache(-1, 0, NULL, NULL));
+
+	int one = 1, two = 2, three = 3, four = 4;
+	CU_ASSERT_PTR_NOT_NULL(put_lru_entry(cache, &one, sizeof(int), "one"));
+	CU_ASSERT_PTR_NOT_NULL(put_lru_entry(cache, &two, sizeof(int), "two"));
+	CU_ASSERT_PTR_NOT_NULL(put_lru_entry(cache, &three, sizeof(int), "three"));
+	CU_ASSERT_EQUAL(get_number_of_lru_entries(cache), 3);
+
+	/* touching "one" makes "two" the least recently used entry */
+	CU_ASSERT_EQUAL(*(int*)get_lru_entry(cache, "one")->value, 1);
+	CU_ASSERT_PTR_NOT_NULL(put_lru_entry(cache, &four, sizeof(int), "four"));
+	CU_ASSERT_EQUAL(get_number_of_lru_entries(cache), 3);
+	CU_ASSERT_EQUAL(contains_lru_key(cache, "two"), 0);
+	CU_ASSERT_EQUAL(evicted, 2);
+
+	CU_ASSERT_PTR_NULL(get_lru_entry(cache, "two"));
+	CU_ASSERT_EQUAL(*(int*)peek_lru_entry(cache, "three")->value, 3);
+
+	/* peek does not refresh, so "three" goes next */
+	CU_ASSERT_PTR_NOT_NULL(put_lru_entry(cache, &two, sizeof(int), "two"));
+	CU_ASSERT_EQUAL(contains_lru_key(cache, "three"), 0);
+	CU_ASSERT_EQUAL(evicted, 5);
+
+	/* replacing a value keeps the count */
+	CU_ASSERT_PTR_NOT_NULL(put_lru_entry(cache, &three, sizeof(int), "one"));
+	CU_ASSERT_EQUAL(*(int*)peek_lru_entry(cache, "one")->value, 3);
+	CU_ASSERT_EQUAL(get_number_of_lru_entries(cache), 3);
+
+	lru_stats stats;
+	CU_ASSERT_EQUAL(get_lru_stats(cache, &stats), 0);
+	CU_ASSERT_EQUAL(stats.hits, 1);
+	CU_ASSERT_EQUAL(stats.misses, 1);
+	CU_ASSERT_EQUAL(stats.evictions, 2);
+	CU_ASSERT_EQUAL(get_lru_stats(NULL, &stats), -1);
+
+	CU_ASSERT_PTR_EQUAL(remove_lru_entry(cache, "one"), cache);
+	CU_ASSERT_PTR_NULL(remove_lru_entry(cache, "one"));
+	CU_ASSERT_EQUAL(get_number_of_lru_entries(cache), 2);
+	CU_ASSERT_EQUAL(evicted, 5);
+
+	delete_lru_cache(&cache);
+	CU_ASSERT_PTR_NULL(cache);
+	CU_ASSERT_EQUAL(get_number_of_lru_entries(cache), -1);
+
+	/* byte limit: every entry costs 100 value bytes plus "kN" */
+	cache = create_lru_cache(0, 350, NULL, NULL);
+	char block[100];
+	memset(block, 'x', sizeof(block));
+
+	char key[16];
+	int i;
+	for (i = 0; i < 1000; i++) {
+		sprintf(key, "k%d", i % 10);
+		CU_ASSERT_PTR_NOT_NULL(put_lru_entry(cache, block, sizeof(block), key));
+		CU_ASSERT(get_lru_cache_size(cache) <= 350);
+	}
+
+	CU_ASSERT_EQUAL(get_number_of_lru_entries(cache), 3);
+	CU_ASSERT_EQUAL(contains_lru_key(cache, "k9"), 1);
+	CU_ASSERT_EQUAL(contains_lru_key(cache, "k6"), 0);
+	CU_ASSERT_EQUAL(get_lru_cache_size(cache), 309);
+
+	char big[400];
+	CU_ASSERT_PTR_NULL(put_lru_entry(cache, big, sizeof(big), "big"));
+	CU_ASSERT_EQUAL(get_number_of_lru_entries(cache), 3);
+
+	delete_lru_cache(&cache);
+
+	/* unbounded cache grows its index */
+	cache = create_lru_cache(0, 0, NULL, NULL);
+	for (i = 0; i < 1000; i++) {
+		sprintf(key, "key%d", i);
+		put_lru_entry(cache, &i, sizeof(int), key);
+	}
+
+	CU_ASSERT_EQUAL(get_number_of_lru_entries(cache), 1000);
+	CU_ASSERT_EQUAL(*(int*)get_lru_entry(cache, "key777")->value, 777);
+
+	delete_lru_cache(&cache);
+}
+
+static uint64_t fake_clock(void* user_data) {
+	return *(uint64_t*)user_data;
+}
+
+void test_expiring_dictionary(void) {
+	uint64_t now = 1000;
+	expiring_dictionary* dict = create_expiring_dictionary(fake_clock, &now);
+	CU_ASSERT_PTR_NOT_NULL(dict);
+
+	int value = 1;
+	CU_ASSERT_PTR_NOT_NULL(add_expiring_entry(dict, &value, sizeof(int), "short", 10));
+	CU_ASSERT_PTR_NOT_NULL(add_expiring_entry(dict, &value, sizeof(int), "medium", 5000));
+	CU_ASSERT_PTR_NOT_NULL(add_expiring_entry(dict, &value, sizeof(int), "long", 100000000));
+	CU_ASSERT_EQUAL(get_number_of_expiring_entries(dict), 3);
+
+	now += 9;
+	CU_ASSERT_EQUAL(contains_expiring_key(dict, "short"), 1);
+
+	/* lookups never return stale entries, even before they are reaped */
+	now += 1;
+	CU_ASSERT_PTR_NULL(get_expiring_entry(dict, "short"));
+	CU_ASSERT_EQUAL(get_number_of_expiring_entries(dict), 2);
+
+	CU_ASSERT_PTR_NOT_NULL(refresh_expiring_entry(dict, "medium", 20000));
+	now += 6000;
+	CU_ASSERT_EQUAL(expire_entries(dict, 0), 0);
+	CU_ASSERT_EQUAL(contains_expiring_key(dict, "medium"), 1);
+
+	now += 14000;
+	CU_ASSERT_EQUAL(expire_entries(dict, 0), 1);
+	CU_ASSERT_EQUAL(contains_expiring_key(dict, "medium"), 0);
+
+	now = 1000 + 100000000 - 1;
+	CU_ASSERT_EQUAL(contains_expiring_key(dict, "long"), 1);
+	now += 1;
+	CU_ASSERT_EQUAL(expire_entries(dict, 0), 1);
+	CU_ASSERT_EQUAL(get_number_of_expiring_entries(dict), 0);
+
+	/* many deadlines spread over every level of the wheel, key0 expires at once */
+	char key[32];
+	const int max = 5000;
+
+	int i;
+	for (i = 0; i < max; i++) {
+		sprintf(key, "key%d", i);
+		add_expiring_entry(dict, &i, sizeof(int), key, (uint64_t)i * i);
+	}
+
+	CU_ASSERT_PTR_NOT_NULL(add_expiring_entry(dict, &value, sizeof(int), "key1", 1000000000));
+	CU_ASSERT_PTR_EQUAL(remove_expiring_entry(dict, "key2"), dict);
+	CU_ASSERT_PTR_NULL(remove_expiring_entry(dict, "key2"));
+
+	int expired = 0;
+	uint64_t start = now;
+	for (i = 3; i < max; i++) {
+		now = start + (uint64_t)i * i;
+		expired += expire_entries(dict, 0);
+		CU_ASSERT_EQUAL(get_number_of_expiring_entries(dict), max - i);
+	}
+
+	CU_ASSERT_EQUAL(expired, max - 2);
+	CU_ASSERT_EQUAL(contains_expiring_key(dict, "key1"), 1);
+
+	/* reaping in small steps */
+	for (i = 0; i < 100; i++) {
+		sprintf(key, "batch%d", i);
+		add_expiring_entry(dict, &i, sizeof(int), key, 5);
+	}
+
+	now += 5;
+	CU_ASSERT_EQUAL(expire_entries(dict, 30), 30);
+	CU_ASSERT_EQUAL(expire_entries(dict, 30), 30);
+	CU_ASSERT_EQUAL(expire_entries(dict, 0), 40);
+	CU_ASSERT_EQUAL(expire_entries(NULL, 0), -1);
+
+	delete_expiring_dictionary(&dict);
+	CU_ASSERT_PTR_NULL(dict);
+
+	dict = create_expiring_dictionary(NULL, NULL);
+	CU_ASSERT_PTR_NOT_NULL(add_expiring_entry(dict, &value, sizeof(int), "real", 60000));
+	CU_ASSERT_EQUAL(contains_expiring_key(dict, "real"), 1);
+	delete_expiring_dictionary(&dict);
+}
+
+static void* persistent_reader_worker(void* arg) {
+	persistent_dictionary* snapshot = (persistent_dictionary*)arg;
+	char key[32];
+	long found = 0;
+
+	int round, i;
+	for (round = 0; round < 20; round++) {
+		for (i = 0; i < 1000; i++) {
+			sprintf(key, "key%d", i);
+			const persistent_entry* e = get_persistent_entry(snapshot, key);
+
+			if (e != NULL && *(int*)e->value == i) found++;
+		}
+	}
+
+	delete_persistent_dictionary(&snapshot);
+
+	return (void*)found;
+}
+
+void test_persistent_dictionary(void) {
+	persistent_dictionary* dict = create_persistent_dictionary();
+	CU_ASSERT_PTR_NOT_NULL(dict);
+	CU_ASSERT_EQUAL(get_number_of_persistent_entries(dict), 0);
+	CU_ASSERT_PTR_NULL(get_persistent_entry(dict, "key0"));
+
+	char key[32];
+	const int max = 1000;
+
+	int i;
+	for (i = 0; i < max; i++) {
+		sprintf(key, "key%d", i);
+		CU_ASSERT_PTR_NOT_NULL(add_persistent_entry(dict, &i, sizeof(int), key));
+	}
+
+	CU_ASSERT_EQUAL(get_number_of_persistent_entries(dict), max);
+
+	persistent_dictionary* snapshot = snapshot_persistent_dictionary(dict);
+	CU_ASSERT_PTR_NOT_NULL(snapshot);
+
+	/* change every key of the live version */
+	for (i = 0; i < max; i++) {
+		sprintf(key, "key%d", i);
+		int value = -i;
+
+		if (i % 2 == 0) CU_ASSERT_PTR_EQUAL(remove_persistent_entry(dict, key), dict);
+		else CU_ASSERT_PTR_NOT_NULL(add_persistent_entry(dict, &value, sizeof(int), key));
+	}
+
+	CU_ASSERT_PTR_NULL(remove_persistent_entry(dict, "key0"));
+	CU_ASSERT_EQUAL(get_number_of_persistent_entries(dict), max / 2);
+	CU_ASSERT_EQUAL(get_number_of_persistent_entries(snapshot), max);
+
+	for (i = 0; i < max; i++) {
+		sprintf(key, "key%d", i);
+
+		const persistent_entry* old = get_persistent_entry(snapshot, key);
+		CU_ASSERT_PTR_NOT_NULL(old);
+		if (old != NULL) CU_ASSERT_EQUAL(*(int*)old->value, i);
+
+		const persistent_entry* current = get_persistent_entry(dict, key);
+		if (i % 2 == 0) CU_ASSERT_PTR_NULL(current);
+		else if (current != NULL) CU_ASSERT_EQUAL(*(int*)current->value, -i);
+	}
+
+	CU_ASSERT_EQUAL(contains_persistent_key(snapshot, "key0"), 1);
+	CU_ASSERT_EQUAL(contains_persistent_key(dict, "key0"), 0);
+	CU_ASSERT_EQUAL(contains_persistent_key(NULL, "key0"), -1);
+
+	/* the live version can be emptied and refilled */
+	for (i = 1; i < max; i += 2) {
+		sprintf(key, "key%d", i);
+		CU_ASSERT_PTR_EQUAL(remove_persistent_entry(dict, key), dict);
+	}
+
+	CU_ASSERT_EQUAL(get_number_of_persistent_entries(dict), 0);
+	CU_ASSERT_PTR_NOT_NULL(add_persistent_entry(dict, &max, sizeof(int), "key0"));
+
+	delete_persistent_dictionary(&dict);
+	CU_ASSERT_PTR_NULL(dict);
+	CU_ASSERT_EQUAL(*(int*)get_persistent_entry(snapshot, "key999")->value, 999);
+
+	/* snapshots are read by other threads while the owner keeps writing */
+	pthread_t threads[4];
+	for (i = 0; i < 4; i++) {
+		pthread_create(&threads[i], NULL, persistent_reader_worker, snapshot_persistent_dictionary(snapshot));
+	}
+
+	for (i = 0; i < max; i++) {
+		sprintf(key, "key%d", i);
+		remove_persistent_entry(snapshot, key);
+	}
+
+	for (i = 0; i < 4; i++) {
+		void* found;
+		pthread_join(threads[i], &found);
+		CU_ASSERT_EQUAL((long)found, 20 * max);
+	}
+
+	CU_ASSERT_EQUAL(get_number_of_persistent_entries(snapshot), 0);
+	delete_persistent_dictionary(&snapshot);
+}
+
+void test_multimap(void) {
+	CU_ASSERT_PTR_NULL(create_multimap(0));
+
+	multimap* map = create_multimap(sizeof(int));
+	CU_ASSERT_PTR_NOT_NULL(map);
+	CU_ASSERT_EQUAL(get_number_of_multimap_keys(map), 0);
+
+	char key[32];
+	const int keys = 100;
+	const int per_key = 50;
+
+	int i, j;
+	for (j = 0; j < per_key; j++) {
+		for (i = 0; i < keys; i++) {
+			sprintf(key, "key%d", i);
+			int value = i * 1000 + j;
+			CU_ASSERT_PTR_NOT_NULL(add_multimap_value(map, &value, key));
+		}
+	}
+
+	CU_ASSERT_EQUAL(get_number_of_multimap_keys(map), keys);
+	CU_ASSERT_EQUAL(get_number_of_multimap_values(map), keys * per_key);
+
+	int count = 0;
+	const int* values = (const int*)get_multimap_values(map, "key42", &count);
+	CU_ASSERT_PTR_NOT_NULL(values);
+	CU_ASSERT_EQUAL(count, per_key);
+
+	for (j = 0; j < count; j++) {
+		CU_ASSERT_EQUAL(values[j], 42000 + j);
+	}
+
+	CU_ASSERT_PTR_NULL(get_multimap_values(map, "noKey", &count));
+
+	int value = 42010;
+	CU_ASSERT_PTR_EQUAL(remove_multimap_value(map, &value, "key42"), map);
+	CU_ASSERT_PTR_NULL(remove_multimap_value(map, &value, "key42"));
+	CU_ASSERT_PTR_NULL(remove_multimap_value(map, &value, "noKey"));
+
+	values = (const int*)get_multimap_values(map, "key42", &count);
+	CU_ASSERT_EQUAL(count, per_key - 1);
+	CU_ASSERT_EQUAL(values[9], 42009);
+	CU_ASSERT_EQUAL(values[10], 42011);
+	CU_ASSERT_EQUAL(get_number_of_multimap_values(map), keys * per_key - 1);
+
+	/* duplicates are kept and removed one at a time */
+	value = 7;
+	add_multimap_value(map, &value, "dup");
+	add_multimap_value(map, &value, "dup");
+	CU_ASSERT_PTR_EQUAL(remove_multimap_value(map, &value, "dup"), map);
+	CU_ASSERT_EQUAL(contains_multimap_key(map, "dup"), 1);
+	CU_ASSERT_PTR_EQUAL(remove_multimap_value(map, &value, "dup"), map);
+	CU_ASSERT_EQUAL(contains_multimap_key(map, "dup"), 0);
+
+	CU_ASSERT_PTR_EQUAL(remove_multimap_key(map, "key0"), map);
+	CU_ASSERT_PTR_NULL(remove_multimap_key(map, "key0"));
+	CU_ASSERT_EQUAL(get_number_of_multimap_keys(map), keys - 1);
+	CU_ASSERT_EQUAL(get_number_of_multimap_values(map), (keys - 1) * per_key - 1);
+	CU_ASSERT_EQUAL(contains_multimap_key(NULL, "key1"), -1);
+
+	delete_multimap(&map);
+	CU_ASSERT_PTR_NULL(map);
+	CU_ASSERT_EQUAL(get_number_of_multimap_values(map), -1);
+}
+
+void test_load_dictionary_performance(void) {
+	const int max = 1000000;
+	const char* path = "dictionary_performance.txt";
+
+	FILE* file = fopen(path, "wb");
+
+	int i;
+	for (i = 0; i < max; i++) {
+		fprintf(file, "key%d\tvalue%d\n", i, i);
+	}
+
+	fclose(file);
+
+	double start = get_wall_seconds();
+	entry* dict = load_dictionary_delimited(path, '\t');
+	double end = get_wall_seconds();
+
+	printf("Loading %d lines into a dictionary has taken %f seconds (%d entries)\n", max, end - start, get_number_of_entries(dict));
+
+	delete_dictionary(&dict);
+	remove(path);
+}
+
+void test_hash(void) {
+	CU_ASSERT_EQUAL(hash_fnv1a("a", 1, 0), 0xaf63dc4c8601ec8cULL);
+
+	hash_function functions[4] = {hash_fnv1a, hash_wyhash, hash_crc32c, hash_siphash};
+	char key[128];
+
+	int f, length;
+	for (f = 0; f < 4; f++) {
+		for (length = 0; length < (int)sizeof(key); length++) {
+			memset(key, 'a', sizeof(key));
+			uint64_t hash = functions[f](key, (size_t)length, 42);
+
+			CU_ASSERT_EQUAL(functions[f](key, (size_t)length, 42), hash);
+			CU_ASSERT_NOT_EQUAL(functions[f](key, (size_t)length, 43), hash);
+
+			if (length > 0) {
+				key[length - 1] = 'b';
+				CU_ASSERT_NOT_EQUAL(functions[f](key, (size_t)length, 42), hash);
+			}
+		}
+	}
+
+	CU_ASSERT_NOT_EQUAL(create_hash_seed(), create_hash_seed());
+
+	/* containers keep the hasher they were created with */
+	set_default_hasher(hash_siphash, create_hash_seed());
+	CU_ASSERT_PTR_EQUAL(get_default_hasher().function, hash_siphash);
+
+	concurrent_dictionary* dict = create_concurrent_dictionary(4);
+	int i;
+	for (i = 0; i < 100; i++) {
+		sprintf(key, "key%d", i);
+		add_concurrent_entry(dict, &i, sizeof(int), key);
+	}
+
+	set_default_hasher(NULL, 0);
+	CU_ASSERT_PTR_EQUAL(get_default_hasher().function, hash_wyhash);
+	CU_ASSERT_EQUAL(get_default_hasher().seed, 0);
+
+	int value = -1;
+	CU_ASSERT_EQUAL(get_concurrent_entry(dict, "key77", &value, sizeof(int)), (int)sizeof(int));
+	CU_ASSERT_EQUAL(value, 77);
+	CU_ASSERT_EQUAL(hash_key("key77", 5), hash_wyhash("key77", 5, 0));
+
+	delete_concurrent_dictionary(&dict);
+}
+
+void test_hash_performance(void) {
+	const int max = 1000000;
+	const size_t lengths[3] = {8, 32, 256};
+
+	hash_function functions[4] = {hash_fnv1a, hash_wyhash, hash_crc32c, hash_siphash};
+	const char* names[4] = {"fnv1a", "wyhash", "crc32c", "siphash"};
+
+	char* keys = (char*)malloc((size_t)max * 16);
+	char* block = (char*)malloc(256);
+
+	int i;
+	for (i = 0; i < max; i++) {
+		sprintf(keys + (size_t)i * 16, "key%d", i);
+	}
+
+	for (i = 0; i < 256; i++) {
+		block[i] = (char)('a' + i % 26);
+	}
+
+	int f;
+	for (f = 0; f < 4; f++) {
+		/* sequential short keys like our ids, bucket balance over 2^16 buckets */
+		int* buckets = (int*)calloc(1 << 16, sizeof(int));
+		volatile uint64_t sink = 0;
+
+		double start = get_wall_seconds();
+
+		for (i = 0; i < max; i++) {
+			const char* key = keys + (size_t)i * 16;
+			uint64_t hash = functions[f](key, strlen(key), 0);
+
+			buckets[hash & 0xffff]++;
+			sink ^= hash;
+		}
+
+		double end = get_wall_seconds();
+
+		int fullest = 0;
+		for (i = 0; i < 1 << 16; i++) {
+			if (buckets[i] > fullest) fullest = buckets[i];
+		}
+
+		printf("%-8s %d short keys: %f seconds, fullest of 65536 buckets %d (mean %.1f)\n", names[f], max, end - start, fullest, (double)max / (1 << 16));
+
+		int l;
+		for (l = 0; l < 3; l++) {
+			start = get_wall_seconds();
+
+			for (i = 0; i < max; i++) {
+				block[0] = (char)i;
+				sink ^= functions[f](block, lengths[l], 0);
+			}
+
+			end = get_wall_seconds();
+
+			printf("%-8s %d keys of %zu bytes: %f seconds\n", names[f], max, lengths[l], end - start);
+		}
+
+		free(buckets);
+	}
+
+	free(keys);
+	free(block);
+}
+
+void test_merge_concurrent_dictionaries(void) {
+	const int max = 10000;
+	char key[32];
+
+	concurrent_dictionary* total = create_concurrent_dictionary(16);
+	concurrent_dictionary* partials[4];
+
+	int i, t;
+	for (t = 0; t < 4; t++) {
+		/* the last partial has other shards and a different hasher, so it is rehashed */
+		if (t == 3) set_default_hasher(hash_fnv1a, 7);
+		partials[t] = create_concurrent_dictionary(t == 3 ? 4 : 16);
+		if (t == 3) set_default_hasher(NULL, 0);
+
+		for (i = 0; i < max; i++) {
+			sprintf(key, "key%d", i);
+			int value = i % (t + 1) == 0 ? 1 : 0;
+			add_concurrent_entry(partials[t], &value, sizeof(int), key);
+		}
+	}
+
+	for (t = 0; t < 4; t++) {
+		CU_ASSERT_EQUAL(merge_concurrent_dictionaries(total, partials[t], MERGE_COMBINE, add_int_values, 4), 0);
+	}
+
+	CU_ASSERT_EQUAL(get_number_of_concurrent_entries(total), max);
+
+	int value;
+	for (i = 0; i < max; i++) {
+		sprintf(key, "key%d", i);
+		get_concurrent_entry(total, key, &value, sizeof(int));
+
+		int expected = 0;
+		for (t = 0; t < 4; t++) {
+			if (i % (t + 1) == 0) expected++;
+		}
+
+		CU_ASSERT_EQUAL(value, expected);
+	}
+
+	value = -1;
+	add_concurrent_entry(partials[3], &value, sizeof(int), "extra");
+	CU_ASSERT_EQUAL(merge_concurrent_dictionaries(total, partials[3], MERGE_KEEP_DESTINATION, NULL, 2), 0);
+	get_concurrent_entry(total, "key0", &value, sizeof(int));
+	CU_ASSERT_EQUAL(value, 4);
+	CU_ASSERT_EQUAL(merge_concurrent_dictionaries(total, partials[0], MERGE_OVERWRITE, NULL, 1), 0);
+	get_concurrent_entry(total, "key0", &value, sizeof(int));
+	CU_ASSERT_EQUAL(value, 1);
+	CU_ASSERT_EQUAL(get_number_of_concurrent_entries(total), max + 1);
+
+	CU_ASSERT_EQUAL(merge_concurrent_dictionaries(total, total, MERGE_OVERWRITE, NULL, 1), -1);
+	CU_ASSERT_EQUAL(merge_concurrent_dictionaries(total, partials[0], MERGE_COMBINE, NULL, 1), -1);
+
+	for (t = 0; t < 4; t++) {
+		delete_concurrent_dictionary(&partials[t]);
+	}
+
+	delete_concurrent_dictionary(&total);
+}
+
+struct queue_args {
+	mpsc_queue* mpsc;
+	mpmc_queue* mpmc;
+	int id;
+	int count;
+	long long sum;
+};
+
+static void* mpsc_producer_worker(void* arg) {
+	struct queue_args* args = (struct queue_args*)arg;
+
+	int i;
+	for (i = 0; i < args->count; i++) {
+		long long value = ((long long)args->id << 32) | i;
+		enqueue_mpsc(args->mpsc, &value);
+	}
+
+	return NULL;
+}
+
+static void* mpmc_producer_worker(void* arg) {
+	struct queue_args* args = (struct queue_args*)arg;
+
+	int i;
+	for (i = 0; i < args->count; i++) {
+		long long value = i;
+		while (enqueue_mpmc(args->mpmc, &value) == -1) sched_yield();
+	}
+
+	return NULL;
+}
+
+static void* mpmc_consumer_worker(void* arg) {
+	struct queue_args* args = (struct queue_args*)arg;
+
+	int i;
+	for (i = 0; i < args->count; i++) {
+		long long value;
+		while (dequeue_mpmc(args->mpmc, &value) == -1) sched_yield();
+		args->sum += value;
+	}
+
+	return NULL;
+}
+
+void test_queue(void) {
+	CU_ASSERT_PTR_NULL(create_mpmc_queue(0, sizeof(int)));
+
+	mpmc_queue* ring = create_mpmc_queue(5, sizeof(int));
+	CU_ASSERT_PTR_NOT_NULL(ring);
+
+	int value;
+	CU_ASSERT_EQUAL(dequeue_mpmc(ring, &value), -1);
+
+	/* wrap around the ring a few times */
+	int i, lap;
+	for (lap = 0; lap < 3; lap++) {
+		for (i = 0; i < 8; i++) {
+			CU_ASSERT_EQUAL(enqueue_mpmc(ring, &i), 0);
+		}
+
+		CU_ASSERT_EQUAL(enqueue_mpmc(ring, &i), -1);
+
+		for (i = 0; i < 8; i++) {
+			CU_ASSERT_EQUAL(dequeue_mpmc(ring, &value), 0);
+			CU_ASSERT_EQUAL(value, i);
+		}
+
+		CU_ASSERT_EQUAL(dequeue_mpmc(ring, &value), -1);
+	}
+
+	delete_mpmc_queue(&ring);
+	CU_ASSERT_PTR_NULL(ring);
+
+	mpsc_queue* queue = create_mpsc_queue(sizeof(int));
+	CU_ASSERT_PTR_NOT_NULL(queue);
+	CU_ASSERT_EQUAL(dequeue_mpsc(queue, &value), -1);
+
+	for (i = 0; i < 3000; i++) {
+		CU_ASSERT_EQUAL(enqueue_mpsc(queue, &i), 0);
+
+		/* leave some values behind to exercise the stub handling */
+		if (i % 3 == 0) {
+			CU_ASSERT_EQUAL(dequeue_mpsc(queue, &value), 0);
+			CU_ASSERT_EQUAL(value, i / 3);
+		}
+	}
+
+	delete_mpsc_queue(&queue);
+	CU_ASSERT_PTR_NULL(queue);
+
+	/* producers keep their own order, nothing is lost or duplicated */
+	const int producers = 4;
+	const int count = 100000;
+
+	mpsc_queue* shared = create_mpsc_queue(sizeof(long long));
+	struct queue_args args[4];
+	pthread_t threads[8];
+
+	for (i = 0; i < producers; i++) {
+		args[i].mpsc = shared;
+		args[i].id = i;
+		args[i].count = count;
+		pthread_create(&threads[i], NULL, mpsc_producer_worker, &args[i]);
+	}
+
+	int expected[4] = {0, 0, 0, 0};
+	int received = 0;
+	int ordered = 1;
+
+	while (received < producers * count) {
+		long long item;
+
+		if (dequeue_mpsc(shared, &item) == 0) {
+			int producer = (int)(item >> 32);
+
+			if ((int)(item & 0xffffffff) != expected[producer]) ordered = 0;
+			expected[producer]++;
+			received++;
+		}
+		else {
+			sched_yield();
+		}
+	}
+
+	for (i = 0; i < producers; i++) {
+		pthread_join(threads[i], NULL);
+	}
+
+	CU_ASSERT_EQUAL(ordered, 1);
+	CU_ASSERT_EQUAL(dequeue_mpsc(shared, &value), -1);
+	delete_mpsc_queue(&shared);
+
+	ring = create_mpmc_queue(64, sizeof(long long));
+
+	for (i = 0; i < producers; i++) {
+		args[i].mpmc = ring;
+		args[i].count = count;
+		args[i].sum = 0;
+	}
+
+	struct queue_args consumers[4];
+	for (i = 0; i < producers; i++) {
+		consumers[i].mpmc = ring;
+		consumers[i].count = count;
+		consumers[i].sum = 0;
+		pthread_create(&threads[i], NULL, mpmc_producer_worker, &args[i]);
+		pthread_create(&threads[producers + i], NULL, mpmc_consumer_worker, &consumers[i]);
+	}
+
+	long long sum = 0;
+	for (i = 0; i < producers; i++) {
+		pthread_join(threads[i], NULL);
+		pthread_join(threads[producers + i], NULL);
+		sum += consumers[i].sum;
+	}
+
+	CU_ASSERT_EQUAL(sum, (long long)producers * count * (count - 1) / 2);
+	delete_mpmc_queue(&ring);
+}
+
+void test_queue_performance(void) {
+	const int total = 2000000;
+
+	int producers;
+	for (producers = 1; producers <= 64; producers *= 2) {
+		mpsc_queue* queue = create_mpsc_queue(sizeof(long long));
+		struct queue_args* args = (struct queue_args*)malloc(sizeof(struct queue_args) * producers);
+		pthread_t* threads = (pthread_t*)malloc(sizeof(pthread_t) * producers);
+
+		double start = get_wall_seconds();
+
+		int i;
+		for (i = 0; i < producers; i++) {
+			args[i].mpsc = queue;
+			args[i].id = i;
+			args[i].count = total / producers;
+			pthread_create(&threads[i], NULL, mpsc_producer_worker, &args[i]);
+		}
+
+		int received = 0;
+		long long item;
+
+		while (received < total / producers * producers) {
+			if (dequeue_mpsc(queue, &item) == 0) received++;
+			else sched_yield();
+		}
+
+		for (i = 0; i < producers; i++) {
+			pthread_join(threads[i], NULL);
+		}
+
+		double end = get_wall_seconds();
+
+		printf("mpsc queue with %d producers: %.1f million values per second\n", producers, received / (end - start) / 1e6);
+
+		delete_mpsc_queue(&queue);
+
+		mpmc_queue* ring = create_mpmc_queue(4096, sizeof(long long));
+		struct queue_args consumer = {NULL, ring, 0, total / producers * producers, 0};
+		pthread_t consumer_thread;
+
+		start = get_wall_seconds();
+
+		for (i = 0; i < producers; i++) {
+			args[i].mpmc = ring;
+			args[i].count = total / producers;
+			pthread_create(&threads[i], NULL, mpmc_producer_worker, &args[i]);
+		}
+
+		pthread_create(&consumer_thread, NULL, mpmc_consumer_worker, &consumer);
+
+		for (i = 0; i < producers; i++) {
+			pthread_join(threads[i], NULL);
+		}
+
+		pthread_join(consumer_thread, NULL);
+		end = get_wall_seconds();
+
+		printf("mpmc ring with %d producers: %.1f million values per second\n", producers, consumer.count / (end - start) / 1e6);
+
+		delete_mpmc_queue(&ring);
+		free(args);
+		free(threads);
+	}
+}
+
+struct steal_args {
+	work_deque* deque;
+	atomic_int* done;
+	long long sum;
+	int count;
+};
+
+static void* steal_worker(void* arg) {
+	struct steal_args* args = (struct steal_args*)arg;
+
+	while (!atomic_load(args->done) || get_work_count(args->deque) > 0) {
+		void* item = steal_work(args->deque);
+
+		if (item != NULL) {
+			args->sum += (long long)(intptr_t)item;
+			args->count++;
+		}
+		else {
+			sched_yield();
+		}
+	}
+
+	return NULL;
+}
+
+void test_work_deque(void) {
+	work_deque* deque = create_work_deque(4);
+	CU_ASSERT_PTR_NOT_NULL(deque);
+	CU_ASSERT_PTR_NULL(pop_work(deque));
+	CU_ASSERT_PTR_NULL(steal_work(deque));
+	CU_ASSERT_EQUAL(push_work(deque, NULL), -1);
+
+	/* more items than the initial array holds */
+	intptr_t i;
+	for (i = 1; i <= 100; i++) {
+		CU_ASSERT_EQUAL(push_work(deque, (void*)i), 0);
+	}
+
+	CU_ASSERT_EQUAL(get_work_count(deque), 100);
+	CU_ASSERT_EQUAL((intptr_t)pop_work(deque), 100);
+	CU_ASSERT_EQUAL((intptr_t)steal_work(deque), 1);
+	CU_ASSERT_EQUAL((intptr_t)steal_work(deque), 2);
+	CU_ASSERT_EQUAL((intptr_t)pop_work(deque), 99);
+	CU_ASSERT_EQUAL(get_work_count(deque), 96);
+
+	while (pop_work(deque) != NULL);
+	CU_ASSERT_EQUAL(get_work_count(deque), 0);
+
+	/* the owner pushes and pops while thieves steal, every item is taken once */
+	const int max = 200000;
+	atomic_int done;
+	atomic_init(&done, 0);
+
+	struct steal_args args[3];
+	pthread_t threads[3];
+
+	int t;
+	for (t = 0; t < 3; t++) {
+		args[t].deque = deque;
+		args[t].done = &done;
+		args[t].sum = 0;
+		args[t].count = 0;
+		pthread_create(&threads[t], NULL, steal_worker, &args[t]);
+	}
+
+	long long sum = 0;
+	int count = 0;
+
+	for (i = 1; i <= max; i++) {
+		push_work(deque, (void*)i);
+
+		if (i % 3 == 0) {
+			void* item = pop_work(deque);
+
+			if (item != NULL) {
+				sum += (long long)(intptr_t)item;
+				count++;
+			}
+		}
+	}
+
+	void* item;
+	while ((item = pop_work(deque)) != NULL) {
+		sum += (long long)(intptr_t)item;
+		count++;
+	}
+
+	atomic_store(&done, 1);
+
+	for (t = 0; t < 3; t++) {
+		pthread_join(threads[t], NULL);
+		sum += args[t].sum;
+		count += args[t].count;
+	}
+
+	CU_ASSERT_EQUAL(count, max);
+	CU_ASSERT_EQUAL(sum, (long long)max * (max + 1) / 2);
+
+	delete_work_deque(&deque);
+	CU_ASSERT_PTR_NULL(deque);
+}
+
+struct pool_args {
+	thread_pool* pool;
+	atomic_int* counter;
+	int children;
+};
+
+static void count_task(void* arg) {
+	atomic_fetch_add((atomic_int*)arg, 1);
+}
+
+static void spawn_task(void* arg) {
+	struct pool_args* args = (struct pool_args*)arg;
+
+	/* tasks may wait for tasks they submit themselves */
+	task_group group;
+	init_task_group(&group);
+
+	int i;
+	for (i = 0; i < args->children; i++) {
+		submit_task(args->pool, &group, count_task, args->counter);
+	}
+
+	wait_task_group(args->pool, &group);
+	atomic_fetch_add(args->counter, 1);
+}
+
+void test_thread_pool(void) {
+	CU_ASSERT_PTR_NULL(create_thread_pool(0));
+
+	thread_pool* pool = create_thread_pool(3);
+	CU_ASSERT_PTR_NOT_NULL(pool);
+	CU_ASSERT_EQUAL(get_thread_count(pool), 3);
+	CU_ASSERT_EQUAL(get_thread_count(NULL), -1);
+
+	atomic_int counter;
+	atomic_init(&counter, 0);
+
+	task_group group;
+	init_task_group(&group);
+	CU_ASSERT_EQUAL(submit_task(pool, &group, NULL, NULL), -1);
+
+	int i;
+	for (i = 0; i < 1000; i++) {
+		CU_ASSERT_EQUAL(submit_task(pool, &group, count_task, &counter), 0);
+	}
+
+	wait_task_group(pool, &group);
+	CU_ASSERT_EQUAL(atomic_load(&counter), 1000);
+
+	struct pool_args args = {pool, &counter, 50};
+	atomic_store(&counter, 0);
+
+	for (i = 0; i < 20; i++) {
+		submit_task(pool, &group, spawn_task, &args);
+	}
+
+	wait_task_group(pool, &group);
+	CU_ASSERT_EQUAL(atomic_load(&counter), 20 * 51);
+
+	/* pending tasks still run when the pool is deleted */
+	atomic_store(&counter, 0);
+
+	for (i = 0; i < 100; i++) {
+		submit_task(pool, &group, count_task, &counter);
+	}
+
+	delete_thread_pool(&pool);
+	CU_ASSERT_PTR_NULL(pool);
+	CU_ASSERT_EQUAL(atomic_load(&counter), 100);
+
+	CU_ASSERT_PTR_NOT_NULL(get_default_thread_pool());
+	CU_ASSERT_PTR_EQUAL(get_default_thread_pool(), get_default_thread_pool());
+}
+
+static void add_to_sum(void* value, void* context) {
+	atomic_fetch_add((atomic_llong*)context, *(int*)value);
+}
+
+static void square_int(const void* value, void* result, void* context) {
+	(void)context;
+	*(long long*)result = (long long)*(const int*)value * *(const int*)value;
+}
+
+static int is_multiple(const void* value, void* context) {
+	return *(const int*)value % *(int*)context == 0;
+}
+
+static void accumulate_sum(void* result, const void* value, void* context) {
+	(void)context;
+	*(long long*)result += *(const int*)value;
+}
+
+static void merge_sum(void* destination, const void* source, void* context) {
+	(void)context;
+	*(long long*)destination += *(const long long*)source;
+}
+
+/* keeps the first value only, detects segments merged out of order */
+static void accumulate_first(void* result, const void* value, void* context) {
+	(void)context;
+	if (*(int*)result < 0) *(int*)result = *(const int*)value;
+}
+
+static void merge_first(void* destination, const void* source, void* context) {
+	(void)context;
+	if (*(int*)destination < 0) *(int*)destination = *(const int*)source;
+}
+
+void test_list_parallel(void) {
+	const int lengths[] = {1, 2, 7, 100, 10007};
+
+	int l;
+	for (l = 0; l < 5; l++) {
+		int length = lengths[l];
+		int* values = (int*)malloc(sizeof(int) * length);
+
+		int i;
+		for (i = 0; i < length; i++) {
+			values[i] = i + 1;
+		}
+
+		element* list = create_list_with_array(values, sizeof(int), length);
+		long long sum = (long long)length * (length + 1) / 2;
+
+		atomic_llong total;
+		atomic_init(&total, 0);
+		CU_ASSERT_EQUAL(for_each_element_parallel(list, add_to_sum, &total), 0);
+		CU_ASSERT_EQUAL(atomic_load(&total), sum);
+
+		element* squares = map_list_parallel(list, sizeof(long long), square_int, NULL);
+		CU_ASSERT_EQUAL(get_length_of_list(squares), length);
+
+		int valid = 1;
+		element* iterator = squares;
+		for (i = 1; iterator != NULL; i++, iterator = iterator->next) {
+			valid &= *(long long*)iterator->value == (long long)i * i;
+		}
+
+		CU_ASSERT_TRUE(valid);
+		delete_list(&squares);
+
+		int divisor = 3;
+		element* multiples = filter_list_parallel(list, sizeof(int), is_multiple, &divisor);
+		if (length < 3) CU_ASSERT_PTR_NULL(multiples);
+		else CU_ASSERT_EQUAL(get_length_of_list(multiples), length / 3);
+
+		valid = 1;
+		iterator = multiples;
+		for (i = 1; iterator != NULL; i++, iterator = iterator->next) {
+			valid &= *(int*)iterator->value == i * 3;
+		}
+
+		CU_ASSERT_TRUE(valid);
+		delete_list(&multiples);
+
+		long long reduced = -1;
+		long long zero = 0;
+		CU_ASSERT_EQUAL(reduce_list_parallel(list, &reduced, sizeof(long long), &zero, accumulate_sum, merge_sum, NULL), 0);
+		CU_ASSERT_EQUAL(reduced, sum);
+
+		int first = 0;
+		int none = -1;
+		CU_ASSERT_EQUAL(reduce_list_parallel(list, &first, sizeof(int), &none, accumulate_first, merge_first, NULL), 0);
+		CU_ASSERT_EQUAL(first, 1);
+
+		delete_list(&list);
+		free(values);
+	}
+
+	element* empty = create_empty_list();
+	int divisor = 1;
+	long long reduced = -1;
+	long long zero = 0;
+
+	CU_ASSERT_PTR_NULL(map_list_parallel(empty, sizeof(long long), square_int, NULL));
+	CU_ASSERT_PTR_NULL(filter_list_parallel(empty, sizeof(int), is_multiple, &divisor));
+	CU_ASSERT_EQUAL(reduce_list_parallel(empty, &reduced, sizeof(long long), &zero, accumulate_sum, merge_sum, NULL), 0);
+	CU_ASSERT_EQUAL(reduced, 0);
+
+	CU_ASSERT_EQUAL(for_each_element_parallel(NULL, add_to_sum, NULL), -1);
+	CU_ASSERT_PTR_NULL(map_list_parallel(empty, 0, square_int, NULL));
+	CU_ASSERT_EQUAL(reduce_list_parallel(empty, NULL, sizeof(long long), &zero, accumulate_sum, merge_sum, NULL), -1);
+
+	delete_list(&empty);
+}
+
+/* CPU heavy work per element, the case the parallel operations are made for */
+static void heavy_transform(const void* value, void* result, void* context) {
+	(void)context;
+	double x = *(const int*)value;
+
+	int i;
+	for (i = 0; i < 2000; i++) {
+		x = x * 0.999999 + 1.0;
+	}
+
+	*(double*)result = x;
+}
+
+void test_list_parallel_performance(void) {
+	const int length = 200000;
+	int* values = (int*)malloc(sizeof(int) * length);
+
+	int i;
+	for (i = 0; i < length; i++) {
+		values[i] = i;
+	}
+
+	element* list = create_list_with_array(values, sizeof(int), length);
+
+	double start = get_wall_seconds();
+
+	element* sequential = create_empty_list();
+	element* tail = sequential;
+	element* iterator;
+	for (iterator = list; iterator != NULL; iterator = iterator->next) {
+		double result;
+		heavy_transform(iterator->value, &result, NULL);
+		tail = add_element(tail, &result, sizeof(double));
+	}
+
+	double end = get_wall_seconds();
+	printf("sequential map of %d elements: %.3f seconds\n", length, end - start);
+
+	start = get_wall_seconds();
+	element* parallel = map_list_parallel(list, sizeof(double), heavy_transform, NULL);
+	end = get_wall_seconds();
+
+	printf("parallel map of %d elements with %d workers: %.3f seconds\n", length,
+		get_thread_count(get_default_thread_pool()), end - start);
+
+	delete_list(&sequential);
+	delete_list(&parallel);
+	delete_list(&list);
+	free(values);
+}
+
+struct node_cache_args {
+	element** lists;
+	entry** dictionaries;
+	int count;
+	int length;
+	int valid;
+};
+
+static void* build_nodes_worker(void* arg) {
+	struct node_cache_args* args = (struct node_cache_args*)arg;
+
+	int i;
+	for (i = 0; i < args->count; i++) {
+		int value = i;
+		element* list = create_list(&value, sizeof(int));
+		entry* dictionary = create_dictionary(&value, sizeof(int), "0");
+
+		int j;
+		for (j = 1; j < args->length; j++) {
+			char key[16];
+			sprintf(key, "%d", j);
+
+			value = i + j;
+			add_element(list, &value, sizeof(int));
+			add_entry(dictionary, &value, sizeof(int), key);
+		}
+
+		args->lists[i] = list;
+		args->dictionaries[i] = dictionary;
+	}
+
+	return NULL;
+}
+
+static void* release_nodes_worker(void* arg) {
+	struct node_cache_args* args = (struct node_cache_args*)arg;
+
+	int i;
+	for (i = 0; i < args->count; i++) {
+		element* iterator = args->lists[i];
+
+		int j;
+		for (j = 0; iterator != NULL; j++, iterator = iterator->next) {
+			args->valid &= *(int*)iterator->value == i + j;
+		}
+
+		args->valid &= j == args->length;
+		args->valid &= *(int*)get_entry(args->dictionaries[i], "1")->value == i + 1;
+
+		delete_list(&args->lists[i]);
+		delete_dictionary(&args->dictionaries[i]);
+	}
+
+	return NULL;
+}
+
+void test_node_cache(void) {
+	const int threads = 4;
+	const int count = 2000;
+
+	struct node_cache_args args[4];
+	pthread_t workers[4];
+
+	int round;
+	for (round = 0; round < 3; round++) {
+		int t;
+		for (t = 0; t < threads; t++) {
+			args[t].lists = (element**)malloc(sizeof(element*) * count);
+			args[t].dictionaries = (entry**)malloc(sizeof(entry*) * count);
+			args[t].count = count;
+			args[t].length = 10;
+			args[t].valid = 1;
+			pthread_create(&workers[t], NULL, build_nodes_worker, &args[t]);
+		}
+
+		for (t = 0; t < threads; t++) {
+			pthread_join(workers[t], NULL);
+		}
+
+		/* every node is released by another thread than the one which allocated it */
+		struct node_cache_args swapped[4];
+
+		for (t = 0; t < threads; t++) {
+			swapped[t] = args[(t + 1) % threads];
+			pthread_create(&workers[t], NULL, release_nodes_worker, &swapped[t]);
+		}
+
+		for (t = 0; t < threads; t++) {
+			pthread_join(workers[t], NULL);
+			CU_ASSERT_TRUE(swapped[t].valid);
+			CU_ASSERT_PTR_NULL(swapped[t].lists[count - 1]);
+			free(swapped[t].lists);
+			free(swapped[t].dictionaries);
+		}
+	}
+
+	/* nodes of the cache are ordinary malloc blocks */
+	int value = 7;
+	element* list = create_list(&value, sizeof(int));
+	free(list->value);
+	free(list);
+
+	list = (element*)malloc(sizeof(element));
+	list->value = malloc(sizeof(int));
+	list->next = NULL;
+	memcpy(list->value, &value, sizeof(int));
+	delete_list(&list);
+	CU_ASSERT_PTR_NULL(list);
+}
+
+static void* churn_nodes_worker(void* arg) {
+	int rounds = *(int*)arg;
+
+	int i;
+	for (i = 0; i < rounds; i++) {
+		element* list = create_list(&i, sizeof(int));
+		element* tail = list;
+
+		int j;
+		for (j = 0; j < 100; j++) {
+			tail->next = create_list(&j, sizeof(int));
+			tail = tail->next;
+		}
+
+		delete_list(&list);
+	}
+
+	return NULL;
+}
+
+void test_node_cache_performance(void) {
+	const int total = 200000;
+
+	int threads;
+	for (threads = 1; threads <= 16; threads *= 2) {
+		pthread_t* workers = (pthread_t*)malloc(sizeof(pthread_t) * threads);
+		int rounds = total / threads;
+
+		double start = get_wall_seconds();
+
+		int t;
+		for (t = 0; t < threads; t++) {
+			pthread_create(&workers[t], NULL, churn_nodes_worker, &rounds);
+		}
+
+		for (t = 0; t < threads; t++) {
+			pthread_join(workers[t], NULL);
+		}
+
+		double end = get_wall_seconds();
+
+		printf("list churn with %d threads: %.1f million nodes per second\n", threads,
+			(double)rounds * threads * 101 / (end - start) / 1e6);
+
+		free(workers);
+	}
+}
+
+static atomic_int released_values;
+
+static void count_released_value(const void* value) {
+	(void)value;
+	atomic_fetch_add(&released_values, 1);
+}
+
+static element* create_counting_list(int length) {
+	int* values = (int*)malloc(sizeof(int) * length);
+
+	int i;
+	for (i = 0; i < length; i++) {
+		values[i] = i;
+	}
+
+	element* list = create_list_with_array(values, sizeof(int), length);
+	free(values);
+
+	return list;
+}
+
+void test_deferred_delete(void) {
+	const int length = 20000;
+
+	element* list = create_counting_list(length);
+	delete_list_deferred(&list);
+	CU_ASSERT_PTR_NULL(list);
+
+	delete_list_deferred(&list);
+	delete_list_deferred(NULL);
+
+	/* the callback runs on the reclaimer for every value */
+	atomic_init(&released_values, 0);
+	element* alloc_list = create_counting_list(length);
+	delete_list_alloc_deferred(&alloc_list, count_released_value);
+	CU_ASSERT_PTR_NULL(alloc_list);
+
+	entry* dictionary = create_dictionary(&length, sizeof(int), "0");
+
+	int i;
+	for (i = 1; i < 1000; i++) {
+		char key[16];
+		sprintf(key, "%d", i);
+		add_entry(dictionary, &i, sizeof(int), key);
+	}
+
+	delete_dictionary_deferred(&dictionary);
+	CU_ASSERT_PTR_NULL(dictionary);
+
+	for (i = 0; i < 50; i++) {
+		element* small = create_counting_list(10);
+		delete_list_deferred(&small);
+	}
+
+	flush_deferred_deletes();
+	CU_ASSERT_EQUAL(get_number_of_deferred_deletes(), 0);
+	CU_ASSERT_EQUAL(atomic_load(&released_values), length);
+
+	flush_deferred_deletes();
+}
+
+void test_deferred_delete_performance(void) {
+	const int length = 2000000;
+
+	element* list = create_counting_list(length);
+
+	double start = get_wall_seconds();
+	delete_list(&list);
+	double end = get_wall_seconds();
+
+	printf("delete_list of %d elements: %.3f ms on the caller\n", length, (end - start) * 1e3);
+
+	list = create_counting_list(length);
+
+	start = get_wall_seconds();
+	delete_list_deferred(&list);
+	end = get_wall_seconds();
+
+	printf("delete_list_deferred of %d elements: %.3f ms on the caller\n", length, (end - start) * 1e3);
+
+	start = get_wall_seconds();
+	flush_deferred_deletes();
+	end = get_wall_seconds();
+
+	printf("flush of the deferred delete: %.3f ms\n", (end - start) * 1e3);
+}
+
+static int cow_list_equals(const cow_list* list, const int* values, int length) {
+	if (get_length_of_cow_list(list) != length) return 0;
+
+	const cow_node* node = get_first_cow_node(list);
+
+	int i;
+	for (i = 0; i < length; i++, node = node->next) {
+		if (*(const int*)node->value != values[i]) return 0;
+	}
+
+	return node == NULL;
+}
+
+static void* cow_writer_worker(void* arg) {
+	cow_list* list = (cow_list*)arg;
+	int valid = 1;
+
+	int i;
+	for (i = 0; i < 200; i++) {
+		cow_list* clone = clone_cow_list(list);
+		int value = -i;
+
+		set_cow_value_at_index(clone, &value, i % 50);
+		add_cow_value(clone, &value);
+		remove_cow_value_at_index(clone, 0);
+
+		valid &= get_length_of_cow_list(clone) == 100;
+		valid &= *(const int*)get_cow_value_at_index(clone, 99) == -i;
+
+		delete_cow_list(&clone);
+	}
+
+	return valid ? arg : NULL;
+}
+
+void test_cow_list(void) {
+	int values[100];
+
+	int i;
+	for (i = 0; i < 100; i++) {
+		values[i] = i;
+	}
+
+	CU_ASSERT_PTR_NULL(create_cow_list(0));
+
+	cow_list* list = create_cow_list_with_array(values, sizeof(int), 100);
+	CU_ASSERT_PTR_NOT_NULL(list);
+	CU_ASSERT_TRUE(cow_list_equals(list, values, 100));
+	CU_ASSERT_EQUAL(*(const int*)get_cow_value_at_index(list, 42), 42);
+	CU_ASSERT_PTR_NULL(get_cow_value_at_index(list, 100));
+
+	/* a clone shares every node until it is written */
+	cow_list* clone = clone_cow_list(list);
+	CU_ASSERT_PTR_EQUAL(get_first_cow_node(clone), get_first_cow_node(list));
+
+	int value = -1;
+	CU_ASSERT_EQUAL(set_cow_value_at_index(clone, &value, 10), 0);
+	CU_ASSERT_EQUAL(*(const int*)get_cow_value_at_index(clone, 10), -1);
+	CU_ASSERT_EQUAL(*(const int*)get_cow_value_at_index(list, 10), 10);
+	CU_ASSERT_TRUE(cow_list_equals(list, values, 100));
+
+	/* only the nodes up to the written one were copied */
+	const cow_node* original = get_first_cow_node(list);
+	const cow_node* copied = get_first_cow_node(clone);
+
+	for (i = 0; i < 11; i++) {
+		CU_ASSERT_TRUE(original != copied);
+		original = original->next;
+		copied = copied->next;
+	}
+
+	CU_ASSERT_PTR_EQUAL(original, copied);
+
+	/* owned nodes are written in place */
+	const cow_node* first = get_first_cow_node(clone);
+	value = -2;
+	CU_ASSERT_EQUAL(set_cow_value_at_index(clone, &value, 0), 0);
+	CU_ASSERT_PTR_EQUAL(get_first_cow_node(clone), first);
+
+	CU_ASSERT_EQUAL(push_cow_value(clone, &value), 0);
+	CU_ASSERT_EQUAL(add_cow_value(clone, &value), 0);
+	CU_ASSERT_EQUAL(insert_cow_value_at_index(clone, &value, 50), 0);
+	CU_ASSERT_EQUAL(insert_cow_value_at_index(clone, &value, 200), -1);
+	CU_ASSERT_EQUAL(get_length_of_cow_list(clone), 103);
+	CU_ASSERT_EQUAL(*(const int*)get_cow_value_at_index(clone, 102), -2);
+	CU_ASSERT_EQUAL(*(const int*)get_cow_value_at_index(clone, 51), 49);
+
+	CU_ASSERT_EQUAL(remove_cow_value_at_index(clone, 102), 0);
+	CU_ASSERT_EQUAL(remove_cow_value_at_index(clone, 50), 0);
+	CU_ASSERT_EQUAL(remove_cow_value_at_index(clone, 0), 0);
+	CU_ASSERT_EQUAL(remove_cow_value_at_index(clone, 100), -1);
+	CU_ASSERT_EQUAL(*(const int*)get_cow_value_at_index(clone, 0), -2);
+	CU_ASSERT_EQUAL(get_length_of_cow_list(clone), 100);
+	CU_ASSERT_TRUE(cow_list_equals(list, values, 100));
+
+	/* nodes stay valid for the clone when the original goes away */
+	delete_cow_list(&list);
+	CU_ASSERT_PTR_NULL(list);
+	CU_ASSERT_EQUAL(*(const int*)get_cow_value_at_index(clone, 99), 99);
+	delete_cow_list(&clone);
+
+	/* several threads clone and write the same list */
+	list = create_cow_list_with_array(values, sizeof(int), 100);
+	pthread_t threads[4];
+
+	int t;
+	for (t = 0; t < 4; t++) {
+		pthread_create(&threads[t], NULL, cow_writer_worker, list);
+	}
+
+	for (t = 0; t < 4; t++) {
+		void* result;
+		pthread_join(threads[t], &result);
+		CU_ASSERT_PTR_NOT_NULL(result);
+	}
+
+	CU_ASSERT_TRUE(cow_list_equals(list, values, 100));
+	delete_cow_list(&list);
+
+	cow_list* empty = create_cow_list(sizeof(int));
+	CU_ASSERT_EQUAL(get_length_of_cow_list(empty), 0);
+	CU_ASSERT_PTR_NULL(get_first_cow_node(empty));
+	CU_ASSERT_EQUAL(add_cow_value(empty, &value), 0);
+	CU_ASSERT_EQUAL(remove_cow_value_at_index(empty, 0), 0);
+	CU_ASSERT_EQUAL(get_length_of_cow_list(empty), 0);
+	delete_cow_list(&empty);
+}
+
+/* builds a list of 0 to length - 1 whose nodes are scattered by inserts and removals */
+static element* create_churned_list(int length) {
+	int value = 0;
+	element* list = create_list(&value, sizeof(int));
+	element* tail = list;
+
+	int i;
+	for (i = 1; i < length; i++) {
+		tail = add_element(tail, &i, sizeof(int));
+	}
+
+	value = -1;
+	int inserted = 0;
+
+	/* every other element gets a neighbour which is removed again */
+	for (i = 1; i < length; i += 2, inserted++) {
+		add_element_at_index(list, &value, sizeof(int), i);
+	}
+
+	for (i = 1; i <= inserted; i++) {
+		remove_element_at_index(list, i);
+	}
+
+	return list;
+}
+
+static int is_sequence(element* list, int length) {
+	int i = 0;
+
+	element* iterator;
+	for (iterator = list; iterator != NULL; iterator = iterator->next, i++) {
+		if (*(int*)iterator->value != i) return 0;
+	}
+
+	return i == length;
+}
+
+void test_compact_list(void) {
+	const int length = 1000;
+
+	element* list = create_churned_list(length);
+	CU_ASSERT_TRUE(is_sequence(list, length));
+
+	CU_ASSERT_EQUAL(compact_list(&list, sizeof(int)), 0);
+	CU_ASSERT_TRUE(is_sequence(list, length));
+
+	/* elements follow each other at a constant distance */
+	ptrdiff_t distance = (char*)list->next - (char*)list;
+	int contiguous = distance > 0;
+
+	element* iterator;
+	for (iterator = list; iterator->next != NULL; iterator = iterator->next) {
+		contiguous &= (char*)iterator->next - (char*)iterator == distance;
+	}
+
+	CU_ASSERT_TRUE(contiguous);
+
+	/* compacted elements are released one by one like any other */
+	int value = 42;
+	CU_ASSERT_PTR_NOT_NULL(remove_element_at_index(list, 500));
+	CU_ASSERT_PTR_NOT_NULL(set_value_at_index(list, &value, sizeof(int), 10));
+	CU_ASSERT_PTR_NOT_NULL(add_element_at_index(list, &value, sizeof(int), 20));
+	CU_ASSERT_EQUAL(get_length_of_list(list), length);
+	CU_ASSERT_EQUAL(*(int*)get_value_at_index(list, 10), 42);
+
+	/* compacting again releases the first block */
+	CU_ASSERT_EQUAL(compact_list(&list, sizeof(int)), 0);
+	CU_ASSERT_EQUAL(get_length_of_list(list), length);
+	CU_ASSERT_EQUAL(*(int*)get_value_at_index(list, 20), 42);
+	delete_list(&list);
+	CU_ASSERT_PTR_NULL(list);
+
+	list = create_churned_list(length);
+	element** link = &list;
+	int steps = 0;
+
+	while (link != NULL) {
+		CU_ASSERT_EQUAL(compact_list_incremental(link, sizeof(int), 128, &link), 0);
+		steps++;
+	}
+
+	CU_ASSERT_EQUAL(steps, (length + 127) / 128);
+	CU_ASSERT_TRUE(is_sequence(list, length));
+	value = length - 1;
+	CU_ASSERT_EQUAL(contains_value(list, &value, sizeof(int)), length - 1);
+	delete_list_deferred(&list);
+	flush_deferred_deletes();
+
+	element* empty = create_empty_list();
+	CU_ASSERT_EQUAL(compact_list(&empty, sizeof(int)), 0);
+	CU_ASSERT_PTR_NULL(empty->value);
+	delete_list(&empty);
+
+	CU_ASSERT_EQUAL(compact_list(NULL, sizeof(int)), -1);
+	link = &list;
+	CU_ASSERT_EQUAL(compact_list_incremental(&empty, sizeof(int), 10, &link), 0);
+	CU_ASSERT_PTR_NULL(link);
+	CU_ASSERT_EQUAL(compact_list_incremental(NULL, sizeof(int), 10, &link), -1);
+	CU_ASSERT_EQUAL(compact_list_incremental(&empty, sizeof(int), 10, NULL), -1);
+}
+
+/* elements linked in random order of their allocation */
+static element* create_scattered_list(int length) {
+	element** nodes = (element**)malloc(sizeof(element*) * length);
+
+	int i;
+	for (i = 0; i < length; i++) {
+		nodes[i] = create_list(&i, sizeof(int));
+	}
+
+	srand(7);
+
+	for (i = length - 1; i > 0; i--) {
+		int j = rand() % (i + 1);
+		element* swap = nodes[i];
+		nodes[i] = nodes[j];
+		nodes[j] = swap;
+	}
+
+	for (i = 0; i < length - 1; i++) {
+		nodes[i]->next = nodes[i + 1];
+	}
+
+	element* list = nodes[0];
+	free(nodes);
+
+	return list;
+}
+
+static void* compact_churn_worker(void* arg) {
+	int rounds = *(int*)arg;
+
+	int i;
+	for (i = 0; i < rounds; i++) {
+		element* list = create_counting_list(1000);
+		compact_list(&list, sizeof(int));
+		delete_list(&list);
+	}
+
+	return NULL;
+}
+
+void test_compact_list_performance(void) {
+	const int length = 1000000;
+	element* list = create_scattered_list(length);
+
+	double start = get_wall_seconds();
+	int result = get_length_of_list(list);
+	double end = get_wall_seconds();
+
+	printf("traversal of %d scattered elements: %.3f ms\n", result, (end - start) * 1e3);
+
+	start = get_wall_seconds();
+	compact_list(&list, sizeof(int));
+	end = get_wall_seconds();
+
+	printf("compaction of %d elements: %.3f ms\n", length, (end - start) * 1e3);
+
+	start = get_wall_seconds();
+	result = get_length_of_list(list);
+	end = get_wall_seconds();
+
+	printf("traversal of %d compacted elements: %.3f ms\n", result, (end - start) * 1e3);
+
+	/* small steps append to shared slabs, so compacting and deleting stay linear in the length */
+	const int incremental_length = 2000000;
+	element* incremental = create_scattered_list(incremental_length);
+	element** link = &incremental;
+
+	start = get_wall_seconds();
+
+	while (link != NULL && compact_list_incremental(link, sizeof(int), 64, &link) == 0);
+
+	end = get_wall_seconds();
+
+	printf("incremental compaction of %d elements in steps of 64: %.3f ms\n", incremental_length, (end - start) * 1e3);
+
+	start = get_wall_seconds();
+	delete_list(&incremental);
+	end = get_wall_seconds();
+
+	printf("delete of %d incrementally compacted elements: %.3f ms\n", incremental_length, (end - start) * 1e3);
+
+	/* every release of a compacted element looks up its slab while the big list stays registered */
+	const int total = 2000;
+
+	int threads;
+	for (threads = 1; threads <= 16; threads *= 2) {
+		pthread_t* workers = (pthread_t*)malloc(sizeof(pthread_t) * threads);
+		int rounds = total / threads;
+
+		start = get_wall_seconds();
+
+		int t;
+		for (t = 0; t < threads; t++) {
+			pthread_create(&workers[t], NULL, compact_churn_worker, &rounds);
+		}
+
+		for (t = 0; t < threads; t++) {
+			pthread_join(workers[t], NULL);
+		}
+
+		end = get_wall_seconds();
+
+		printf("compacted list churn with %d threads: %.1f million nodes per second\n", threads,
+			(double)rounds * threads * 1000 / (end - start) / 1e6);
+
+		free(workers);
+	}
+
+	delete_list(&list);
+}
+
+void test_list_skip_index(void) {
+	int lengths[] = {1, 63, 64, 65, 1000};
+
+	int l;
+	for (l = 0; l < 5; l++) {
+		int length = lengths[l];
+		element* list = create_counting_list(length);
+		list_skip_index* index = create_list_skip_index(list, 8);
+		CU_ASSERT_PTR_NOT_NULL(index);
+		CU_ASSERT_EQUAL(get_length_with_skip_index(index), length);
+		CU_ASSERT_EQUAL(get_length_of_list(list), length);
+		CU_ASSERT_PTR_EQUAL(get_last_element_with_skip_index(index), get_last_element(list));
+		CU_ASSERT_PTR_NULL(get_element_with_skip_index(index, length));
+
+		int valid = 1;
+
+		int i;
+		for (i = 0; i < length; i++) {
+			element* e = get_element_with_skip_index(index, i);
+
+			valid &= e == get_element_at_index(list, i);
+			valid &= find_element_with_skip_index(index, e) == i;
+			valid &= find_value_with_skip_index(index, &i, sizeof(int)) == i;
+			valid &= contains_value(list, &i, sizeof(int)) == i;
+			valid &= contains_element(list, e) == i;
+		}
+
+		CU_ASSERT_TRUE(valid);
+		CU_ASSERT_EQUAL(find_value_with_skip_index(index, &length, sizeof(int)), -1);
+		CU_ASSERT_EQUAL(contains_value(list, &length, sizeof(int)), -1);
+
+		delete_list_skip_index(&index);
+		CU_ASSERT_PTR_NULL(index);
+		delete_list(&list);
+	}
+
+	/* the first of several equal values is found */
+	int values[] = {5, 1, 2, 1, 1, 3, 1, 1, 1, 1, 1, 7, 1};
+	element* list = create_list_with_array(values, sizeof(int), 13);
+	list_skip_index* index = create_list_skip_index(list, 2);
+	int value = 7;
+	CU_ASSERT_EQUAL(find_value_with_skip_index(index, &value, sizeof(int)), 11);
+	value = 1;
+	CU_ASSERT_EQUAL(find_value_with_skip_index(index, &value, sizeof(int)), 1);
+	delete_list_skip_index(&index);
+
+	index = create_list_skip_index(list, 0);
+	CU_ASSERT_EQUAL(index->stride, SKIP_INDEX_DEFAULT_STRIDE);
+	delete_list_skip_index(&index);
+	delete_list(&list);
+
+	CU_ASSERT_PTR_NULL(create_list_skip_index(NULL, 8));
+	CU_ASSERT_EQUAL(get_length_with_skip_index(NULL), -1);
+}
+
+void test_list_traversal_performance(void) {
+	/* far larger than the last level cache */
+	const int length = 4000000;
+	element* list = create_scattered_list(length);
+	int missing = -1;
+
+	double start = get_wall_seconds();
+	int result = contains_value(list, &missing, sizeof(int));
+	double end = get_wall_seconds();
+
+	printf("contains_value over %d scattered elements: %.3f ms (%d)\n", length, (end - start) * 1e3, result);
+
+	start = get_wall_seconds();
+	list_skip_index* index = create_list_skip_index(list, 0);
+	end = get_wall_seconds();
+
+	printf("skip index creation: %.3f ms\n", (end - start) * 1e3);
+
+	start = get_wall_seconds();
+	result = find_value_with_skip_index(index, &missing, sizeof(int));
+	end = get_wall_seconds();
+
+	printf("find_value_with_skip_index over %d scattered elements: %.3f ms (%d)\n", length, (end - start) * 1e3, result);
+
+	delete_list_skip_index(&index);
+	delete_list(&list);
+}
+
+/* checks every kernel against a plain loop, sizes cover full vectors and remainders */
+void test_simd(void) {
+	const int max = 1100;
+	int* ints = (int*)malloc(sizeof(int) * max);
+	double* doubles = (double*)malloc(sizeof(double) * max);
+	char* chars = (char*)malloc(max);
+	int* int_result = (int*)malloc(sizeof(int) * max);
+	double* double_result = (double*)malloc(sizeof(double) * max);
+	char* char_result = (char*)malloc(max);
+
+	srand(11);
+
+	int i;
+	for (i = 0; i < max; i++) {
+		ints[i] = rand() % 200 - 100;
+		doubles[i] = (rand() % 2000 - 1000) / 8.0;
+		chars[i] = (char)(rand() % 256);
+	}
+
+	ints[max / 2] = INT_MIN;
+	ints[max / 2 + 1] = INT_MAX;
+
+	int valid = 1;
+
+	int count;
+	for (count = 0; count <= max; count += count < 100 ? 1 : 250) {
+		/* an odd offset makes every load unaligned */
+		int offset;
+		for (offset = 0; offset < 2 && count + offset <= max; offset++) {
+			const int* iv = ints + offset;
+			const double* dv = doubles + offset;
+			const char* cv = chars + offset;
+
+			int needle = iv[count > 0 ? count - 1 : 0];
+			double dneedle = dv[count > 0 ? count / 2 : 0];
+			char cneedle = cv[count > 0 ? count - 1 : 0];
+
+			int first = -1, dfirst = -1, cfirst = -1;
+			int found = 0, dfound = 0, cfound = 0;
+			int imin = INT_MAX, imax = INT_MIN;
+			double dmin = 1e300, dmax = -1e300;
+			char cmin = CHAR_MAX, cmax = CHAR_MIN;
+			long long isum = 0, csum = 0;
+			double dsum = 0.0;
+			int ifiltered = 0, dfiltered = 0, cfiltered = 0;
+
+			for (i = 0; i < count; i++) {
+				if (iv[i] == needle) { found++; if (first == -1) first = i; }
+				if (dv[i] == dneedle) { dfound++; if (dfirst == -1) dfirst = i; }
+				if (cv[i] == cneedle) { cfound++; if (cfirst == -1) cfirst = i; }
+				if (iv[i] < imin) imin = iv[i];
+				if (iv[i] > imax) imax = iv[i];
+				if (dv[i] < dmin) dmin = dv[i];
+				if (dv[i] > dmax) dmax = dv[i];
+				if (cv[i] < cmin) cmin = cv[i];
+				if (cv[i] > cmax) cmax = cv[i];
+				isum += iv[i];
+				dsum += dv[i];
+				csum += cv[i];
+				if (iv[i] >= -20 && iv[i] <= 30) ifiltered++;
+				if (dv[i] >= -10.0 && dv[i] <= 50.0) dfiltered++;
+				if (cv[i] >= 'a' && cv[i] <= 'z') cfiltered++;
+			}
+
+			if (count > 0) {
+				valid &= find_int_in_array(iv, count, needle) == first;
+				valid &= find_double_in_array(dv, count, dneedle) == dfirst;
+				valid &= find_char_in_array(cv, count, cneedle) == cfirst;
+			}
+
+			valid &= find_int_in_array(iv, count, 1000) == -1;
+			valid &= count_int_in_array(iv, count, needle) == (count > 0 ? found : 0);
+			valid &= count_double_in_array(dv, count, dneedle) == (count > 0 ? dfound : 0);
+			valid &= count_char_in_array(cv, count, cneedle) == (count > 0 ? cfound : 0);
+			valid &= get_sum_of_int_array(iv, count) == isum;
+			valid &= get_sum_of_double_array(dv, count) == dsum;
+			valid &= get_sum_of_char_array(cv, count) == csum;
+
+			int ir;
+			double dr;
+			char cr;
+
+			if (count > 0) {
+				valid &= get_min_of_int_array(iv, count, &ir) == 0 && ir == imin;
+				valid &= get_max_of_int_array(iv, count, &ir) == 0 && ir == imax;
+				valid &= get_min_of_double_array(dv, count, &dr) == 0 && dr == dmin;
+				valid &= get_max_of_double_array(dv, count, &dr) == 0 && dr == dmax;
+				valid &= get_min_of_char_array(cv, count, &cr) == 0 && cr == cmin;
+				valid &= get_max_of_char_array(cv, count, &cr) == 0 && cr == cmax;
+			}
+			else {
+				valid &= get_min_of_int_array(iv, count, &ir) == -1;
+				valid &= get_max_of_double_array(dv, count, &dr) == -1;
+				valid &= get_min_of_char_array(cv, count, &cr) == -1;
+			}
+
+			valid &= filter_int_array_range(iv, count, -20, 30, int_result) == ifiltered;
+			valid &= filter_double_array_range(dv, count, -10.0, 50.0, double_result) == dfiltered;
+			valid &= filter_char_array_range(cv, count, 'a', 'z', char_result) == cfiltered;
+
+			/* the matches keep their order */
+			int j = 0, dj = 0, cj = 0;
+			for (i = 0; i < count; i++) {
+				if (iv[i] >= -20 && iv[i] <= 30) valid &= int_result[j++] == iv[i];
+				if (dv[i] >= -10.0 && dv[i] <= 50.0) valid &= double_result[dj++] == dv[i];
+				if (cv[i] >= 'a' && cv[i] <= 'z') valid &= char_result[cj++] == cv[i];
+			}
+		}
+	}
+
+	CU_ASSERT_TRUE(valid);
+
+	CU_ASSERT_EQUAL(find_int_in_array(NULL, 10, 0), -1);
+	CU_ASSERT_EQUAL(count_char_in_array(chars, -1, 'a'), -1);
+	CU_ASSERT_EQUAL(filter_double_array_range(doubles, 10, 0.0, 1.0, NULL), -1);
+
+	const double bounds[] = {0.0, 5e-324, 1.0, 2.0, 1e308};
+	int bin_counts[4] = {0, 0, 0, 0};
+	CU_ASSERT_EQUAL(add_double_array_to_histogram(bounds, 4, 0.0, 2.0, 4, bin_counts), 0);
+	CU_ASSERT_EQUAL(bin_counts[0], 2);
+	CU_ASSERT_EQUAL(bin_counts[2], 1);
+	CU_ASSERT_EQUAL(bin_counts[3], 1);
+	/* subnormal ranges give an infinite scale, ranges beyond DBL_MAX a zero one */
+	CU_ASSERT_EQUAL(add_double_array_to_histogram(bounds, 2, 0.0, 5e-324, 4, bin_counts), -1);
+	CU_ASSERT_EQUAL(add_double_array_to_histogram(bounds, 5, -1e308, 1e308, 4, bin_counts), -1);
+
+	/* the typed lists search in a single walk */
+	element* list = create_int_list(3);
+	add_int_element(list, INT_MIN);
+	add_int_element(list, 7);
+	CU_ASSERT_EQUAL(contains_int(list, 7), 2);
+	CU_ASSERT_EQUAL(contains_int(list, INT_MIN), 1);
+	CU_ASSERT_EQUAL(contains_int(list, 8), -1);
+	delete_list(&list);
+
+	list = create_double_list(-0.0);
+	add_double_element(list, 2.5);
+	CU_ASSERT_EQUAL(contains_double(list, 2.5), 1);
+	CU_ASSERT_EQUAL(contains_double(list, 0.0), -1);
+	delete_list(&list);
+
+	list = create_empty_list();
+	CU_ASSERT_EQUAL(contains_char(list, 'a'), -1);
+	delete_list(&list);
+	CU_ASSERT_EQUAL(contains_char(NULL, 'a'), -1);
+
+	free(ints);
+	free(doubles);
+	free(chars);
+	free(int_result);
+	free(double_result);
+	free(char_result);
+}
+
+void test_simd_performance(void) {
+	const int count = 10000000;
+	const int repeat = 20;
+	int* values = (int*)malloc(sizeof(int) * count);
+	int* result = (int*)malloc(sizeof(int) * count);
+
+	int i;
+	for (i = 0; i < count; i++) {
+		values[i] = i % 100000;
+	}
+
+	volatile long long sink = 0;
+
+	double start = get_wall_seconds();
+
+	int r;
+	for (r = 0; r < repeat; r++) {
+		int found = -1;
+
+		for (i = 0; i < count; i++) {
+			if (values[i] == -1) {
+				found = i;
+				break;
+			}
+		}
+
+		sink += found;
+	}
+
+	double end = get_wall_seconds();
+	printf("plain loop search over %d ints: %.2f GB/s\n", count, (double)count * sizeof(int) * repeat / (end - start) / 1e9);
+
+	start = get_wall_seconds();
+
+	for (r = 0; r < repeat; r++) {
+		sink += find_int_in_array(values, count, -1);
+	}
+
+	end = get_wall_seconds();
+	printf("find_int_in_array over %d ints: %.2f GB/s\n", count, (double)count * sizeof(int) * repeat / (end - start) / 1e9);
+
+	start = get_wall_seconds();
+
+	for (r = 0; r < repeat; r++) {
+		sink += count_int_in_array(values, count, 42);
+		sink += get_sum_of_int_array(values, count);
+	}
+
+	end = get_wall_seconds();
+	printf("count and sum over %d ints: %.2f GB/s\n", count, (double)count * sizeof(int) * repeat * 2 / (end - start) / 1e9);
+
+	start = get_wall_seconds();
+
+	for (r = 0; r < repeat; r++) {
+		sink += filter_int_array_range(values, count, 1000, 50000, result);
+	}
+
+	end = get_wall_seconds();
+	printf("range filter over %d ints: %.2f GB/s\n", count, (double)count * sizeof(int) * repeat / (end - start) / 1e9);
+
+	free(values);
+	free(result);
+}
+
+static double absolute(double x) {
+	return x < 0.0 ? -x : x;
+}
+
+static int nearly_equal(double a, double b) {
+	double scale = absolute(a) > absolute(b) ? absolute(a) : absolute(b);
+	return absolute(a - b) <= 1e-9 * (scale > 1.0 ? scale : 1.0);
+}
+
+void test_double_column(void) {
+	/* more than two chunks, the last one partly filled */
+	const int length = DOUBLE_COLUMN_CHUNK_SIZE * 2 + 123;
+	double* values = (double*)malloc(sizeof(double) * length);
+
+	srand(5);
+
+	int i;
+	for (i = 0; i < length; i++) {
+		values[i] = (rand() % 20001 - 10000) / 100.0;
+	}
+
+	double_column* column = create_double_column();
+	CU_ASSERT_PTR_NOT_NULL(column);
+	CU_ASSERT_EQUAL(get_length_of_double_column(column), 0);
+
+	double result;
+	CU_ASSERT_EQUAL(get_mean_of_double_column(column, &result), -1);
+	CU_ASSERT_EQUAL(get_min_of_double_column(column, &result), -1);
+	CU_ASSERT_PTR_NULL(double_column_to_list(column));
+
+	CU_ASSERT_EQUAL(add_double_value(column, values[0]), 0);
+	CU_ASSERT_EQUAL(add_double_values(column, values + 1, length - 1), 0);
+	CU_ASSERT_EQUAL(get_length_of_double_column(column), length);
+
+	double sum = 0.0, min = values[0], max = values[0], dot = 0.0;
+	int counts[10] = {0};
+
+	for (i = 0; i < length; i++) {
+		sum += values[i];
+		dot += values[i] * values[i];
+		if (values[i] < min) min = values[i];
+		if (values[i] > max) max = values[i];
+
+		if (values[i] >= -50.0 && values[i] <= 50.0) {
+			int bin = (int)((values[i] + 50.0) / 10.0);
+			counts[bin < 10 ? bin : 9]++;
+		}
+	}
+
+	double mean = sum / length;
+	double deviation = 0.0;
+
+	for (i = 0; i < length; i++) {
+		deviation += (values[i] - mean) * (values[i] - mean);
+	}
+
+	CU_ASSERT_TRUE(nearly_equal(get_sum_of_double_column(column), sum));
+	CU_ASSERT_EQUAL(get_mean_of_double_column(column, &result), 0);
+	CU_ASSERT_TRUE(nearly_equal(result, mean));
+	CU_ASSERT_EQUAL(get_variance_of_double_column(column, &result), 0);
+	CU_ASSERT_TRUE(nearly_equal(result, deviation / length));
+	CU_ASSERT_EQUAL(get_min_of_double_column(column, &result), 0);
+	CU_ASSERT_EQUAL(result, min);
+	CU_ASSERT_EQUAL(get_max_of_double_column(column, &result), 0);
+	CU_ASSERT_EQUAL(result, max);
+	CU_ASSERT_EQUAL(get_dot_product_of_double_columns(column, column, &result), 0);
+	CU_ASSERT_TRUE(nearly_equal(result, dot));
+
+	int histogram[10];
+	CU_ASSERT_EQUAL(get_histogram_of_double_column(column, -50.0, 50.0, 10, histogram), 0);
+	CU_ASSERT_EQUAL(memcmp(histogram, counts, sizeof(counts)), 0);
+	CU_ASSERT_EQUAL(get_histogram_of_double_column(column, 1.0, 1.0, 10, histogram), -1);
+	CU_ASSERT_EQUAL(get_histogram_of_double_column(column, 0.0, 5e-324, 10, histogram), -1);
+	CU_ASSERT_EQUAL(get_histogram_of_double_column(column, -1e308, 1e308, 10, histogram), -1);
+
+	CU_ASSERT_EQUAL(get_double_value_at_index(column, DOUBLE_COLUMN_CHUNK_SIZE + 1, &result), 0);
+	CU_ASSERT_EQUAL(result, values[DOUBLE_COLUMN_CHUNK_SIZE + 1]);
+	CU_ASSERT_EQUAL(set_double_value_at_index(column, 1e6, length - 1), 0);
+	CU_ASSERT_EQUAL(get_max_of_double_column(column, &result), 0);
+	CU_ASSERT_EQUAL(result, 1e6);
+	CU_ASSERT_EQUAL(get_double_value_at_index(column, length, &result), -1);
+	CU_ASSERT_EQUAL(set_double_value_at_index(column, 0.0, -1), -1);
+
+	/* round trip through a list of doubles */
+	element* list = double_column_to_list(column);
+	CU_ASSERT_EQUAL(get_length_of_list(list), length);
+	CU_ASSERT_EQUAL(get_double_at_index(list, 7), values[7]);
+
+	double_column* copy = create_double_column_from_list(list);
+	CU_ASSERT_EQUAL(get_length_of_double_column(copy), length);
+
+	int valid = 1;
+	for (i = 0; i < length; i++) {
+		double a, b;
+		get_double_value_at_index(column, i, &a);
+		get_double_value_at_index(copy, i, &b);
+		valid &= a == b;
+	}
+
+	CU_ASSERT_TRUE(valid);
+
+	double_column* shorter = create_double_column();
+	add_double_value(shorter, 1.0);
+	CU_ASSERT_EQUAL(get_dot_product_of_double_columns(column, shorter, &result), -1);
+
+	delete_double_column(&shorter);
+	delete_double_column(&copy);
+	delete_double_column(&column);
+	CU_ASSERT_PTR_NULL(column);
+	delete_list(&list);
+	free(values);
+}
+
+void test_double_column_performance(void) {
+	const int length = 5000000;
+	element* list = create_double_list(0.0);
+	element* tail = list;
+	double_column* column = create_double_column();
+
+	int i;
+	for (i = 1; i < length; i++) {
+		tail = add_double_element(tail, i * 0.5);
+		add_double_value(column, i * 0.5);
+	}
+
+	add_double_value(column, 0.0);
+
+	double start = get_wall_seconds();
+
+	double sum = 0.0;
+	element* iterator;
+	for (iterator = list; iterator != NULL; iterator = iterator->next) {
+		sum += *(double*)iterator->value;
+	}
+
+	double end = get_wall_seconds();
+	printf("mean over a list of %d doubles: %.3f ms (%f)\n", length, (end - start) * 1e3, sum / length);
+
+	double mean = 0.0;
+	double variance = 0.0;
+
+	start = get_wall_seconds();
+	get_mean_of_double_column(column, &mean);
+	end = get_wall_seconds();
+
+	printf("mean over a column of %d doubles: %.3f ms (%f)\n", length, (end - start) * 1e3, mean);
+
+	start = get_wall_seconds();
+	get_variance_of_double_column(column, &variance);
+	end = get_wall_seconds();
+
+	printf("variance over a column of %d doubles: %.3f ms (%f)\n", length, (end - start) * 1e3, variance);
+
+	start = get_wall_seconds();
+	double_column* converted = create_double_column_from_list(list);
+	end = get_wall_seconds();
+
+	printf("conversion of a list of %d doubles to a column: %.3f ms\n", length, (end - start) * 1e3);
+
+	delete_double_column(&converted);
+	delete_double_column(&column);
+	delete_list(&list);
+}